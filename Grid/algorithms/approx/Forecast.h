@@ -46,12 +46,45 @@ public:
 // Implementation of Brower et al.'s chronological inverter (arXiv:hep-lat/9509012),
 // used to forecast solutions across poles of the EOFA heatbath.
 //
+// The forecaster can also keep its own window of the last Depth solutions
+// (most recent first, oldest evicted) for HMC force solves: Update() after
+// each solve, Reset() whenever the pseudofermion is refreshed.
+//
 // Modified from CPS (cps_pp/src/util/dirac_op/d_op_base/comsrc/minresext.C)
 template<class Matrix, class Field>
 class ChronoForecast : public Forecast<Matrix,Field>
 {
 public:
+  int Depth;
+  std::vector<Field> history; // most recent first
+
+  ChronoForecast(int _Depth=0) : Depth(_Depth) {};
+
+  void Reset(void) { history.clear(); };
+
+  void Update(const Field &soln)
+  {
+    if ( Depth <= 0 ) return;
+    while ( (int)history.size() >= Depth ) history.pop_back();
+    history.insert(history.begin(),soln);
+  };
+
+  // Forecast from the stored history; HermOp is the Mdag M of the system solved
+  void operator()(LinearOperatorBase<Field> &HermOp, const Field& phi, Field &guess)
+  {
+    guess = Extrapolate([&](const Field &in, Field &out){ HermOp.HermOp(in,out); },phi,history);
+  };
+
   Field operator()(Matrix &Mat, const Field& phi, const std::vector<Field>& prev_solns)
+  {
+    Field Mv(phi);
+    return Extrapolate([&](const Field &in, Field &out){ Mat.M(in,Mv); Mat.Mdag(Mv,out); },phi,prev_solns);
+  };
+
+private:
+
+  template<class MdagMOp>
+  Field Extrapolate(MdagMOp MdagM, const Field& phi, const std::vector<Field>& prev_solns)
   {
     int degree = prev_solns.size();
     Field chi(phi); // forecasted solution
@@ -63,8 +96,19 @@ public:
     //    RealD dot;
     ComplexD xp;
     Field r(phi); // residual
-    Field Mv(phi);
-    std::vector<Field> v(prev_solns); // orthonormalized previous solutions
+
+    // Orthonormalize the vector basis, dropping (near) linearly dependent directions
+    std::vector<Field> v;
+    for(int i=0; i<degree; i++){
+      Field w(prev_solns[i]);
+      for(int j=0; j<v.size(); j++){ w -= innerProduct(v[j],w) * v[j]; }
+      RealD nn = norm2(w);
+      if ( nn > 1.0e-16*norm2(prev_solns[i]) ) {
+	w *= 1.0/std::sqrt(nn);
+	v.push_back(w);
+      }
+    }
+    degree = v.size();
     std::vector<Field> MdagMv(degree,phi);
 
     // Array to hold the matrix elements
@@ -74,17 +118,10 @@ public:
     std::vector<ComplexD> a(degree);
     std::vector<ComplexD> b(degree);
 
-    // Orthonormalize the vector basis
-    for(int i=0; i<degree; i++){
-      v[i] *= 1.0/std::sqrt(norm2(v[i]));
-      for(int j=i+1; j<degree; j++){ v[j] -= innerProduct(v[i],v[j]) * v[i]; }
-    }
-
     // Perform sparse matrix multiplication and construct rhs
     for(int i=0; i<degree; i++){
       b[i] = innerProduct(v[i],phi);
-      Mat.M(v[i],Mv);
-      Mat.Mdag(Mv,MdagMv[i]);
+      MdagM(v[i],MdagMv[i]);
       G[i][i] = innerProduct(v[i],MdagMv[i]);
     }
 
@@ -84,8 +84,11 @@ class BiCGSTAB : public OperatorFunction<Field>
 
       r = src - v;
       rhat = r;
-      a = norm2(r);
-      ssq = norm2(src);
+      std::vector<ComplexD> ip;
+      innerProductMulti(ip,{&r,&src},{&r,&src});
+      a   = real(ip[0]);
+      ssq = real(ip[1]);
+      RealD rho_next = a; // <rhat|r> with rhat = r
 
       std::cout << GridLogIterative << std::setprecision(8) << "BiCGSTAB: guess " << guess << std::endl;
       std::cout << GridLogIterative << std::setprecision(8) << "BiCGSTAB:   src " << ssq << std::endl;
@@ -113,10 +116,7 @@ class BiCGSTAB : public OperatorFunction<Field>
         rho_prev = rho;
 
         LinalgTimer.Start();
-        InnerTimer.Start();
-        ComplexD Crho  = innerProduct(rhat,r);
-        InnerTimer.Stop();
-        rho = Crho.real();
+        rho = rho_next;
 
         beta = (rho / rho_prev) * (alpha / omega);
 
@@ -167,9 +167,9 @@ class BiCGSTAB : public OperatorFunction<Field>
 
         LinalgTimer.Start();
         InnerTimer.Start();
-        ComplexD Comega = innerProduct(t,s);
+        innerProductMulti(ip,{&t,&t},{&s,&t});
         InnerTimer.Stop();
-        omega = Comega.real() / norm2(t);
+        omega = real(ip[0]) / real(ip[1]);
 
         LinearCombTimer.Start();
 	{
@@ -185,7 +185,12 @@ class BiCGSTAB : public OperatorFunction<Field>
 	}
         LinearCombTimer.Stop();
 	
-        cp = norm2(r);
+        // |r|^2 and the next <rhat|r> in one sweep and one reduction
+        InnerTimer.Start();
+        innerProductMulti(ip,{&rhat,&r},{&r,&r});
+        InnerTimer.Stop();
+        rho_next = real(ip[0]);
+        cp       = real(ip[1]);
         LinalgTimer.Stop();
 
         std::cout << GridLogIterative << "BiCGSTAB: Iteration " << k << " residual " << sqrt(cp/ssq) << " target " << Tolerance << std::endl;
@@ -0,0 +1,399 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/iterative/ConjugateGradientMultiShiftMixedPrec.h
+
+    Copyright (C) 2015
+
+Author: Azusa Yamaguchi <ayamaguc@staffmail.ed.ac.uk>
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef GRID_CONJUGATE_GRADIENT_MULTI_SHIFT_MIXED_PREC_H
+#define GRID_CONJUGATE_GRADIENT_MULTI_SHIFT_MIXED_PREC_H
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////
+// Multi-shift CG with the Krylov recurrences, search directions and
+// operator in single precision. The solutions are accumulated in double
+// precision. As in ConjugateGradientReliableUpdate, once the iterated
+// residual has fallen by a factor Delta since the last reliable update the
+// residuals are recomputed in double precision: the primary residual
+// replaces the iterated one, and each unconverged shift is rescaled to
+// the projection of its true residual onto the new primary residual.
+// On exit the true residual of every shift is checked in double precision
+// and any pole short of its tolerance is polished by a double precision CG.
+//////////////////////////////////////////////////////////////////////////
+template<class FieldD, class FieldF,
+	 typename std::enable_if< getPrecision<FieldD>::value == 2, int>::type = 0,
+	 typename std::enable_if< getPrecision<FieldF>::value == 1, int>::type = 0>
+class ConjugateGradientMultiShiftMixedPrec : public OperatorMultiFunction<FieldD>,
+					     public OperatorFunction<FieldD>
+{
+public:
+
+  using OperatorFunction<FieldD>::operator();
+
+  Integer MaxIterations;
+  Integer IterationsToComplete; //Number of iterations the CG took to finish. Filled in upon completion
+  Integer ReliableUpdatesPerformed;
+  std::vector<int> IterationsToCompleteShift;  // Iterations for this shift
+  std::vector<int> IterationsToCleanupShift;   // Double precision clean up iterations for this shift
+  int verbose;
+  MultiShiftFunction shifts;
+  std::vector<RealD> TrueResidualShift;
+
+  GridBase* SinglePrecGrid;
+  LinearOperatorBase<FieldF> &Linop_f;
+  RealD Delta; //reliable update parameter
+
+  ConjugateGradientMultiShiftMixedPrec(Integer maxit,MultiShiftFunction &_shifts,
+				       GridBase* _SinglePrecGrid,LinearOperatorBase<FieldF> &_Linop_f,
+				       RealD _Delta=0.1) :
+    MaxIterations(maxit),
+    shifts(_shifts),
+    SinglePrecGrid(_SinglePrecGrid),
+    Linop_f(_Linop_f),
+    Delta(_Delta)
+  {
+    verbose=1;
+    IterationsToCompleteShift.resize(_shifts.order);
+    IterationsToCleanupShift.resize(_shifts.order);
+    TrueResidualShift.resize(_shifts.order);
+  }
+
+  void operator() (LinearOperatorBase<FieldD> &Linop, const FieldD &src, FieldD &psi)
+  {
+    GridBase *grid = src.Grid();
+    int nshift = shifts.order;
+    std::vector<FieldD> results(nshift,grid);
+    (*this)(Linop,src,results,psi);
+  }
+  void operator() (LinearOperatorBase<FieldD> &Linop, const FieldD &src, std::vector<FieldD> &results, FieldD &psi)
+  {
+    int nshift = shifts.order;
+
+    (*this)(Linop,src,results);
+
+    psi = shifts.norm*src;
+    for(int i=0;i<nshift;i++){
+      psi = psi + shifts.residues[i]*results[i];
+    }
+
+    return;
+  }
+
+  void operator() (LinearOperatorBase<FieldD> &Linop_d, const FieldD &src_d, std::vector<FieldD> &psi_d)
+  {
+    GridBase *DoublePrecGrid = src_d.Grid();
+
+    ////////////////////////////////////////////////////////////////////////
+    // Convenience references to the info stored in "MultiShiftFunction"
+    ////////////////////////////////////////////////////////////////////////
+    int nshift = shifts.order;
+
+    std::vector<RealD> &mass(shifts.poles); // Make references to array in "shifts"
+    std::vector<RealD> &mresidual(shifts.tolerances);
+
+    // Search directions and solution increments since the last reliable update
+    std::vector<FieldF> ps_f (nshift,SinglePrecGrid);
+    std::vector<FieldF> psi_f(nshift,SinglePrecGrid);
+
+    assert(psi_d.size()==nshift);
+    assert(mass.size()==nshift);
+    assert(mresidual.size()==nshift);
+
+    // dynamic sized arrays on stack; 2d is a pain with vector
+    RealD  bs[nshift];
+    RealD  rsq[nshift];
+    RealD  z[nshift][2];
+    int     converged[nshift];
+
+    const int       primary =0;
+
+    //Primary shift fields CG iteration
+    RealD a,b,c,d;
+    RealD cp,bp; //prev
+
+    // Matrix mult fields
+    FieldF r_f(SinglePrecGrid);
+    FieldF p_f(SinglePrecGrid);
+    FieldF mmp_f(SinglePrecGrid);
+    FieldD r_d(DoublePrecGrid);
+    FieldD mmp_d(DoublePrecGrid);
+    FieldD tmp_d(DoublePrecGrid);
+
+    // Check lightest mass
+    for(int s=0;s<nshift;s++){
+      assert( mass[s]>= mass[primary] );
+      converged[s]=0;
+    }
+
+    // Wire guess to zero
+    // Residuals "r" are src
+    // First search direction "p" is also src
+    cp = norm2(src_d);
+
+    // Handle trivial case of zero src.
+    if( cp == 0. ){
+      for(int s=0;s<nshift;s++){
+	psi_d[s] = Zero();
+	IterationsToCompleteShift[s] = 1;
+	IterationsToCleanupShift[s] = 0;
+	TrueResidualShift[s] = 0.;
+      }
+      return;
+    }
+
+    precisionChange(r_f,src_d);
+    for(int s=0;s<nshift;s++){
+      rsq[s] = cp * mresidual[s] * mresidual[s];
+      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec: shift "<<s
+	       <<" target resid "<<rsq[s]<<std::endl;
+      ps_f[s] = r_f;
+      psi_f[s] = Zero();
+      psi_f[s].Checkerboard() = r_f.Checkerboard();
+    }
+    // r and p for primary
+    p_f=r_f;
+
+    //MdagM+m[0]
+    Linop_f.HermOp(p_f,mmp_f);
+    axpy(mmp_f,mass[0],p_f,mmp_f);
+    d = real(innerProduct(p_f,mmp_f));
+
+    b = -cp /d;
+
+    // Set up the various shift variables
+    int       iz=0;
+    z[0][1-iz] = 1.0;
+    z[0][iz]   = 1.0;
+    bs[0]      = b;
+    for(int s=1;s<nshift;s++){
+      z[s][1-iz] = 1.0;
+      z[s][iz]   = 1.0/( 1.0 - b*(mass[s]-mass[0]));
+      bs[s]      = b*z[s][iz];
+    }
+
+    // r += b[0] A.p[0]
+    // c= norm(r)
+    c=axpy_norm(r_f,b,mmp_f,r_f);
+
+    for(int s=0;s<nshift;s++) {
+      axpby(psi_d[s],0.,-bs[s],src_d,src_d);
+    }
+
+    ///////////////////////////////////////
+    // Timers
+    ///////////////////////////////////////
+    GridStopWatch AXPYTimer;
+    GridStopWatch ShiftTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch ReliableTimer;
+    GridStopWatch CleanupTimer;
+    GridStopWatch SolverTimer;
+    SolverTimer.Start();
+
+    RealD MaxResidSinceLastRelUp = c;
+
+    // Iteration loop
+    int k;
+    int l = 0;
+    for (k=1;k<=MaxIterations;k++){
+
+      a = c /cp;
+      AXPYTimer.Start();
+      axpy(p_f,a,p_f,r_f);
+
+      for(int s=0;s<nshift;s++){
+	if ( ! converged[s] ) {
+	  if (s==0){
+	    axpy(ps_f[s],a,ps_f[s],r_f);
+	  } else{
+	    RealD as =a *z[s][iz]*bs[s] /(z[s][1-iz]*b);
+	    axpby(ps_f[s],z[s][iz],as,r_f,ps_f[s]);
+	  }
+	}
+      }
+      AXPYTimer.Stop();
+
+      cp=c;
+      MatrixTimer.Start();
+      Linop_f.HermOp(p_f,mmp_f);
+      MatrixTimer.Stop();
+
+      AXPYTimer.Start();
+      axpy(mmp_f,mass[0],p_f,mmp_f);
+      d = real(innerProduct(p_f,mmp_f));
+      AXPYTimer.Stop();
+
+      bp=b;
+      b=-cp/d;
+
+      AXPYTimer.Start();
+      c=axpy_norm(r_f,b,mmp_f,r_f);
+      AXPYTimer.Stop();
+
+      // Toggle the recurrence history
+      bs[0] = b;
+      iz = 1-iz;
+      ShiftTimer.Start();
+      for(int s=1;s<nshift;s++){
+	if((!converged[s])){
+	  RealD z0 = z[s][1-iz];
+	  RealD z1 = z[s][iz];
+	  z[s][iz] = z0*z1*bp
+	    / (b*a*(z1-z0) + z1*bp*(1- (mass[s]-mass[0])*b));
+	  bs[s] = b*z[s][iz]/z0; // NB sign  rel to Mike
+	}
+      }
+      ShiftTimer.Stop();
+
+      AXPYTimer.Start();
+      for(int s=0;s<nshift;s++){
+	if( (!converged[s]) ) {
+	  axpy(psi_f[s],-bs[s],ps_f[s],psi_f[s]);
+	}
+      }
+      AXPYTimer.Stop();
+
+      if ( c > MaxResidSinceLastRelUp ) MaxResidSinceLastRelUp = c;
+
+      ////////////////////////////////////////////////////////////////
+      // Reliable update: fold the single precision increments into
+      // the double precision solutions and replace the residuals by
+      // their true values.
+      ////////////////////////////////////////////////////////////////
+      if ( c < Delta * MaxResidSinceLastRelUp ) {
+	ReliableTimer.Start();
+	for(int s=0;s<nshift;s++){
+	  precisionChange(tmp_d,psi_f[s]);
+	  psi_d[s] = psi_d[s] + tmp_d;
+	  psi_f[s] = Zero();
+	}
+	Linop_d.HermOp(psi_d[0],mmp_d);
+	axpy(mmp_d,mass[0],psi_d[0],mmp_d);
+	r_d = src_d - mmp_d;
+	RealD c_rel = norm2(r_d);
+	std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec k="<<k
+		 <<" reliable update: iterated residual "<<c<<" true residual "<<c_rel<<std::endl;
+	c = c_rel;
+	MaxResidSinceLastRelUp = c;
+	precisionChange(r_f,r_d);
+
+	// The shifted residuals are z[s] r in exact arithmetic. Rescaling
+	// z[s], with its history, and ps[s] by a common factor rescales the
+	// rest of that shift's recurrence, so z[s] is set to the projection
+	// of the true shifted residual on r; what is left is drift the
+	// clean up removes.
+	for(int s=1;s<nshift;s++){
+	  if ( !converged[s] ) {
+	    Linop_d.HermOp(psi_d[s],mmp_d);
+	    axpy(mmp_d,mass[s],psi_d[s],mmp_d);
+	    tmp_d = src_d - mmp_d;
+	    RealD zs = real(innerProduct(r_d,tmp_d))/c;
+	    RealD lambda = zs/z[s][iz];
+	    z[s][iz]   = zs;
+	    z[s][1-iz]*= lambda;
+	    ps_f[s]    = lambda*ps_f[s];
+	  }
+	}
+	l++;
+	ReliableTimer.Stop();
+      }
+
+      // Convergence checks
+      int all_converged = 1;
+      for(int s=0;s<nshift;s++){
+
+	if ( (!converged[s]) ){
+	  IterationsToCompleteShift[s] = k;
+
+	  RealD css  = c * z[s][iz]* z[s][iz];
+
+	  if(css<rsq[s]){
+	    if ( ! converged[s] )
+	      std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMixedPrec k="<<k<<" Shift "<<s<<" has converged"<<std::endl;
+	    converged[s]=1;
+	  } else {
+	    all_converged=0;
+	  }
+
+	}
+      }
+
+      if ( all_converged ){
+
+	for(int s=0;s<nshift;s++){
+	  precisionChange(tmp_d,psi_f[s]);
+	  psi_d[s] = psi_d[s] + tmp_d;
+	}
+
+	SolverTimer.Stop();
+
+	std::cout<<GridLogMessage<< "CGMultiShiftMixedPrec: All shifts have converged iteration "<<k<<" after "<<l<<" reliable updates"<<std::endl;
+	std::cout<<GridLogMessage<< "CGMultiShiftMixedPrec: Checking solutions"<<std::endl;
+
+	// Check answers in double, clean up any pole that fell short
+	CleanupTimer.Start();
+	RealD cn = norm2(src_d);
+	for(int s=0; s < nshift; s++) {
+	  Linop_d.HermOp(psi_d[s],mmp_d);
+	  axpy(tmp_d,mass[s],psi_d[s],mmp_d);
+	  r_d = tmp_d - src_d;
+	  RealD rn = norm2(r_d);
+	  TrueResidualShift[s] = std::sqrt(rn/cn);
+	  IterationsToCleanupShift[s] = 0;
+	  if ( TrueResidualShift[s] > mresidual[s] ) {
+	    ShiftedHermOpLinearOperator<FieldD> ShiftedLinop(Linop_d,mass[s]);
+	    ConjugateGradient<FieldD> CG(mresidual[s],MaxIterations,false);
+	    CG(ShiftedLinop,src_d,psi_d[s]);
+	    IterationsToCleanupShift[s] = CG.IterationsToComplete;
+	    TrueResidualShift[s] = CG.TrueResidual;
+	  }
+	  std::cout<<GridLogMessage<<"CGMultiShiftMixedPrec: shift["<<s<<"] true residual "<< TrueResidualShift[s]
+		   <<" after "<<IterationsToCleanupShift[s]<<" clean up iterations"<<std::endl;
+	}
+	CleanupTimer.Stop();
+
+	std::cout << GridLogMessage << "Time Breakdown "<<std::endl;
+	std::cout << GridLogMessage << "\tElapsed    " << SolverTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tAXPY       " << AXPYTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tMatrix     " << MatrixTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tShift      " << ShiftTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tReliable   " << ReliableTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tCleanup    " << CleanupTimer.Elapsed()     <<std::endl;
+
+	IterationsToComplete = k;
+	ReliableUpdatesPerformed = l;
+
+	return;
+      }
+
+    }
+    std::cout<<GridLogMessage<<"CG multi shift mixed prec did not converge"<<std::endl;
+    IterationsToComplete = k;
+    ReliableUpdatesPerformed = l;
+  }
+
+};
+NAMESPACE_END(Grid);
+#endif
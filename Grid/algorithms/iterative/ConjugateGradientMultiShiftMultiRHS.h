@@ -0,0 +1,335 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/algorithms/iterative/ConjugateGradientMultiShiftMultiRHS.h
+
+    Copyright (C) 2015
+
+Author: Azusa Yamaguchi <ayamaguc@staffmail.ed.ac.uk>
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef GRID_CONJUGATE_GRADIENT_MULTI_SHIFT_MULTI_RHS_H
+#define GRID_CONJUGATE_GRADIENT_MULTI_SHIFT_MULTI_RHS_H
+
+NAMESPACE_BEGIN(Grid);
+
+//////////////////////////////////////////////////////////////////////////
+// Multi-shift CG for several independent sources at once.
+//
+// The sources are the slices of one field along the block dimension
+// blockDim (as for CGmultiRHS). One operator application per iteration
+// serves every source and every shift. All Krylov coefficients are carried
+// per slice; a (shift,source) pair is frozen once converged, and a source is
+// retired once all its shifts have converged.
+//
+// Because the coefficients are per slice, the operator must be block
+// diagonal in blockDim: it may not couple different slices. The 5d
+// staggered operators (ImprovedStaggeredFermion5D) qualify. Domain wall
+// operators couple the s-slices and do not; for them a slice is not a
+// source, and this solver gives wrong answers.
+//////////////////////////////////////////////////////////////////////////
+template<class Field>
+class ConjugateGradientMultiShiftMultiRHS : public OperatorMultiFunction<Field>,
+					    public OperatorFunction<Field>
+{
+public:
+
+  using OperatorFunction<Field>::operator();
+
+  int blockDim;
+  Integer MaxIterations;
+  Integer IterationsToComplete; //Number of iterations the CG took to finish. Filled in upon completion
+  std::vector<int> IterationsToCompleteShift;  // Iterations for this shift, max over sources
+  int verbose;
+  MultiShiftFunction shifts;
+  std::vector<RealD> TrueResidualShift;        // Max over sources
+
+  ConjugateGradientMultiShiftMultiRHS(Integer maxit,MultiShiftFunction &_shifts,int _Orthog) :
+    blockDim(_Orthog),
+    MaxIterations(maxit),
+    shifts(_shifts)
+  {
+    verbose=1;
+    IterationsToCompleteShift.resize(_shifts.order);
+    TrueResidualShift.resize(_shifts.order);
+  }
+
+  void operator() (LinearOperatorBase<Field> &Linop, const Field &src, Field &psi)
+  {
+    GridBase *grid = src.Grid();
+    int nshift = shifts.order;
+    std::vector<Field> results(nshift,grid);
+    (*this)(Linop,src,results,psi);
+  }
+  void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector<Field> &results, Field &psi)
+  {
+    int nshift = shifts.order;
+
+    (*this)(Linop,src,results);
+
+    psi = shifts.norm*src;
+    for(int i=0;i<nshift;i++){
+      psi = psi + shifts.residues[i]*results[i];
+    }
+
+    return;
+  }
+
+  void operator() (LinearOperatorBase<Field> &Linop, const Field &src, std::vector<Field> &psi)
+  {
+    GridBase *grid = src.Grid();
+    int Orthog = blockDim;
+    int Nblock = grid->GlobalDimensions()[Orthog];
+
+    int nshift = shifts.order;
+
+    std::vector<RealD> &mass(shifts.poles); // Make references to array in "shifts"
+    std::vector<RealD> &mresidual(shifts.tolerances);
+    std::vector<Field>   ps(nshift,grid);// Search directions
+
+    assert(psi.size()==nshift);
+    assert(mass.size()==nshift);
+    assert(mresidual.size()==nshift);
+
+    for(int s=0;s<nshift;s++){
+      assert( mass[s]>= mass[0] );
+      psi[s].Checkerboard() = src.Checkerboard();
+    }
+
+    // Per source Krylov coefficients of the primary system
+    std::vector<RealD> a(Nblock), b(Nblock,0.0), bp(Nblock), c(Nblock), cp(Nblock), d(Nblock);
+    // Per shift, per source
+    std::vector<std::vector<RealD> > rsq(nshift,std::vector<RealD>(Nblock));
+    std::vector<std::vector<RealD> > bs (nshift,std::vector<RealD>(Nblock));
+    std::vector<std::vector<RealD> > z0 (nshift,std::vector<RealD>(Nblock,1.0));
+    std::vector<std::vector<RealD> > z1 (nshift,std::vector<RealD>(Nblock,1.0));
+    std::vector<std::vector<int> >   converged(nshift,std::vector<int>(Nblock,0));
+    std::vector<int>                 retired(Nblock,0);
+
+    // Slice coefficient scratch
+    std::vector<RealD> cx(Nblock), cy(Nblock);
+    std::vector<RealD> zero(Nblock,0.0);
+    std::vector<RealD> one (Nblock,1.0);
+    std::vector<ComplexD> ip(Nblock);
+
+    Field r(grid);
+    Field p(grid);
+    Field mmp(grid);
+    Field tmp(grid);
+
+    // Guess zero; residual and search directions are src
+    sliceNorm(cp,src,Orthog);
+
+    for(int blk=0;blk<Nblock;blk++){
+      if ( cp[blk]==0.0 ) { // trivial source
+	retired[blk]=1;
+	for(int s=0;s<nshift;s++) converged[s][blk]=1;
+      }
+      for(int s=0;s<nshift;s++){
+	rsq[s][blk] = cp[blk] * mresidual[s] * mresidual[s];
+      }
+    }
+    for(int s=0;s<nshift;s++) ps[s] = src;
+    r=src;
+    p=src;
+
+    // MdagM+m[0]
+    Linop.HermOp(p,mmp);
+    axpy(mmp,mass[0],p,mmp);
+    sliceInnerProductVector(ip,p,mmp,Orthog);
+
+    for(int blk=0;blk<Nblock;blk++){
+      if ( retired[blk] ) continue;
+      d[blk] = real(ip[blk]);
+      b[blk] = -cp[blk]/d[blk];
+      bs[0][blk] = b[blk];
+      for(int s=1;s<nshift;s++){
+	z1[s][blk] = 1.0/( 1.0 - b[blk]*(mass[s]-mass[0]));
+	bs[s][blk] = b[blk]*z1[s][blk];
+      }
+    }
+
+    // r += b A.p ; c = |r|^2 per source
+    sliceAxpbyVector(r,b,one,mmp,r,Orthog);
+    sliceNorm(c,r,Orthog);
+
+    for(int s=0;s<nshift;s++) {
+      for(int blk=0;blk<Nblock;blk++) cx[blk] = -bs[s][blk];
+      sliceAxpbyVector(psi[s],cx,zero,src,src,Orthog);
+    }
+
+    GridStopWatch AXPYTimer;
+    GridStopWatch ShiftTimer;
+    GridStopWatch MatrixTimer;
+    GridStopWatch SolverTimer;
+    SolverTimer.Start();
+
+    int k;
+    for (k=1;k<=MaxIterations;k++){
+
+      // p = a p + r, frozen for retired sources
+      for(int blk=0;blk<Nblock;blk++){
+	if ( retired[blk] ) { cx[blk]=1.0;    cy[blk]=0.0; }
+	else                { cx[blk]=c[blk]/cp[blk]; cy[blk]=1.0; }
+	a[blk] = cx[blk];
+      }
+      AXPYTimer.Start();
+      sliceAxpbyVector(p,cx,cy,p,r,Orthog);
+
+      // ps[s] = z[s] r + as[s] ps[s]; shifts converged on every source are skipped
+      for(int s=0;s<nshift;s++){
+	int active=0;
+	for(int blk=0;blk<Nblock;blk++){
+	  if ( converged[s][blk] ) { cx[blk]=1.0; cy[blk]=0.0; }
+	  else {
+	    cx[blk] = a[blk]*z1[s][blk]*bs[s][blk]/(z0[s][blk]*b[blk]);
+	    cy[blk] = z1[s][blk];
+	    active=1;
+	  }
+	}
+	if ( active ) sliceAxpbyVector(ps[s],cx,cy,ps[s],r,Orthog);
+      }
+      AXPYTimer.Stop();
+
+      cp = c;
+
+      MatrixTimer.Start();
+      Linop.HermOp(p,mmp);
+      MatrixTimer.Stop();
+
+      AXPYTimer.Start();
+      axpy(mmp,mass[0],p,mmp);
+      sliceInnerProductVector(ip,p,mmp,Orthog);
+      AXPYTimer.Stop();
+
+      for(int blk=0;blk<Nblock;blk++){
+	bp[blk]=b[blk];
+	if ( retired[blk] ) { b[blk] = 0.0; }
+	else {
+	  d[blk] = real(ip[blk]);
+	  b[blk] = -cp[blk]/d[blk];
+	}
+      }
+
+      AXPYTimer.Start();
+      sliceAxpbyVector(r,b,one,mmp,r,Orthog);
+      sliceNorm(c,r,Orthog);
+      AXPYTimer.Stop();
+
+      // Shift recurrences, per source
+      ShiftTimer.Start();
+      for(int blk=0;blk<Nblock;blk++){
+	if ( retired[blk] ) continue;
+	bs[0][blk] = b[blk];
+	for(int s=1;s<nshift;s++){
+	  if ( !converged[s][blk] ) {
+	    RealD zo = z0[s][blk]; // previous
+	    RealD zn = z1[s][blk]; // current
+	    RealD zz = zo*zn*bp[blk]
+	      / (b[blk]*a[blk]*(zo-zn) + zo*bp[blk]*(1- (mass[s]-mass[0])*b[blk]));
+	    z0[s][blk] = zn;
+	    z1[s][blk] = zz;
+	    bs[s][blk] = b[blk]*zz/zn;
+	  }
+	}
+      }
+      ShiftTimer.Stop();
+
+      // psi[s] -= bs[s] ps[s]
+      AXPYTimer.Start();
+      for(int s=0;s<nshift;s++){
+	int active=0;
+	for(int blk=0;blk<Nblock;blk++){
+	  if ( converged[s][blk] ) cx[blk] = 0.0;
+	  else                   { cx[blk] = -bs[s][blk]; active=1; }
+	}
+	if ( active ) sliceAxpbyVector(psi[s],cx,one,ps[s],psi[s],Orthog);
+      }
+      AXPYTimer.Stop();
+
+      // Convergence checks
+      int all_converged = 1;
+      for(int blk=0;blk<Nblock;blk++){
+	if ( retired[blk] ) continue;
+	int src_converged = 1;
+	for(int s=0;s<nshift;s++){
+	  if ( !converged[s][blk] ) {
+	    IterationsToCompleteShift[s] = k;
+	    RealD css = c[blk] * z1[s][blk]* z1[s][blk];
+	    if ( css<rsq[s][blk] ) {
+	      if ( verbose )
+		std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMultiRHS k="<<k<<" Shift "<<s<<" source "<<blk<<" has converged"<<std::endl;
+	      converged[s][blk]=1;
+	    } else {
+	      src_converged=0;
+	    }
+	  }
+	}
+	if ( src_converged ) {
+	  if ( verbose )
+	    std::cout<<GridLogMessage<<"ConjugateGradientMultiShiftMultiRHS k="<<k<<" source "<<blk<<" retired"<<std::endl;
+	  retired[blk]=1;
+	} else {
+	  all_converged=0;
+	}
+      }
+
+      if ( all_converged ){
+
+	SolverTimer.Stop();
+
+	std::cout<<GridLogMessage<< "CGMultiShiftMultiRHS: All shifts have converged iteration "<<k<<std::endl;
+	std::cout<<GridLogMessage<< "CGMultiShiftMultiRHS: Checking solutions"<<std::endl;
+
+	std::vector<RealD> rn(Nblock), sn(Nblock);
+	sliceNorm(sn,src,Orthog);
+	for(int s=0; s < nshift; s++) {
+	  Linop.HermOp(psi[s],mmp);
+	  axpy(tmp,mass[s],psi[s],mmp);
+	  r = tmp - src;
+	  sliceNorm(rn,r,Orthog);
+	  TrueResidualShift[s] = 0.0;
+	  for(int blk=0;blk<Nblock;blk++){
+	    if ( sn[blk]==0.0 ) continue;
+	    RealD resid = std::sqrt(rn[blk]/sn[blk]);
+	    if ( resid > TrueResidualShift[s] ) TrueResidualShift[s]=resid;
+	  }
+	  std::cout<<GridLogMessage<<"CGMultiShiftMultiRHS: shift["<<s<<"] max true residual "<< TrueResidualShift[s] <<std::endl;
+	}
+
+	std::cout << GridLogMessage << "Time Breakdown "<<std::endl;
+	std::cout << GridLogMessage << "\tElapsed    " << SolverTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tAXPY       " << AXPYTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tMatrix     " << MatrixTimer.Elapsed()     <<std::endl;
+	std::cout << GridLogMessage << "\tShift      " << ShiftTimer.Elapsed()     <<std::endl;
+
+	IterationsToComplete = k;
+
+	return;
+      }
+    }
+    std::cout<<GridLogMessage<<"CG multi shift multi RHS did not converge"<<std::endl;
+    IterationsToComplete = k;
+  }
+
+};
+NAMESPACE_END(Grid);
+#endif
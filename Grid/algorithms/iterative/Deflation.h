@@ -60,13 +60,51 @@ public:
   DeflatedGuesser(const std::vector<Field> & _evec,const std::vector<RealD> & _eval) : evec(_evec), eval(_eval) {};
 
   virtual void operator()(const Field &src,Field &guess) {
-    guess = Zero();
+    basisDeflate(evec,eval,src,guess);
+    guess.Checkerboard() = src.Checkerboard();
+  }
+};
+
+////////////////////////////////////////////////////////////////////////
+// Fine grid deflation with the eigenvectors held in reduced precision.
+// Owns a compressed copy so the full precision vectors may be released.
+////////////////////////////////////////////////////////////////////////
+template<class Field, class FieldLow>
+class MixedPrecisionDeflatedGuesser: public LinearFunction<Field> {
+private:
+  std::vector<FieldLow> evec;
+  std::vector<RealD>    eval;
+
+public:
+
+  MixedPrecisionDeflatedGuesser(GridBase *_grid_low,const std::vector<Field> & _evec,const std::vector<RealD> & _eval)
+    : eval(_eval)
+  {
+    assert(_evec.size()==_eval.size());
+    evec.resize(_evec.size(),_grid_low);
+    for(int i=0;i<_evec.size();i++) precisionChange(evec[i],_evec[i]);
+  };
+
+  MixedPrecisionDeflatedGuesser(const std::vector<FieldLow> & _evec,const std::vector<RealD> & _eval)
+    : evec(_evec), eval(_eval)
+  {
     assert(evec.size()==eval.size());
-    auto N = evec.size();
-    for (int i=0;i<N;i++) {
-      const Field& tmp = evec[i];
-      axpy(guess,TensorRemove(innerProduct(tmp,src)) / eval[i],tmp,guess);
+  };
+
+  const std::vector<FieldLow> & Evec(void) const { return evec; };
+  const std::vector<RealD>    & Eval(void) const { return eval; };
+
+  virtual void operator()(const Field &src,Field &guess) {
+    if ( evec.size()==0 ) {
+      guess = Zero();
+      guess.Checkerboard() = src.Checkerboard();
+      return;
     }
+    FieldLow src_low(evec[0].Grid());
+    FieldLow guess_low(evec[0].Grid());
+    precisionChange(src_low,src);
+    basisDeflate(evec,eval,src_low,guess_low);
+    precisionChange(guess,guess_low);
     guess.Checkerboard() = src.Checkerboard();
   }
 };
@@ -93,15 +131,79 @@ public:
     CoarseField src_coarse(evec_coarse[0].Grid());
     CoarseField guess_coarse(evec_coarse[0].Grid());    guess_coarse = Zero();
     blockProject(src_coarse,src,subspace);    
-    for (int i=0;i<N;i++) {
-      const CoarseField & tmp = evec_coarse[i];
-      axpy(guess_coarse,TensorRemove(innerProduct(tmp,src_coarse)) / eval_coarse[i],tmp,guess_coarse);
-    }
+    basisDeflate(evec_coarse,eval_coarse,src_coarse,guess_coarse);
     blockPromote(guess_coarse,guess,subspace);
     guess.Checkerboard() = src.Checkerboard();
   };
 };
 
+//////////////////////////////////////////////////////////////////////////////
+// Block compressed deflation: a set of fine eigenvectors is represented by
+// nbasis of them, block orthonormalised and stored in reduced precision, and
+// the coarse coefficients of every vector in that block subspace. 
+// Vectors are never decompressed; the projection is done on the coarse grid.
+//////////////////////////////////////////////////////////////////////////////
+template<class Field, class FobjLow, class CComplex, int nbasis>
+class BlockCompressedDeflatedGuesser: public LinearFunction<Field> {
+public:
+  typedef Lattice<FobjLow>                  FineFieldLow;
+  typedef iVector<CComplex,nbasis>          CoarseSiteVector;
+  typedef Lattice<CoarseSiteVector>         CoarseField;
+  typedef Lattice<CComplex>                 CoarseScalar;
+private:
+  std::vector<FineFieldLow> subspace;
+  std::vector<CoarseField>  evec_coarse;
+  std::vector<RealD>        eval;
+public:
+
+  BlockCompressedDeflatedGuesser(GridBase *_FineGridLow,
+				 GridBase *_CoarseGrid,
+				 const std::vector<Field> &_evec,
+				 const std::vector<RealD> &_eval)
+    : subspace(nbasis,_FineGridLow), evec_coarse(_evec.size(),_CoarseGrid), eval(_eval)
+  {
+    assert(_evec.size()==_eval.size());
+    assert(_evec.size()>=nbasis);
+
+    for(int b=0;b<nbasis;b++) precisionChange(subspace[b],_evec[b]);
+    CoarseScalar ip(_CoarseGrid);
+    blockOrthonormalize(ip,subspace);
+
+    FineFieldLow tmp(_FineGridLow);
+    for(int i=0;i<_evec.size();i++){
+      precisionChange(tmp,_evec[i]);
+      blockProject(evec_coarse[i],tmp,subspace);
+    }
+  }
+
+  // Fraction of |evec|^2 lost to compression, for checking the block size and nbasis choice
+  RealD CompressionError(const Field &evec,int i) {
+    FineFieldLow tmp(subspace[0].Grid());
+    FineFieldLow rec(subspace[0].Grid());
+    precisionChange(tmp,evec);
+    blockPromote(evec_coarse[i],rec,subspace);
+    rec.Checkerboard() = tmp.Checkerboard();
+    RealD nrm = norm2(tmp);
+    rec = rec - tmp;
+    return norm2(rec)/nrm;
+  }
+
+  void operator()(const Field &src,Field &guess) {
+    GridBase *coarse = evec_coarse[0].Grid();
+    FineFieldLow src_low(subspace[0].Grid());
+    FineFieldLow guess_low(subspace[0].Grid());
+    CoarseField  src_coarse(coarse);
+    CoarseField  guess_coarse(coarse);
+
+    precisionChange(src_low,src);
+    blockProject(src_coarse,src_low,subspace);
+    basisDeflate(evec_coarse,eval,src_coarse,guess_coarse);
+    blockPromote(guess_coarse,guess_low,subspace);
+    guess_low.Checkerboard() = src.Checkerboard();
+    precisionChange(guess,guess_low);
+  };
+};
+
 
 
 }
@@ -192,10 +192,24 @@ class GeneralisedMinimalResidual : public OperatorFunction<Field> {
     MatrixTimer.Stop();
 
     LinalgTimer.Start();
-    for (int i = 0; i <= iter; ++i) {
-      H(iter, i) = innerProduct(v[i], w);
-      w = w - ComplexD(H(iter, i)) * v[i];
-    }
+    // Classical Gram-Schmidt with one reorthogonalisation: all projections of a
+    // pass in one sweep and one reduction, v[iter+1] serving as scratch. |w| is
+    // taken after the second pass; by Pythagoras from the second pass's
+    // projections it would cancel catastrophically near breakdown.
+    int n = iter + 1;
+    std::vector<const Field *> vi(n), wi(n, &w);
+    for (int i = 0; i < n; ++i) vi[i] = &v[i];
+
+    std::vector<ComplexD> h, corr;
+    innerProductMulti(h, vi, wi);
+    basisLinearCombination(v[n], v, h, 0, n);
+    w = w - v[n];
+
+    innerProductMulti(corr, vi, wi);
+    basisLinearCombination(v[n], v, corr, 0, n);
+    w = w - v[n];
+
+    for (int i = 0; i < n; ++i) H(iter, i) = h[i] + corr[i];
 
     H(iter, iter + 1) = sqrt(norm2(w));
     v[iter + 1] = ComplexD(1. / H(iter, iter + 1)) * w;
@@ -178,7 +178,10 @@ public:
     q[0]= Az;
     qq[0]= zAAz;
     
-    cp =norm2(r);
+    std::vector<ComplexD> ip;
+    innerProductMulti(ip,{&r,&r},{&q[0],&r});
+    rq = real(ip[0]);
+    cp = real(ip[1]);
     LinalgTimer.Stop();
 
     for(int k=0;k<nstep;k++){
@@ -190,8 +193,7 @@ public:
       int peri_kp= kp%mmax;
 
       LinalgTimer.Start();
-      rq= real(innerProduct(r,q[peri_k])); // what if rAr not real?
-      a = rq/qq[peri_k];
+      a = rq/qq[peri_k]; // rq = <r|q[peri_k]>; what if rAr not real?
 
       axpy(psi,a,p[peri_k],psi);         
 
@@ -219,16 +221,28 @@ public:
       p[peri_kp]=z;
 
       int northog = ((kp)>(mmax-1))?(mmax-1):(kp);  // if more than mmax done, we orthog all mmax history.
+
+      // Coefficients only involve Az and the history, so take them all in one sweep
+      std::vector<const Field *> qback(northog), Azs(northog,&Az);
+      for(int back=0;back<northog;back++){
+	assert((k-back)>=0);
+	qback[back]=&q[(k-back)%mmax];
+      }
+      innerProductMulti(ip,qback,Azs);
+
       for(int back=0;back<northog;back++){
 
-	int peri_back=(k-back)%mmax;   	  assert((k-back)>=0);
+	int peri_back=(k-back)%mmax;
 
-	b=-real(innerProduct(q[peri_back],Az))/qq[peri_back];
+	b=-real(ip[back])/qq[peri_back];
 	p[peri_kp]=p[peri_kp]+b*p[peri_back];
 	q[peri_kp]=q[peri_kp]+b*q[peri_back];
 
       }
-      qq[peri_kp]=norm2(q[peri_kp]); // could use axpy_norm
+      // qq for this direction and rq for the next step in one reduction
+      innerProductMulti(ip,{&q[peri_kp],&r},{&q[peri_kp],&q[peri_kp]});
+      qq[peri_kp]=real(ip[0]);
+      rq         =real(ip[1]);
       LinalgTimer.Stop();
     }
     assert(0); // never reached
@@ -30,6 +30,8 @@
 #ifndef GRID_CARTESIAN_BASE_H
 #define GRID_CARTESIAN_BASE_H
 
+#include <typeindex>
+
 NAMESPACE_BEGIN(Grid);
 
 //////////////////////////////////////////////////////////////////////
@@ -285,6 +287,102 @@ public:
     gcoor.resize(_ndimension);
     for(int mu=0;mu<_ndimension;mu++) gcoor[mu] = Pcoor[mu]*_ldimensions[mu]+Lcoor[mu];
   }
+
+  //////////////////////////////////////////////////////////////////////////////////////////////
+  // Tiled traversal of the outer sites, for cache reuse by stencil like loops on CPUs.
+  //
+  // The reduced (outer site) volume is cut into tiles of tile[d] outer sites; tile[d]<=0
+  // takes the whole dimension. Tiles are visited in Z (Morton) order, sites lexicographically
+  // within a tile, and TiledOrder()[i] is the i-th outer site visited. accelerator_for_tiled
+  // follows it on the host; with no tiling, or on accelerators, sites are visited in order.
+  // Only kernels reading neighbouring sites use it (the halo gauge path kernel behind the
+  // gauge forces and the clover field strength); site local expressions gain nothing from
+  // it and stream in order.
+  //
+  // Grids take DefaultTiling() on construction, set by --tile on the command line.
+  //////////////////////////////////////////////////////////////////////////////////////////////
+private:
+  Vector<int32_t> _tiled_order;
+  Coordinate      _tile;
+
+public:
+  static Coordinate &DefaultTiling(void) { static Coordinate tile; return tile; }
+
+  const int32_t *TiledOrder(void) const { return _tiled_order.size() ? &_tiled_order[0] : nullptr; }
+  const Coordinate &Tiling(void) const { return _tile; }
+  void ClearTiling(void) { _tiled_order.resize(0); _tile.resize(0); }
+
+  void SetTiling(const Coordinate &tile)
+  {
+    int nd = _ndimension;
+    assert(tile.size()==nd);
+    Coordinate t(nd), ntile(nd);
+    int bits=0;
+    for(int d=0;d<nd;d++){
+      t[d]     = ( tile[d]>0 ) ? std::min(tile[d],_rdimensions[d]) : _rdimensions[d];
+      ntile[d] = (_rdimensions[d]+t[d]-1)/t[d];
+      while ( (1<<bits) < ntile[d] ) bits++;
+    }
+    assert(bits*nd<=64);
+
+    // Interleave the bits of the tile coordinates, dimension 0 fastest
+    int ntiles=1;
+    for(int d=0;d<nd;d++) ntiles*=ntile[d];
+    std::vector<std::pair<uint64_t,int> > zorder(ntiles);
+    Coordinate tcoor(nd);
+    for(int tt=0;tt<ntiles;tt++){
+      Lexicographic::CoorFromIndex(tcoor,tt,ntile);
+      uint64_t key=0;
+      for(int b=0;b<bits;b++){
+	for(int d=0;d<nd;d++){
+	  key |= (uint64_t)((tcoor[d]>>b)&0x1) << (b*nd+d);
+	}
+      }
+      zorder[tt] = std::make_pair(key,tt);
+    }
+    std::sort(zorder.begin(),zorder.end());
+
+    _tiled_order.resize(0);
+    _tiled_order.reserve(_osites);
+    Coordinate lo(nd), ext(nd), scoor(nd), ocoor(nd);
+    for(auto &z : zorder){
+      Lexicographic::CoorFromIndex(tcoor,z.second,ntile);
+      int vol=1;
+      for(int d=0;d<nd;d++){
+	lo[d]  = tcoor[d]*t[d];
+	ext[d] = std::min(t[d],_rdimensions[d]-lo[d]);
+	vol   *= ext[d];
+      }
+      for(int s=0;s<vol;s++){
+	Lexicographic::CoorFromIndex(scoor,s,ext);
+	for(int d=0;d<nd;d++) ocoor[d] = lo[d]+scoor[d];
+	_tiled_order.push_back(oIndexReduced(ocoor));
+      }
+    }
+    assert(_tiled_order.size()==(uint64_t)_osites);
+    _tile = t;
+  }
+  // Called at the end of Init
+  void DefaultTiles(void)
+  {
+    ClearTiling();
+    if ( DefaultTiling().size()==(int)_ndimension ) SetTiling(DefaultTiling());
+  }
+
+  //////////////////////////////////////////////////////////////////////////////////////////////
+  // Caches of objects derived from the grid geometry (e.g. Cshift plans), one per type T,
+  // default constructed on first use and freed with the grid.
+  //////////////////////////////////////////////////////////////////////////////////////////////
+private:
+  std::map<std::type_index,std::shared_ptr<void> > _caches;
+
+public:
+  template<class T> T &Cache(void)
+  {
+    std::shared_ptr<void> &c = _caches[std::type_index(typeid(T))];
+    if ( !c ) c = std::make_shared<T>();
+    return *static_cast<T *>(c.get());
+  }
 };
 
 NAMESPACE_END(Grid);
@@ -170,6 +170,8 @@ public:
         _slice_nblock[d] = nblock;
         block = block * _rdimensions[d];
       }
+
+    DefaultTiles();
   };
 
 };
@@ -251,6 +251,8 @@ public:
         block = block * _rdimensions[d];
       }
 
+    DefaultTiles();
+
     ////////////////////////////////////////////////
     // Create a checkerboard lookup table
     ////////////////////////////////////////////////
@@ -137,6 +137,15 @@ public:
 		      void *recv,
 		      int recv_from_rank,
 		      int bytes);
+
+  // Non blocking form; messages between a pair of ranks match in the order posted
+  void SendToRecvFromBegin(std::vector<CommsRequest_t> &list,
+			   void *xmit,
+			   int xmit_to_rank,
+			   void *recv,
+			   int recv_from_rank,
+			   int bytes);
+  void SendToRecvFromComplete(std::vector<CommsRequest_t> &list);
   
   double StencilSendToRecvFrom(void *xmit,
 			       int xmit_to_rank,
@@ -394,9 +394,40 @@ void CartesianCommunicator::StencilBarrier(void)
 {
   MPI_Barrier  (ShmComm);
 }
-//void CartesianCommunicator::SendToRecvFromComplete(std::vector<CommsRequest_t> &list)
-//{
-//}
+void CartesianCommunicator::SendToRecvFromBegin(std::vector<CommsRequest_t> &list,
+						void *xmit,
+						int dest,
+						void *recv,
+						int from,
+						int bytes)
+{
+  MPI_Request xrq;
+  MPI_Request rrq;
+  int myrank = _processor;
+  int ierr;
+
+  assert(acceleratorIsCommunicable(xmit));
+  assert(acceleratorIsCommunicable(recv));
+
+  ierr=MPI_Irecv(recv, bytes, MPI_CHAR,from,from,communicator,&rrq);
+  assert(ierr==0);
+  list.push_back(rrq);
+
+  ierr=MPI_Isend(xmit, bytes, MPI_CHAR,dest,myrank,communicator,&xrq);
+  assert(ierr==0);
+  list.push_back(xrq);
+}
+void CartesianCommunicator::SendToRecvFromComplete(std::vector<CommsRequest_t> &list)
+{
+  int nreq=list.size();
+
+  if (nreq==0) return;
+
+  std::vector<MPI_Status> status(nreq);
+  int ierr = MPI_Waitall(nreq,&list[0],&status[0]);
+  assert(ierr==0);
+  list.resize(0);
+}
 void CartesianCommunicator::Barrier(void)
 {
   int ierr = MPI_Barrier(communicator);
@@ -29,6 +29,7 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 #define _GRID_CSHIFT_H_
 
 #include <Grid/cshift/Cshift_common.h>
+#include <Grid/cshift/Cshift_plan.h>
 
 #ifdef GRID_COMMS_NONE
 #include <Grid/cshift/Cshift_none.h>
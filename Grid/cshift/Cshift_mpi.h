@@ -34,35 +34,11 @@ NAMESPACE_BEGIN(Grid);
 
 template<class vobj> Lattice<vobj> Cshift(const Lattice<vobj> &rhs,int dimension,int shift)
 {
-  typedef typename vobj::vector_type vector_type;
-  typedef typename vobj::scalar_type scalar_type;
-
   Lattice<vobj> ret(rhs.Grid()); 
-  
-  int fd = rhs.Grid()->_fdimensions[dimension];
-  int rd = rhs.Grid()->_rdimensions[dimension];
-
-  // Map to always positive shift modulo global full dimension.
-  shift = (shift+fd)%fd;
-
-  ret.Checkerboard() = rhs.Grid()->CheckerBoardDestination(rhs.Checkerboard(),shift,dimension);
-        
-  // the permute type
-  int simd_layout     = rhs.Grid()->_simd_layout[dimension];
-  int comm_dim        = rhs.Grid()->_processors[dimension] >1 ;
-  int splice_dim      = rhs.Grid()->_simd_layout[dimension]>1 && (comm_dim);
-
-
-  if ( !comm_dim ) {
-    //std::cout << "CSHIFT: Cshift_local" <<std::endl;
-    Cshift_local(ret,rhs,dimension,shift); // Handles checkerboarding
-  } else if ( splice_dim ) {
-    //std::cout << "CSHIFT: Cshift_comms_simd call - splice_dim = " << splice_dim << " shift " << shift << " dimension = " << dimension << std::endl;
-    Cshift_comms_simd(ret,rhs,dimension,shift);
-  } else {
-    //std::cout << "CSHIFT: Cshift_comms" <<std::endl;
-    Cshift_comms(ret,rhs,dimension,shift);
-  }
+  // Tables, buffers and ranks are cached per (grid, dimension, shift, checkerboard);
+  // Cshift_local / Cshift_comms / Cshift_comms_simd remain the one-off equivalents
+  auto plan = CshiftPlanCache<vobj>::Get(rhs.Grid(),dimension,shift,rhs.Checkerboard());
+  (*plan)(ret,rhs);
   return ret;
 }
 
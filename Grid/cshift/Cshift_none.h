@@ -31,8 +31,8 @@ NAMESPACE_BEGIN(Grid);
 template<class vobj> Lattice<vobj> Cshift(const Lattice<vobj> &rhs,int dimension,int shift)
 {
   Lattice<vobj> ret(rhs.Grid());
-  ret.Checkerboard() = rhs.Grid()->CheckerBoardDestination(rhs.Checkerboard(),shift,dimension);
-  Cshift_local(ret,rhs,dimension,shift);
+  auto plan = CshiftPlanCache<vobj>::Get(rhs.Grid(),dimension,shift,rhs.Checkerboard());
+  (*plan)(ret,rhs);
   return ret;
 }
 NAMESPACE_END(Grid);
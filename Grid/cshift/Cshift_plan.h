@@ -0,0 +1,445 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/cshift/Cshift_plan.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Persistent Cshift plans.
+//
+// A CshiftPlan holds what Cshift otherwise works out on every call for one
+// (grid, dimension, shift, source checkerboard): the plane copy, gather and
+// scatter tables, the neighbour ranks and the face buffers. The faces of all
+// planes (and both checkerboard passes) are exchanged with non blocking
+// messages posted together, and the on node planes are copied while they are
+// in flight.
+//
+// CshiftPlanCache keeps the plans of a grid in the grid itself (GridBase::Cache),
+// so the thousands of Cshifts made by gauge observables, smearing and gauge
+// fixing reuse tables and buffers, and the plans are freed with the grid. The
+// tables are of local volume size, so each cache keeps only the
+// CshiftPlanCacheDepth (--cshift-plans) most recently used plans; callers hold
+// plans by shared_ptr, so one evicted in the middle of a shift lives until it
+// completes.
+// Batched Cshifts of several fields, or of one field by several shifts, post
+// the messages of every member before waiting on any of them; members sharing
+// a plan use its tables with face buffers of their own (slots).
+////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+class CshiftPlan {
+public:
+  typedef typename vobj::scalar_object scalar_object;
+  typedef std::pair<int,int> Entry;
+
+  // Offsets are in elements of a slot's face buffers
+  struct Message {
+    uint64_t xmit;
+    int      xmit_to_rank;
+    uint64_t recv;
+    int      recv_from_rank;
+    int      bytes;
+  };
+  // One plane of a simd split face; lane i is merged from the received face
+  // (recv_lane[i]<0) or, on node, from the gathered lane recv_lane[i]
+  struct ExtractPlane {
+    int plane;
+    int splane;
+    int cbmask;
+    std::vector<int> recv_lane;
+  };
+
+  CshiftPlan(GridBase *_grid,int _dimension,int _shift,int _source_cb)
+    : grid(_grid), dimension(_dimension), source_cb(_source_cb)
+  {
+    int fd = grid->_fdimensions[dimension];
+    shift  = (_shift+fd)%fd;
+    dest_cb = grid->CheckerBoardDestination(source_cb,shift,dimension);
+
+    int sshift[2];
+    sshift[0] = grid->CheckerBoardShiftForCB(source_cb,dimension,shift,Even);
+    sshift[1] = grid->CheckerBoardShiftForCB(source_cb,dimension,shift,Odd);
+    std::vector<int> passes;
+    if ( sshift[0] == sshift[1] ) passes.push_back(0x3);
+    else                          passes = std::vector<int>({0x1,0x2});
+
+    int comm_dim   = grid->_processors[dimension] >1 ;
+    int splice_dim = grid->_simd_layout[dimension]>1 && (comm_dim);
+    if ( !comm_dim )       for(auto cbmask : passes) PlanLocal(cbmask);
+    else if ( splice_dim ) for(auto cbmask : passes) PlanCommsSimd(cbmask);
+    else                   for(auto cbmask : passes) PlanComms(cbmask);
+  }
+  CshiftPlan(const CshiftPlan &) = delete;
+  CshiftPlan &operator=(const CshiftPlan &) = delete;
+
+  int DestinationCheckerboard(void) const { return dest_cb; }
+  int Slots(void) const { return slots.size(); }
+
+  ////////////////////////////////////////////////////////////////
+  // Begin gathers and posts the faces, then copies the local planes;
+  // Complete waits and scatters. ret must not alias rhs. Shifts in
+  // flight together through one plan need different slots.
+  ////////////////////////////////////////////////////////////////
+  void Begin(Lattice<vobj> &ret,const Lattice<vobj> &rhs,int slot=0)
+  {
+    conformable(grid,rhs.Grid());
+    conformable(grid,ret.Grid());
+    assert(rhs.Checkerboard()==source_cb);
+    ret.Checkerboard() = dest_cb;
+
+    Slot &s = GetSlot(slot);
+    if ( gather_table.size() ) {
+      autoView(rhs_v , rhs, AcceleratorRead);
+      auto buffer_p = &s.send_buf[0];
+      auto table    = &gather_table[0];
+      accelerator_for(i,gather_table.size(),vobj::Nsimd(),{
+	coalescedWrite(buffer_p[table[i].first],coalescedRead(rhs_v[table[i].second]));
+      });
+    }
+    for(int p=0;p<extract_planes.size();p++){
+      ExtractPointerArray<scalar_object> pointers(grid->Nsimd());
+      for(int i=0;i<grid->Nsimd();i++) pointers[i] = ExtractLane(s.send_extract,p,i);
+      Gather_plane_extract(rhs,pointers,dimension,extract_planes[p].splane,extract_planes[p].cbmask);
+    }
+    for(auto &m : messages){
+      void *xmit, *recv;
+      if ( extract_planes.size() ) { xmit = &s.send_extract[m.xmit]; recv = &s.recv_extract[m.recv]; }
+      else                         { xmit = &s.send_buf[m.xmit];     recv = &s.recv_buf[m.recv];     }
+      grid->SendToRecvFromBegin(s.requests,xmit,m.xmit_to_rank,recv,m.recv_from_rank,m.bytes);
+    }
+    if ( copy_table.size() ) {
+      autoView(rhs_v , rhs, AcceleratorRead);
+      autoView(ret_v , ret, AcceleratorWrite);
+      auto table = &copy_table[0];
+      accelerator_for(i,copy_table.size(),vobj::Nsimd(),{
+	coalescedWrite(ret_v[table[i].first],coalescedRead(rhs_v[table[i].second]));
+      });
+    }
+    if ( permute_table.size() ) {
+      autoView(rhs_v , rhs, AcceleratorRead);
+      autoView(ret_v , ret, AcceleratorWrite);
+      auto table = &permute_table[0];
+      auto ptype = &permute_type[0];
+      accelerator_for(i,permute_table.size(),1,{
+	permute(ret_v[table[i].first],rhs_v[table[i].second],ptype[i]);
+      });
+    }
+  }
+  void Complete(Lattice<vobj> &ret,int slot=0)
+  {
+    Slot &s = *slots[slot];
+    grid->SendToRecvFromComplete(s.requests);
+    if ( scatter_table.size() ) {
+      autoView(ret_v , ret, AcceleratorWrite);
+      auto buffer_p = &s.recv_buf[0];
+      auto table    = &scatter_table[0];
+      accelerator_for(i,scatter_table.size(),vobj::Nsimd(),{
+	coalescedWrite(ret_v[table[i].first],coalescedRead(buffer_p[table[i].second]));
+      });
+    }
+    for(int p=0;p<extract_planes.size();p++){
+      ExtractPointerArray<scalar_object> rpointers(grid->Nsimd());
+      for(int i=0;i<grid->Nsimd();i++){
+	int lane = extract_planes[p].recv_lane[i];
+	rpointers[i] = (lane<0) ? ExtractLane(s.recv_extract,p,i) : ExtractLane(s.send_extract,p,lane);
+      }
+      Scatter_plane_merge(ret,rpointers,dimension,extract_planes[p].plane,extract_planes[p].cbmask);
+    }
+  }
+  void operator() (Lattice<vobj> &ret,const Lattice<vobj> &rhs)
+  {
+    Begin(ret,rhs);
+    Complete(ret);
+  }
+
+private:
+  GridBase *grid;
+  int dimension;
+  int shift;
+  int source_cb;
+  int dest_cb;
+
+  // Shared by every slot
+  Vector<Entry> copy_table;
+  Vector<Entry> permute_table;
+  Vector<int>   permute_type;
+  Vector<Entry> gather_table;
+  Vector<Entry> scatter_table;
+  uint64_t      faces=0;
+  uint64_t      extract_size=0; // sites of one lane of a simd split plane
+  std::vector<ExtractPlane> extract_planes;
+  std::vector<Message>      messages;
+
+  // Face buffers of one shift in flight
+  struct Slot {
+    commVector<vobj>            send_buf;
+    commVector<vobj>            recv_buf;
+    commVector<scalar_object>   send_extract;
+    commVector<scalar_object>   recv_extract;
+    std::vector<CommsRequest_t> requests;
+  };
+  std::vector<std::unique_ptr<Slot> > slots;
+
+  Slot &GetSlot(int slot)
+  {
+    if ( slot >= (int)slots.size() ) slots.resize(slot+1);
+    if ( !slots[slot] ) {
+      uint64_t lanes = extract_planes.size()*grid->Nsimd()*extract_size;
+      slots[slot].reset(new Slot);
+      slots[slot]->send_buf.resize(faces);
+      slots[slot]->recv_buf.resize(faces);
+      slots[slot]->send_extract.resize(lanes);
+      slots[slot]->recv_extract.resize(lanes);
+    }
+    return *slots[slot];
+  }
+  scalar_object *ExtractLane(commVector<scalar_object> &buf,int plane,int lane)
+  {
+    return &buf[(plane*grid->Nsimd()+lane)*extract_size];
+  }
+
+  // Sites of a plane selected by cbmask, as offsets from the plane start
+  void PlaneSites(int cbmask,std::vector<int> &sites)
+  {
+    if ( !grid->CheckerBoarded(dimension) ) cbmask = 0x3;
+    int e1    =grid->_slice_nblock[dimension];
+    int e2    =grid->_slice_block[dimension];
+    int stride=grid->_slice_stride[dimension];
+    sites.resize(0);
+    for(int n=0;n<e1;n++){
+      for(int b=0;b<e2;b++){
+	int o  = n*stride+b;
+	int ocb=1<<grid->CheckerBoardFromOindex(o);
+	if ( (cbmask==0x3) || (ocb&cbmask) ) sites.push_back(o);
+      }
+    }
+  }
+
+  // As Cshift_local
+  void PlanLocal(int cbmask)
+  {
+    int rd = grid->_rdimensions[dimension];
+    int ly = grid->_simd_layout[dimension];
+    int permute_dim =grid->PermuteDim(dimension);
+    int ptype       =grid->PermuteType(dimension);
+    int cb     = (cbmask==0x2)? Odd : Even;
+    int sshift = grid->CheckerBoardShiftForCB(source_cb,dimension,shift,cb);
+    std::vector<int> sites;
+    PlaneSites(cbmask,sites);
+    for(int x=0;x<rd;x++){
+      int sx = (x+sshift)%rd;
+      int lo = x *grid->_ostride[dimension];
+      int ro = sx*grid->_ostride[dimension];
+      int permute_slice=0;
+      int ptype_dist = ptype;
+      if(permute_dim){
+	int wrap = sshift/rd; wrap=wrap % ly;
+	int  num = sshift%rd;
+	if ( x< rd-num ) permute_slice=wrap;
+	else permute_slice = (wrap+1)%ly;
+	if ( (ly>2) && (permute_slice) ) {
+	  assert(ptype & RotateBit);
+	  ptype_dist = ptype|permute_slice;
+	}
+      }
+      for(auto o : sites){
+	if ( permute_slice ) {
+	  permute_table.push_back(Entry(lo+o,ro+o));
+	  permute_type.push_back(ptype_dist);
+	} else {
+	  copy_table.push_back(Entry(lo+o,ro+o));
+	}
+      }
+    }
+  }
+
+  // As Cshift_comms
+  void PlanComms(int cbmask)
+  {
+    int rd = grid->_rdimensions[dimension];
+    int pd = grid->_processors[dimension];
+    assert(grid->_simd_layout[dimension]==1);
+    int cb     = (cbmask==0x2)? Odd : Even;
+    int sshift = grid->CheckerBoardShiftForCB(source_cb,dimension,shift,cb);
+    std::vector<int> sites;
+    PlaneSites(cbmask,sites);
+    for(int x=0;x<rd;x++){
+      int sx        =  (x+sshift)%rd;
+      int comm_proc = ((x+sshift)/rd)%pd;
+      int lo = x *grid->_ostride[dimension];
+      int ro = sx*grid->_ostride[dimension];
+      if (comm_proc==0) {
+	for(auto o : sites) copy_table.push_back(Entry(lo+o,ro+o));
+      } else {
+	Message m;
+	grid->ShiftedRanks(dimension,comm_proc,m.xmit_to_rank,m.recv_from_rank);
+	m.xmit  = faces;
+	m.recv  = faces;
+	m.bytes = sites.size()*sizeof(vobj);
+	for(int i=0;i<sites.size();i++){
+	  gather_table.push_back (Entry(faces+i,ro+sites[i]));
+	  scatter_table.push_back(Entry(lo+sites[i],faces+i));
+	}
+	faces += sites.size();
+	messages.push_back(m);
+      }
+    }
+  }
+
+  // As Cshift_comms_simd; every plane has its own lanes in the slot buffers
+  void PlanCommsSimd(int cbmask)
+  {
+    const int Nsimd = grid->Nsimd();
+    int rd = grid->_rdimensions[dimension];
+    int ld = grid->_ldimensions[dimension];
+    int pd = grid->_processors[dimension];
+    assert(grid->_simd_layout[dimension]==2);
+    int permute_type=grid->PermuteType(dimension);
+    extract_size = grid->_slice_nblock[dimension]*grid->_slice_block[dimension];
+    int bytes = extract_size*sizeof(scalar_object);
+
+    int cb     = (cbmask==0x2)? Odd : Even;
+    int sshift = grid->CheckerBoardShiftForCB(source_cb,dimension,shift,cb);
+    for(int x=0;x<rd;x++){
+      ExtractPlane p;
+      p.plane  = x;
+      p.splane = (x+sshift)%rd;
+      p.cbmask = cbmask;
+      p.recv_lane.resize(Nsimd);
+      uint64_t base = extract_planes.size()*Nsimd*extract_size;
+      for(int i=0;i<Nsimd;i++){
+	int inner_bit = (Nsimd>>(permute_type+1));
+	int ic= (i&inner_bit)? 1:0;
+	int my_coor  = rd*ic + x;
+	int nbr_coor = my_coor+sshift;
+	int nbr_proc = ((nbr_coor)/ld) % pd;
+	int nbr_ic   = (nbr_coor%ld)/rd;
+	int nbr_lane = (i&(~inner_bit));
+	if (nbr_ic) nbr_lane|=inner_bit;
+	if(nbr_proc){
+	  Message m;
+	  grid->ShiftedRanks(dimension,nbr_proc,m.xmit_to_rank,m.recv_from_rank);
+	  m.xmit  = base + nbr_lane*extract_size;
+	  m.recv  = base + i*extract_size;
+	  m.bytes = bytes;
+	  messages.push_back(m);
+	  p.recv_lane[i] = -1;
+	} else {
+	  p.recv_lane[i] = nbr_lane;
+	}
+      }
+      extract_planes.push_back(p);
+    }
+  }
+};
+
+extern int CshiftPlanCacheDepth;
+
+// The plans of one grid, least recently used first out; lives in, and is
+// freed with, the grid
+template<class vobj>
+class CshiftPlanCache {
+public:
+  typedef std::tuple<int,int,int> Key;
+  typedef std::shared_ptr<CshiftPlan<vobj> > PlanPtr;
+
+  static PlanPtr Get(GridBase *grid,int dimension,int shift,int source_cb)
+  {
+    int fd = grid->_fdimensions[dimension];
+    Key key = std::make_tuple(dimension,(shift+fd)%fd,source_cb);
+    CshiftPlanCache<vobj> &cache = grid->Cache<CshiftPlanCache<vobj> >();
+    PlanPtr plan;
+    auto it = cache.plans.find(key);
+    if ( it != cache.plans.end() ) {
+      plan = it->second.first;
+      cache.lru.splice(cache.lru.begin(),cache.lru,it->second.second);
+    } else {
+      plan = std::make_shared<CshiftPlan<vobj> >(grid,dimension,shift,source_cb);
+      cache.lru.push_front(key);
+      cache.plans[key] = std::make_pair(plan,cache.lru.begin());
+    }
+    while ( (int)cache.lru.size() > std::max(CshiftPlanCacheDepth,1) ) {
+      cache.plans.erase(cache.lru.back());
+      cache.lru.pop_back();
+    }
+    return plan;
+  }
+  static int Size(GridBase *grid) { return grid->Cache<CshiftPlanCache<vobj> >().plans.size(); }
+private:
+  std::list<Key> lru; // most recently used first
+  std::map<Key,std::pair<PlanPtr,typename std::list<Key>::iterator> > plans;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Batched shifts; all faces are in flight together
+////////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+void CshiftBatch(std::vector<Lattice<vobj> > &ret,const std::vector<const Lattice<vobj> *> &rhs,
+		 const std::vector<CshiftPlan<vobj> *> &plans)
+{
+  int n = plans.size();
+  // Members sharing a plan take successive slots
+  std::vector<int> slot(n,0);
+  for(int i=0;i<n;i++) for(int j=0;j<i;j++) if ( plans[j]==plans[i] ) slot[i]++;
+  for(int i=0;i<n;i++) plans[i]->Begin(ret[i],*rhs[i],slot[i]);
+  for(int i=0;i<n;i++) plans[i]->Complete(ret[i],slot[i]);
+}
+template<class vobj>
+std::vector<Lattice<vobj> > Cshift(const std::vector<Lattice<vobj> > &rhs,int dimension,int shift)
+{
+  int n = rhs.size();
+  std::vector<Lattice<vobj> > ret;
+  std::vector<const Lattice<vobj> *> src(n);
+  std::vector<typename CshiftPlanCache<vobj>::PlanPtr> hold(n);
+  std::vector<CshiftPlan<vobj> *> plans(n);
+  ret.reserve(n);
+  for(int i=0;i<n;i++){
+    ret.push_back(Lattice<vobj>(rhs[i].Grid()));
+    src[i]   = &rhs[i];
+    hold[i]  = CshiftPlanCache<vobj>::Get(rhs[i].Grid(),dimension,shift,rhs[i].Checkerboard());
+    plans[i] = hold[i].get();
+  }
+  CshiftBatch(ret,src,plans);
+  return ret;
+}
+template<class vobj>
+std::vector<Lattice<vobj> > Cshift(const Lattice<vobj> &rhs,int dimension,const std::vector<int> &shifts)
+{
+  int n = shifts.size();
+  std::vector<Lattice<vobj> > ret;
+  std::vector<const Lattice<vobj> *> src(n,&rhs);
+  std::vector<typename CshiftPlanCache<vobj>::PlanPtr> hold(n);
+  std::vector<CshiftPlan<vobj> *> plans(n);
+  ret.reserve(n);
+  for(int i=0;i<n;i++){
+    ret.push_back(Lattice<vobj>(rhs.Grid()));
+    hold[i]  = CshiftPlanCache<vobj>::Get(rhs.Grid(),dimension,shifts[i],rhs.Checkerboard());
+    plans[i] = hold[i].get();
+  }
+  CshiftBatch(ret,src,plans);
+  return ret;
+}
+
+NAMESPACE_END(Grid);
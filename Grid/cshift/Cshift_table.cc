@@ -1,4 +1,5 @@
 #include <Grid/GridCore.h>       
 NAMESPACE_BEGIN(Grid);
 Vector<std::pair<int,int> > Cshift_table; 
+int CshiftPlanCacheDepth = 64;
 NAMESPACE_END(Grid);
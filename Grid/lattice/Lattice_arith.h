@@ -216,7 +216,7 @@ void add(Lattice<obj1> &ret,const obj2 &lhs,const Lattice<obj3> &rhs){
   });
 }
   
-template<class sobj,class vobj> inline
+template<class sobj,class vobj> inline simd_dispatch
 void axpy(Lattice<vobj> &ret,sobj a,const Lattice<vobj> &x,const Lattice<vobj> &y){
   ret.Checkerboard() = x.Checkerboard();
   conformable(ret,x);
@@ -229,7 +229,7 @@ void axpy(Lattice<vobj> &ret,sobj a,const Lattice<vobj> &x,const Lattice<vobj> &
     coalescedWrite(ret_v[ss],tmp);
   });
 }
-template<class sobj,class vobj> inline
+template<class sobj,class vobj> inline simd_dispatch
 void axpby(Lattice<vobj> &ret,sobj a,sobj b,const Lattice<vobj> &x,const Lattice<vobj> &y){
   ret.Checkerboard() = x.Checkerboard();
   conformable(ret,x);
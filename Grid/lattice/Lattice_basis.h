@@ -230,17 +230,69 @@ void basisSortInPlace(std::vector<Field> & _v,std::vector<RealD>& sort_vals, boo
   basisReorderInPlace(_v,sort_vals,idx);
 }
 
-// PAB: faster to compute the inner products first then fuse loops.
-// If performance critical can improve.
+// All inner products ip[k-k0] = <basis[k]|v>, k0<=k<k1, in a single fused sweep
+// with double precision accumulation and one global reduction (innerProductMulti).
+template<class Field>
+void basisInnerProducts(std::vector<ComplexD> &ip,const std::vector<Field> &basis,const Field &v,int k0,int k1)
+{
+  typedef typename Field::vector_object vobj;
+  int nk = k1-k0;
+  if ( nk<=0 ) { ip.resize(0); return; }
+  std::vector<const Lattice<vobj> *> left(nk), right(nk,&v);
+  for(int k=k0;k<k1;k++) left[k-k0] = &basis[k];
+  innerProductMulti(ip,left,right);
+}
+
+// result = sum_k coeff[k-k0] basis[k], k0<=k<k1, in a single sweep
+template<class Field>
+void basisLinearCombination(Field &result,const std::vector<Field> &basis,const std::vector<ComplexD> &coeff,int k0,int k1)
+{
+  typedef decltype(basis[0].View(AcceleratorRead)) View;
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::scalar_type    scalar_type;
+  GridBase* grid = result.Grid();
+
+  int nk = k1-k0;
+  assert(coeff.size()>=nk);
+  result.Checkerboard() = basis[k0].Checkerboard();
+
+  Vector<View> basis_v; basis_v.reserve(nk);
+  for(int k=k0;k<k1;k++){
+    conformable(basis[k],result);
+    basis_v.push_back(basis[k].View(AcceleratorRead));
+  }
+  View *basis_vp = &basis_v[0];
+
+  Vector<scalar_type> coeff_v(nk);
+  scalar_type *coeff_p = &coeff_v[0];
+  for(int k=0;k<nk;k++) coeff_p[k] = coeff[k];
+
+  vobj zz=Zero();
+  autoView(result_v,result,AcceleratorWrite);
+  accelerator_for(ss, grid->oSites(),vobj::Nsimd(),{
+    auto B=coalescedRead(zz);
+    for(int k=0; k<nk; ++k){
+      B +=coeff_p[k] * coalescedRead(basis_vp[k][ss]);
+    }
+    coalescedWrite(result_v[ss], B);
+  });
+  for(int k=0;k<nk;k++) basis_v[k].ViewClose();
+}
+
+// Inner products are batched into one sweep and one global sum,
+// followed by a single fused accumulation pass.
 template<class Field>
 void basisDeflate(const std::vector<Field> &_v,const std::vector<RealD>& eval,const Field& src_orig,Field& result) {
-  result = Zero();
   assert(_v.size()==eval.size());
   int N = (int)_v.size();
-  for (int i=0;i<N;i++) {
-    Field& tmp = _v[i];
-    axpy(result,TensorRemove(innerProduct(tmp,src_orig)) / eval[i],tmp,result);
+  if ( N==0 ) {
+    result = Zero();
+    return;
   }
+  std::vector<ComplexD> ip;
+  basisInnerProducts(ip,_v,src_orig,0,N);
+  for (int i=0;i<N;i++) ip[i] = ip[i] / eval[i];
+  basisLinearCombination(result,_v,ip,0,N);
 }
 
 NAMESPACE_END(Grid);
@@ -0,0 +1,233 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/lattice/Lattice_fusion.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Lazy assignment blocks: several expression template assignments, plus
+// reductions, evaluated in one site loop.
+//
+//   RealD rr;
+//   evaluateFused(lazyAssign(r, r - a*q),
+//                 lazyAssign(x, x + a*p),
+//                 lazyNorm2 (rr, r));
+//
+// At each site the assignments are applied in the order given, so a later
+// statement sees what an earlier one wrote; the reductions then accumulate on
+// the updated values. As with any Grid expression, a statement only reads the
+// site it writes, so a target may also appear on its own right hand side.
+//
+// Reductions are summed per thread in the same order as innerProduct and norm2
+// (so a fused norm2 is bit identical to the unfused one) and go across ranks
+// in a single GlobalSumVector. On accelerators the reductions are a second,
+// shared pass over the sites.
+////////////////////////////////////////////////////////////////////////////////
+
+template<class vobj,class Expr>
+class LatticeLazyAssign {
+public:
+  typedef typename ViewMap<Expr>::Type expr_t;
+
+  Lattice<vobj>    *lat;
+  expr_t            expr;
+  LatticeView<vobj> me;
+
+  LatticeLazyAssign(Lattice<vobj> &_lat,const Expr &_expr) : lat(&_lat), expr(_expr), me(_lat) {};
+
+  GridBase *Grid(void) {
+    GridBase *egrid(nullptr);
+    GridFromExpression(egrid,expr);
+    assert(egrid!=nullptr);
+    conformable(lat->Grid(),egrid);
+    return egrid;
+  }
+  void Open(uint64_t slots) {
+    int cb=-1;
+    CBFromExpression(cb,expr);
+    assert( (cb==Odd) || (cb==Even));
+    lat->Checkerboard()=cb;
+    ExpressionViewOpen(expr);
+    // Not WriteDiscard; the target may be read by this or another statement
+    me.ViewOpen(AcceleratorWrite);
+  }
+  void Close(void) {
+    me.ViewClose();
+    ExpressionViewClose(expr);
+  }
+  accelerator_inline void Assign(uint64_t ss) {
+    auto tmp = eval(ss,expr);
+    coalescedWrite(me[ss],tmp);
+  }
+  accelerator_inline void Accumulate(uint64_t slot,uint64_t ss) {};
+  void Rank(std::vector<ComplexD> &red) {};
+  void Result(const std::vector<ComplexD> &red,int &r) {};
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// <left|right>, stored as ComplexD or as its real part (norm2)
+////////////////////////////////////////////////////////////////////////////////
+template<class Left,class Right>
+class LatticeLazyInnerProduct {
+public:
+  typedef typename ViewMap<Left >::Type left_t;
+  typedef typename ViewMap<Right>::Type right_t;
+  typedef typename std::remove_const<typename std::remove_reference<decltype(vecEval(0,std::declval<left_t>()))>::type>::type vobj;
+  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+
+  left_t    left;
+  right_t   right;
+  bool      norm;
+  ComplexD *cresult;
+  RealD    *rresult;
+  inner_t  *acc;
+  uint64_t  nacc;
+
+  LatticeLazyInnerProduct(ComplexD &_result,const Left &_left,const Right &_right)
+    : left(_left), right(_right), norm(false), cresult(&_result), rresult(nullptr), acc(nullptr), nacc(0) {};
+  LatticeLazyInnerProduct(RealD &_result,const Left &_left)
+    : left(_left), right(_left), norm(true), cresult(nullptr), rresult(&_result), acc(nullptr), nacc(0) {};
+
+  GridBase *Grid(void) {
+    GridBase *egrid(nullptr);
+    GridFromExpression(egrid,left);
+    GridFromExpression(egrid,right);
+    assert(egrid!=nullptr);
+    return egrid;
+  }
+  // One accumulator per thread on the host, one per site on accelerators
+  void Open(uint64_t slots) {
+    nacc = slots;
+    acc  = (inner_t *)acceleratorAllocShared(nacc*sizeof(inner_t));
+#if ( (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP)) )
+    for(uint64_t t=0;t<nacc;t++) acc[t]=Zero();
+#endif
+    ExpressionViewOpen(left);
+    ExpressionViewOpen(right);
+  }
+  void Close(void) {
+    ExpressionViewClose(right);
+    ExpressionViewClose(left);
+    acceleratorFreeShared(acc);
+  }
+  accelerator_inline void Assign(uint64_t ss) {};
+#if ( (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP)) )
+  inline void Accumulate(uint64_t thr,uint64_t ss) {
+    if ( norm ) {
+      auto l = eval(ss,left);
+      acc[thr] = acc[thr] + innerProductD(l,l);
+    } else {
+      acc[thr] = acc[thr] + innerProductD(eval(ss,left),eval(ss,right));
+    }
+  }
+  void Rank(std::vector<ComplexD> &red) {
+    ComplexD ip(0.0);
+    for(uint64_t t=0;t<nacc;t++) ip+=TensorRemove(Reduce(acc[t]));
+    red.push_back(ip);
+  }
+#else
+  // Whole vector objects; the reduction pass is not split over SIMT lanes
+  accelerator_inline void Accumulate(uint64_t slot,uint64_t ss) {
+    acc[slot] = innerProductD(vecEval(ss,left),vecEval(ss,right));
+  }
+  void Rank(std::vector<ComplexD> &red) {
+    ComplexD ip = TensorRemove(sum(acc,nacc));
+    red.push_back(ip);
+  }
+#endif
+  void Result(const std::vector<ComplexD> &red,int &r) {
+    if ( norm ) *rresult = real(red[r]);
+    else        *cresult = red[r];
+    r++;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Statement builders; the expressions are captured, not evaluated
+////////////////////////////////////////////////////////////////////////////////
+template<class vobj,class Expr>
+inline LatticeLazyAssign<vobj,Expr> lazyAssign(Lattice<vobj> &lat,const Expr &expr)
+{
+  return LatticeLazyAssign<vobj,Expr>(lat,expr);
+}
+template<class Left,class Right>
+inline LatticeLazyInnerProduct<Left,Right> lazyInnerProduct(ComplexD &ip,const Left &left,const Right &right)
+{
+  return LatticeLazyInnerProduct<Left,Right>(ip,left,right);
+}
+template<class Arg>
+inline LatticeLazyInnerProduct<Arg,Arg> lazyNorm2(RealD &nrm,const Arg &arg)
+{
+  return LatticeLazyInnerProduct<Arg,Arg>(nrm,arg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Run a block of lazy statements over the sites once
+////////////////////////////////////////////////////////////////////////////////
+template<class... Statements>
+inline void evaluateFused(Statements... stmt)
+{
+  typedef int expand[];
+  GridBase *grid(nullptr);
+  GridBase *grids[] = { stmt.Grid()... };
+  for(auto g : grids) {
+    if ( grid ) conformable(grid,g);
+    else grid = g;
+  }
+  const uint64_t sites = grid->oSites();
+
+#if ( (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP)) )
+  // Same work split as sum_cpu
+  const int nthread = GridThread::GetThreads();
+  (void)expand{ 0, (stmt.Open(nthread),0)... };
+  thread_for(thr,nthread,{
+    int nwork, mywork, myoff;
+    nwork = sites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    for(uint64_t ss=myoff;ss<mywork+myoff;ss++){
+      (void)expand{ 0, (stmt.Assign(ss),0)... };
+      (void)expand{ 0, (stmt.Accumulate(thr,ss),0)... };
+    }
+  });
+#else
+  (void)expand{ 0, (stmt.Open(sites),0)... };
+  accelerator_for(ss,sites,grid->Nsimd(),{
+    (void)expand{ 0, (stmt.Assign(ss),0)... };
+  });
+  accelerator_for(ss,sites,1,{
+    (void)expand{ 0, (stmt.Accumulate(ss,ss),0)... };
+  });
+#endif
+
+  std::vector<ComplexD> red;
+  (void)expand{ 0, (stmt.Rank(red),0)... };
+  if ( red.size() ) grid->GlobalSumVector(&red[0],red.size());
+  int r=0;
+  (void)expand{ 0, (stmt.Result(red,r),0)... };
+  (void)expand{ 0, (stmt.Close(),0)... };
+}
+
+NAMESPACE_END(Grid);
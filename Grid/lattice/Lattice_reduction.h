@@ -35,7 +35,7 @@ NAMESPACE_BEGIN(Grid);
 // FIXME this should promote to double and accumulate
 //////////////////////////////////////////////////////
 template<class vobj>
-inline typename vobj::scalar_object sum_cpu(const vobj *arg, Integer osites)
+inline simd_dispatch typename vobj::scalar_object sum_cpu(const vobj *arg, Integer osites)
 {
   typedef typename vobj::scalar_object  sobj;
 
@@ -65,7 +65,7 @@ inline typename vobj::scalar_object sum_cpu(const vobj *arg, Integer osites)
   return ssum;
 }
 template<class vobj>
-inline typename vobj::scalar_objectD sumD_cpu(const vobj *arg, Integer osites)
+inline simd_dispatch typename vobj::scalar_objectD sumD_cpu(const vobj *arg, Integer osites)
 {
   typedef typename vobj::scalar_objectD  sobj;
 
@@ -141,10 +141,128 @@ template<class vobj> inline RealD norm2(const Lattice<vobj> &arg){
   return real(nrm); 
 }
 
+template<class vobj> inline ComplexD rankInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right);
+
+//////////////////////////////////////////////////////////////////////////////
+// Fused reductions: ip[i] = <*left[i]|*right[i]> for a list of pairs (a norm is
+// a pair with left==right) in one sweep over the sites. Per thread double
+// accumulators replace the per site scratch array, and the innerProductMulti
+// form merges all the results into one GlobalSumVector.
+//////////////////////////////////////////////////////////////////////////////
+template<class vobj>
+inline simd_dispatch void rankInnerProductMulti(std::vector<ComplexD> &ip,
+				  const std::vector<const Lattice<vobj> *> &left,
+				  const std::vector<const Lattice<vobj> *> &right)
+{
+  int n = left.size();
+  assert(right.size()==n);
+  ip.resize(n);
+  if ( n==0 ) return;
+  GridBase *grid = left[0]->Grid();
+  for(int i=0;i<n;i++){
+    conformable(grid,left[i]->Grid());
+    conformable(grid,right[i]->Grid());
+  }
+
+#if ( (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP)) )
+  typedef decltype(left[0]->View(CpuRead)) View;
+  typedef decltype(innerProductD(vobj(),vobj())) inner_t;
+
+  Vector<View> left_v;  left_v.reserve(n);
+  Vector<View> right_v; right_v.reserve(n);
+  for(int i=0;i<n;i++){
+    left_v.push_back(left[i]->View(CpuRead));
+    right_v.push_back(right[i]->View(CpuRead));
+  }
+
+  // Same work split and order as sum_cpu, so a single pair matches the unfused result
+  const int nthread = GridThread::GetThreads();
+  const uint64_t sites = grid->oSites();
+  Vector<inner_t>  acc(nthread*n);
+  Vector<ComplexD> partial(nthread*n);
+  thread_for(thr,nthread,{
+    int nwork, mywork, myoff;
+    nwork = sites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    inner_t *acc_t = &acc[thr*n];
+    for(int i=0;i<n;i++) acc_t[i]=Zero();
+    for(int ss=myoff;ss<mywork+myoff; ss++){
+      for(int i=0;i<n;i++){
+	acc_t[i] = acc_t[i] + innerProductD(left_v[i][ss],right_v[i][ss]);
+      }
+    }
+    for(int i=0;i<n;i++) partial[thr*n+i] = TensorRemove(Reduce(acc_t[i]));
+  });
+  for(int i=0;i<n;i++){
+    ip[i]=0.0;
+    for(int t=0;t<nthread;t++) ip[i]+=partial[t*n+i];
+  }
+  for(int i=0;i<n;i++){
+    left_v[i].ViewClose();
+    right_v[i].ViewClose();
+  }
+#else
+  // One kernel forms up to Nfuse products per site as a short vector, and one
+  // reduction of that vector sums them
+  typedef decltype(left[0]->View(AcceleratorRead)) View;
+  typedef decltype(TensorRemove(innerProductD(vobj(),vobj()))) inner_t;
+  const int Nfuse = 8;
+  typedef iVector<inner_t,Nfuse> fused_t;
+
+  const uint64_t sites = grid->oSites();
+  Vector<fused_t> inner_tmp(sites);
+  auto inner_tmp_v = &inner_tmp[0];
+  for(int i0=0;i0<n;i0+=Nfuse){
+    int nf = std::min(Nfuse,n-i0);
+    Vector<View> left_v;  left_v.reserve(nf);
+    Vector<View> right_v; right_v.reserve(nf);
+    for(int i=0;i<nf;i++){
+      left_v.push_back(left[i0+i]->View(AcceleratorRead));
+      right_v.push_back(right[i0+i]->View(AcceleratorRead));
+    }
+    auto lv = &left_v[0];
+    auto rv = &right_v[0];
+    accelerator_for( ss, sites, 1,{
+      fused_t tmp = Zero();
+      for(int i=0;i<nf;i++) tmp._internal[i] = TensorRemove(innerProductD(lv[i][ss],rv[i][ss]));
+      inner_tmp_v[ss] = tmp;
+    });
+    auto fsum = sumD(inner_tmp_v,sites);
+    for(int i=0;i<nf;i++) ip[i0+i] = TensorRemove(fsum._internal[i]);
+    for(int i=0;i<nf;i++){
+      left_v[i].ViewClose();
+      right_v[i].ViewClose();
+    }
+  }
+#endif
+}
+
+template<class vobj>
+inline void innerProductMulti(std::vector<ComplexD> &ip,
+			      const std::vector<const Lattice<vobj> *> &left,
+			      const std::vector<const Lattice<vobj> *> &right)
+{
+  rankInnerProductMulti(ip,left,right);
+  if ( ip.size() ) left[0]->Grid()->GlobalSumVector(&ip[0],ip.size());
+}
+// innerProductMulti(ip,{&a,&b},{&c,&b}) gives <a|c> and |b|^2
+template<class vobj>
+inline void innerProductMulti(std::vector<ComplexD> &ip,
+			      std::initializer_list<const Lattice<vobj> *> left,
+			      std::initializer_list<const Lattice<vobj> *> right)
+{
+  innerProductMulti(ip,std::vector<const Lattice<vobj> *>(left),std::vector<const Lattice<vobj> *>(right));
+}
+
 // Double inner product
 template<class vobj>
 inline ComplexD rankInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &right)
 {
+#if ( (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP)) )
+  std::vector<ComplexD> ip;
+  rankInnerProductMulti(ip,std::vector<const Lattice<vobj> *>({&left}),std::vector<const Lattice<vobj> *>({&right}));
+  return ip[0];
+#else
   typedef typename vobj::scalar_type scalar_type;
   typedef typename vobj::vector_typeD vector_type;
   ComplexD  nrm;
@@ -175,6 +293,7 @@ inline ComplexD rankInnerProduct(const Lattice<vobj> &left,const Lattice<vobj> &
   auto anrm = sum(inner_tmp_v,sites);  
   nrm = anrm;
   return nrm;
+#endif
 }
 
 template<class vobj>
@@ -198,7 +317,7 @@ axpy_norm_fast(Lattice<vobj> &z,sobj a,const Lattice<vobj> &x,const Lattice<vobj
   return axpby_norm_fast(z,a,one,x,y);
 }
 
-template<class sobj,class vobj> strong_inline RealD 
+template<class sobj,class vobj> inline simd_dispatch RealD 
 axpby_norm_fast(Lattice<vobj> &z,sobj a,sobj b,const Lattice<vobj> &x,const Lattice<vobj> &y) 
 {
   z.Checkerboard() = x.Checkerboard();
@@ -238,6 +357,12 @@ innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Latti
 {
   conformable(left,right);
 
+#if ( (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP)) )
+  std::vector<ComplexD> tmp;
+  innerProductMulti(tmp,{&left,&left},{&right,&left});
+  ip  = tmp[0];
+  nrm = real(tmp[1]);
+#else
   typedef typename vobj::scalar_type scalar_type;
   typedef typename vobj::vector_typeD vector_type;
   Vector<ComplexD> tmp(2);
@@ -270,6 +395,7 @@ innerProductNorm(ComplexD& ip, RealD &nrm, const Lattice<vobj> &left,const Latti
   grid->GlobalSumVector(&tmp[0],2); // keep norm Complex -> can use GlobalSumVector
   ip = tmp[0];
   nrm = real(tmp[1]);
+#endif
 }
 
 template<class Op,class T1>
@@ -301,15 +427,20 @@ inline auto sum(const LatticeTrinaryExpression<Op,T1,T2,T3> & expr)
 // sliceSum, sliceInnerProduct, sliceAxpy, sliceNorm etc...
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Slice reduction engine shared by sliceSum / sliceInnerProductVector / sliceNorm.
+// All threads stream over all outer sites, each into private accumulators for the
+// nvec x rd reduced planes; these are combined in thread order (reproducible) and
+// the SIMD lanes of every plane are split into local slices in one threaded sweep.
+// The nvec x fd global slices then go through a single GlobalSumVector.
+// op(ss,k,acc) adds the contribution of outer site ss to vector k's accumulator.
+// result[k*fd+t] is slice t of vector k.
+//////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<class vobj,class Op>
+inline void sliceReduce(GridBase *grid,int orthogdim,int nvec,Op op,std::vector<typename vobj::scalar_object> &result)
 {
-  ///////////////////////////////////////////////////////
-  // FIXME precision promoted summation
-  // may be important for correlation functions
-  // But easily avoided by using double precision fields
-  ///////////////////////////////////////////////////////
   typedef typename vobj::scalar_object sobj;
-  GridBase  *grid = Data.Grid();
+  typedef typename vobj::scalar_type   scalar_type;
   assert(grid!=NULL);
 
   const int    Nd = grid->_ndimension;
@@ -321,65 +452,129 @@ template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<
   int fd=grid->_fdimensions[orthogdim];
   int ld=grid->_ldimensions[orthogdim];
   int rd=grid->_rdimensions[orthogdim];
+  int ostride=grid->_ostride[orthogdim];
+  int planes=nvec*rd;
 
-  Vector<vobj> lvSum(rd); // will locally sum vectors first
-  Vector<sobj> lsSum(ld,Zero());                    // sum across these down to scalars
-  ExtractBuffer<sobj> extracted(Nsimd);                  // splitting the SIMD
-
-  result.resize(fd); // And then global sum to return the same vector to every node 
-  for(int r=0;r<rd;r++){
-    lvSum[r]=Zero();
-  }
-
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
+  result.resize(nvec*fd);
+  for(auto &r : result) r=Zero();
+  if ( nvec==0 ) return;
 
-  // sum over reduced dimension planes, breaking out orthog dir
-  // Parallel over orthog direction
-  autoView( Data_v, Data, CpuRead);
-  thread_for( r,rd, {
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-	int ss= so+n*stride+b;
-	lvSum[r]=lvSum[r]+Data_v[ss];
-      }
+  // Thread private plane sums over all outer sites
+  const int nthread = GridThread::GetThreads();
+  const uint64_t sites = grid->oSites();
+  Vector<vobj> lvSum(nthread*planes);
+  thread_for(thr,nthread,{
+    int nwork, mywork, myoff;
+    nwork = sites;
+    GridThread::GetWork(nwork,thr,mywork,myoff);
+    vobj *acc = &lvSum[thr*planes];
+    for(int p=0;p<planes;p++) acc[p]=Zero();
+    for(int ss=myoff;ss<mywork+myoff;ss++){
+      int r=(ss/ostride)%rd;
+      for(int k=0;k<nvec;k++) op(ss,k,acc[k*rd+r]);
     }
   });
 
-  // Sum across simd lanes in the plane, breaking out orthog dir.
+  // Local slice of each SIMD lane relative to its plane
   Coordinate icoor(Nd);
+  std::vector<int> lane(Nsimd);
+  for(int idx=0;idx<Nsimd;idx++){
+    grid->iCoorFromIindex(icoor,idx);
+    lane[idx]=icoor[orthogdim]*rd;
+  }
 
-  for(int rt=0;rt<rd;rt++){
-
-    extract(lvSum[rt],extracted);
-
+  // Combine threads and split lanes; each plane owns distinct local slices
+  Vector<sobj> lsSum(nvec*ld,Zero());
+  thread_for(p,planes,{
+    ExtractBuffer<sobj> extracted(Nsimd);
+    vobj v=lvSum[p];
+    for(int t=1;t<nthread;t++) v=v+lvSum[t*planes+p];
+    extract(v,extracted);
+    int k=p/rd;
+    int r=p%rd;
     for(int idx=0;idx<Nsimd;idx++){
+      int ldx=k*ld+r+lane[idx];
+      lsSum[ldx]=lsSum[ldx]+extracted[idx];
+    }
+  });
 
-      grid->iCoorFromIindex(icoor,idx);
+  // Place the local slices and sum over nodes in one go
+  int pt0=grid->_processor_coor[orthogdim]*ld;
+  for(int k=0;k<nvec;k++){
+    for(int lt=0;lt<ld;lt++){
+      result[k*fd+pt0+lt]=lsSum[k*ld+lt];
+    }
+  }
+  grid->GlobalSumVector((scalar_type *)&result[0],nvec*fd*(sizeof(sobj)/sizeof(scalar_type)));
+}
 
-      int ldx =rt+icoor[orthogdim]*rd;
+template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,std::vector<typename vobj::scalar_object> &result,int orthogdim)
+{
+  ///////////////////////////////////////////////////////
+  // FIXME precision promoted summation
+  // may be important for correlation functions
+  // But easily avoided by using double precision fields
+  ///////////////////////////////////////////////////////
+  autoView( Data_v, Data, CpuRead);
+  sliceReduce<vobj>(Data.Grid(),orthogdim,1,[&](int ss,int k,vobj &acc){
+    acc=acc+Data_v[ss];
+  },result);
+}
 
-      lsSum[ldx]=lsSum[ldx]+extracted[idx];
+// Several fields in one pass; result[k][t] is slice t of Data[k]
+template<class vobj> inline void sliceSum(const std::vector<Lattice<vobj> > &Data,
+					  std::vector<std::vector<typename vobj::scalar_object> > &result,int orthogdim)
+{
+  typedef typename vobj::scalar_object sobj;
+  typedef decltype(Data[0].View(CpuRead)) View;
+  int nvec=Data.size();
+  result.resize(nvec);
+  if ( nvec==0 ) return;
+  GridBase *grid=Data[0].Grid();
+  int fd=grid->_fdimensions[orthogdim];
 
-    }
+  Vector<View> Data_v; Data_v.reserve(nvec);
+  for(int k=0;k<nvec;k++){
+    conformable(grid,Data[k].Grid());
+    Data_v.push_back(Data[k].View(CpuRead));
   }
-  
-  // sum over nodes.
-  sobj gsum;
-  for(int t=0;t<fd;t++){
-    int pt = t/ld; // processor plane
-    int lt = t%ld;
-    if ( pt == grid->_processor_coor[orthogdim] ) {
-      gsum=lsSum[lt];
-    } else {
-      gsum=Zero();
-    }
+  std::vector<sobj> flat;
+  sliceReduce<vobj>(grid,orthogdim,nvec,[&](int ss,int k,vobj &acc){
+    acc=acc+Data_v[k][ss];
+  },flat);
+  for(int k=0;k<nvec;k++){
+    Data_v[k].ViewClose();
+    result[k].assign(flat.begin()+k*fd,flat.begin()+(k+1)*fd);
+  }
+}
 
-    grid->GlobalSum(gsum);
+// Several momentum (or other site weight) projections of one field in one pass:
+// result[k][t] is the sum over slice t of phase[k](x)*Data(x)
+template<class vobj> inline void sliceSum(const Lattice<vobj> &Data,
+					  const std::vector<Lattice<typename vobj::tensor_reduced> > &phase,
+					  std::vector<std::vector<typename vobj::scalar_object> > &result,int orthogdim)
+{
+  typedef typename vobj::scalar_object sobj;
+  typedef decltype(phase[0].View(CpuRead)) View;
+  int nvec=phase.size();
+  result.resize(nvec);
+  if ( nvec==0 ) return;
+  GridBase *grid=Data.Grid();
+  int fd=grid->_fdimensions[orthogdim];
 
-    result[t]=gsum;
+  Vector<View> phase_v; phase_v.reserve(nvec);
+  for(int k=0;k<nvec;k++){
+    conformable(grid,phase[k].Grid());
+    phase_v.push_back(phase[k].View(CpuRead));
+  }
+  autoView( Data_v, Data, CpuRead);
+  std::vector<sobj> flat;
+  sliceReduce<vobj>(grid,orthogdim,nvec,[&](int ss,int k,vobj &acc){
+    acc=acc+phase_v[k][ss]*Data_v[ss];
+  },flat);
+  for(int k=0;k<nvec;k++){
+    phase_v[k].ViewClose();
+    result[k].assign(flat.begin()+k*fd,flat.begin()+(k+1)*fd);
   }
 }
 
@@ -387,83 +582,19 @@ template<class vobj>
 static void sliceInnerProductVector( std::vector<ComplexD> & result, const Lattice<vobj> &lhs,const Lattice<vobj> &rhs,int orthogdim) 
 {
   typedef typename vobj::vector_type   vector_type;
-  typedef typename vobj::scalar_type   scalar_type;
+  typedef iScalar<vector_type>         inner_t;
   GridBase  *grid = lhs.Grid();
-  assert(grid!=NULL);
   conformable(grid,rhs.Grid());
 
-  const int    Nd = grid->_ndimension;
-  const int Nsimd = grid->Nsimd();
-
-  assert(orthogdim >= 0);
-  assert(orthogdim < Nd);
-
-  int fd=grid->_fdimensions[orthogdim];
-  int ld=grid->_ldimensions[orthogdim];
-  int rd=grid->_rdimensions[orthogdim];
-
-  Vector<vector_type> lvSum(rd); // will locally sum vectors first
-  Vector<scalar_type > lsSum(ld,scalar_type(0.0));                    // sum across these down to scalars
-  ExtractBuffer<iScalar<scalar_type> > extracted(Nsimd);   // splitting the SIMD  
-
-  result.resize(fd); // And then global sum to return the same vector to every node for IO to file
-  for(int r=0;r<rd;r++){
-    lvSum[r]=Zero();
-  }
-
-  int e1=    grid->_slice_nblock[orthogdim];
-  int e2=    grid->_slice_block [orthogdim];
-  int stride=grid->_slice_stride[orthogdim];
-
   autoView( lhv, lhs, CpuRead);
   autoView( rhv, rhs, CpuRead);
-  thread_for( r,rd,{
-
-    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
-
-    for(int n=0;n<e1;n++){
-      for(int b=0;b<e2;b++){
-	int ss= so+n*stride+b;
-	vector_type vv = TensorRemove(innerProduct(lhv[ss],rhv[ss]));
-	lvSum[r]=lvSum[r]+vv;
-      }
-    }
-  });
-
-  // Sum across simd lanes in the plane, breaking out orthog dir.
-  Coordinate icoor(Nd);
-  for(int rt=0;rt<rd;rt++){
-
-    iScalar<vector_type> temp; 
-    temp._internal = lvSum[rt];
-    extract(temp,extracted);
-
-    for(int idx=0;idx<Nsimd;idx++){
-
-      grid->iCoorFromIindex(icoor,idx);
-
-      int ldx =rt+icoor[orthogdim]*rd;
-
-      lsSum[ldx]=lsSum[ldx]+extracted[idx]._internal;
-
-    }
-  }
-  
-  // sum over nodes.
-  scalar_type gsum;
-  for(int t=0;t<fd;t++){
-    int pt = t/ld; // processor plane
-    int lt = t%ld;
-    if ( pt == grid->_processor_coor[orthogdim] ) {
-      gsum=lsSum[lt];
-    } else {
-      gsum=scalar_type(0.0);
-    }
-
-    grid->GlobalSum(gsum);
+  std::vector<typename inner_t::scalar_object> ip;
+  sliceReduce<inner_t>(grid,orthogdim,1,[&](int ss,int k,inner_t &acc){
+    acc._internal=acc._internal+TensorRemove(innerProduct(lhv[ss],rhv[ss]));
+  },ip);
 
-    result[t]=gsum;
-  }
+  result.resize(ip.size());
+  for(int t=0;t<ip.size();t++) result[t]=ip[t]._internal;
 }
 template<class vobj>
 static void sliceNorm (std::vector<RealD> &sn,const Lattice<vobj> &rhs,int Orthog) 
@@ -533,6 +664,60 @@ static void sliceMaddVector(Lattice<vobj> &R,std::vector<RealD> &a,const Lattice
   }
 };
 
+// R = a[slice] X + b[slice] Y
+template<class vobj>
+static void sliceAxpbyVector(Lattice<vobj> &R,std::vector<RealD> &a,std::vector<RealD> &b,
+			     const Lattice<vobj> &X,const Lattice<vobj> &Y,int orthogdim)
+{    
+  typedef typename vobj::scalar_type scalar_type;
+  typedef typename vobj::vector_type vector_type;
+  typedef typename vobj::tensor_reduced tensor_reduced;
+  
+  GridBase *grid  = X.Grid();
+
+  int Nsimd  =grid->Nsimd();
+
+  int ld     =grid->_ldimensions[orthogdim];
+  int rd     =grid->_rdimensions[orthogdim];
+  int lo     =grid->_processor_coor[orthogdim]*ld; // global offset of the local slices
+
+  int e1     =grid->_slice_nblock[orthogdim];
+  int e2     =grid->_slice_block [orthogdim];
+  int stride =grid->_slice_stride[orthogdim];
+
+  R.Checkerboard() = X.Checkerboard();
+
+  autoView( Rv, R, CpuWrite);
+  autoView( Xv, X, CpuRead);
+  autoView( Yv, Y, CpuRead);
+
+  Coordinate icoor;
+  for(int r=0;r<rd;r++){
+
+    int so=r*grid->_ostride[orthogdim]; // base offset for start of plane 
+
+    vector_type    av;
+    vector_type    bv;
+
+    for(int l=0;l<Nsimd;l++){
+      grid->iCoorFromIindex(icoor,l);
+      int ldx =lo+r+icoor[orthogdim]*rd;
+      scalar_type *as =(scalar_type *)&av;
+      scalar_type *bs =(scalar_type *)&bv;
+      as[l] = scalar_type(a[ldx]);
+      bs[l] = scalar_type(b[ldx]);
+    }
+
+    tensor_reduced at; at=av;
+    tensor_reduced bt; bt=bv;
+
+    thread_for2d( n, e1, bb,e2, {
+	int ss= so+n*stride+bb;
+	Rv[ss] = at*Xv[ss]+bt*Yv[ss];
+    });
+  }
+};
+
 /*
 inline GridBase         *makeSubSliceGrid(const GridBase *BlockSolverGrid,int Orthog)
 {
@@ -31,9 +31,7 @@
 
 #include <random>
 
-#ifdef RNG_SITMO
 #include <Grid/sitmo_rng/sitmo_prng_engine.hpp>
-#endif 
 
 #if defined(RNG_SITMO)
 #define RNG_FAST_DISCARD
@@ -340,10 +338,28 @@ public:
 };
 
 class GridParallelRNG : public GridRNGbase {
+public:
+  //////////////////////////////////////////////////////////////////////////
+  // Optional counter based mode. Every draw comes from a sitmo (Threefry)
+  // block keyed on the seed and counted by (global site, fill epoch,
+  // multiplicity index); no per site engine state is used. Seeding is O(1),
+  // the streams depend only on global coordinates and so are the same on any
+  // decomposition, and the whole parallel state is the key and the epoch.
+  // Selected by SeedCounterBased, or by --rng-counter-based for every
+  // parallel RNG seeded with SeedFixedIntegers / SeedUniqueString.
+  //////////////////////////////////////////////////////////////////////////
+  typedef sitmo::prng_engine CounterEngine;
+  static const int      CounterStateCount = 6;  // magic, key[4], epoch
+  static const uint64_t CounterStateMagic = 0x47524944434e5452ULL; // "GRIDCNTR"
+  static bool &CounterBasedDefault(void) { static bool cb=false; return cb; }
+
 private:
   double _time_counter;
   GridBase *_grid;
   unsigned int _vol;
+  bool     _counter_based;
+  uint64_t _key[4];
+  uint64_t _epoch;
 
 public:
   GridBase *Grid(void) const { return _grid; }
@@ -354,6 +370,9 @@ public:
   GridParallelRNG(GridBase *grid) : GridRNGbase() {
     _grid = grid;
     _vol  =_grid->iSites()*_grid->oSites();
+    _counter_based = CounterBasedDefault();
+    _epoch = 0;
+    for(int i=0;i<4;i++) _key[i]=0;
 
     _generators.resize(_vol);
     _uniform.resize(_vol,std::uniform_real_distribution<RealD>{0,1});
@@ -368,6 +387,11 @@ public:
     typedef typename vobj::scalar_type scalar_type;
     typedef typename vobj::vector_type vector_type;
 
+    if ( _counter_based ) {
+      fillCounterBased(l,dist);
+      return;
+    }
+
     double inner_time_counter = usecond();
 
     int multiplicity = RNGfillable_general(_grid, l.Grid()); // l has finer or same grid
@@ -399,6 +423,79 @@ public:
     _time_counter += usecond()- inner_time_counter;
   }
 
+  template <class vobj,class distribution> inline void fillCounterBased(Lattice<vobj> &l,std::vector<distribution> &dist){
+
+    typedef typename vobj::scalar_object scalar_object;
+    typedef typename vobj::scalar_type scalar_type;
+
+    double inner_time_counter = usecond();
+
+    int multiplicity = RNGfillable_general(_grid, l.Grid());
+    int Nsimd  = _grid->Nsimd();
+    int osites = _grid->oSites();
+    int nd     = _grid->_ndimension;
+    int words  = sizeof(scalar_object) / sizeof(scalar_type);
+    Coordinate gdims  = _grid->FullDimensions();
+    Coordinate lstart = _grid->LocalStarts();
+    Coordinate rdims  = _grid->_rdimensions;
+    uint64_t epoch = _epoch++;
+
+    autoView(l_v, l, CpuWrite);
+    thread_region
+    {
+      CounterEngine eng;
+      eng.set_key(_key[0],_key[1],_key[2],_key[3]);
+      distribution d = dist[0];
+      ExtractBuffer<scalar_object> buf(Nsimd);
+      Coordinate ocoor(nd), icoor(nd);
+      thread_for_in_region( ss, osites, {
+	_grid->oCoorFromOindex(ocoor,ss);
+	for (int m = 0; m < multiplicity; m++) {
+	  int sm = multiplicity * ss + m;
+	  for (int si = 0; si < Nsimd; si++) {
+	    _grid->iCoorFromIindex(icoor,si);
+	    uint64_t gsite = 0;
+	    for(int mu=nd-1;mu>=0;mu--) gsite = gsite*gdims[mu] + lstart[mu] + ocoor[mu] + rdims[mu]*icoor[mu];
+	    eng.set_counter(0,gsite,epoch,m);
+	    d.reset();
+	    scalar_type *pointer = (scalar_type *)&buf[si];
+	    for (int idx = 0; idx < words; idx++)
+	      fillScalar(pointer[idx], d, eng);
+	  }
+	  merge(l_v[sm], buf);
+	}
+      });
+    }
+
+    _time_counter += usecond()- inner_time_counter;
+  }
+
+  bool CounterBased(void) const { return _counter_based; }
+
+  void SeedCounterBased(const std::vector<int> &seeds){
+    CartesianCommunicator::BroadcastWorld(0,(void *)&seeds[0],sizeof(int)*seeds.size());
+    std::seed_seq source(seeds.begin(),seeds.end());
+    uint32_t w[8];
+    source.generate(&w[0],&w[8]);
+    for(int i=0;i<4;i++) _key[i] = (static_cast<uint64_t>(w[2*i]) << 32) | w[2*i+1];
+    _epoch = 0;
+    _counter_based = true;
+  }
+  void GetCounterState(std::vector<uint64_t> &state){
+    assert(_counter_based);
+    state.resize(CounterStateCount);
+    state[0] = CounterStateMagic;
+    for(int i=0;i<4;i++) state[1+i] = _key[i];
+    state[5] = _epoch;
+  }
+  void SetCounterState(const std::vector<uint64_t> &state){
+    assert(state.size()==CounterStateCount);
+    assert(state[0]==CounterStateMagic);
+    for(int i=0;i<4;i++) _key[i] = state[1+i];
+    _epoch = state[5];
+    _counter_based = true;
+  }
+
     void SeedUniqueString(const std::string &s){
       std::vector<int> seeds;
       seeds = GridChecksum::sha256_seeds(s);
@@ -409,6 +506,11 @@ public:
     }
   void SeedFixedIntegers(const std::vector<int> &seeds){
 
+    if ( _counter_based ) {
+      SeedCounterBased(seeds);
+      return;
+    }
+
     // Everyone generates the same seed_seq based on input seeds
     CartesianCommunicator::BroadcastWorld(0,(void *)&seeds[0],sizeof(int)*seeds.size());
 
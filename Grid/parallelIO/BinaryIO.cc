@@ -1,4 +1,8 @@
 #include <Grid/GridCore.h>
 
 int                    Grid::BinaryIO::latticeWriteMaxRetry = -1;
+uint64_t               Grid::BinaryIO::latticeChunkBytes    = 0;
+int                    Grid::BinaryIO::ioAggregators        = 0;
+uint64_t               Grid::BinaryIO::ioStripeBytes        = 1024*1024;
+uint64_t               Grid::BinaryIO::ioAggregatorBufferBytes = 64*1024*1024;
 Grid::BinaryIO::IoPerf Grid::BinaryIO::lastPerf;
@@ -40,6 +40,9 @@
 
 #include <arpa/inet.h>
 #include <algorithm>
+#include <fcntl.h>
+#include <unistd.h>
+#include <future>
 
 NAMESPACE_BEGIN(Grid);
 
@@ -87,6 +90,10 @@ class BinaryIO {
 
   static IoPerf lastPerf;
   static int latticeWriteMaxRetry;
+  static uint64_t latticeChunkBytes;
+  static int ioAggregators;
+  static uint64_t ioStripeBytes;
+  static uint64_t ioAggregatorBufferBytes;
 
   /////////////////////////////////////////////////////////////////////////////
   // more byte manipulation helpers
@@ -108,25 +115,34 @@ class BinaryIO {
   template <class fobj>
   static inline void NerscChecksum(GridBase *grid, std::vector<fobj> &fbuf, uint32_t &nersc_csum)
   {
-    const uint64_t size32 = sizeof(fobj) / sizeof(uint32_t);
-
     uint64_t lsites = grid->lSites();
     if (fbuf.size() == 1)
     {
       lsites = 1;
     }
+    NerscChecksum(&fbuf[0], lsites, nersc_csum);
+  }
+
+  // Accumulate over a contiguous run of nsites objects; used chunk by chunk when streaming.
+  // A plain sum of words, so walk the buffer in flat blocks the compiler can vectorise.
+  template <class fobj>
+  static inline void NerscChecksum(fobj *fbuf, uint64_t nsites, uint32_t &nersc_csum)
+  {
+    const uint64_t words  = nsites * (sizeof(fobj) / sizeof(uint32_t));
+    const uint64_t block  = 4096;
+    const uint64_t blocks = (words + block - 1) / block;
+    const uint32_t *w = (const uint32_t *)fbuf;
 
     thread_region
     {
       uint32_t nersc_csum_thr = 0;
 
-      thread_for_in_region( local_site, lsites, 
+      thread_for_in_region( b, blocks, 
       {
-        uint32_t *site_buf = (uint32_t *)&fbuf[local_site];
-        for (uint64_t j = 0; j < size32; j++)
-        {
-          nersc_csum_thr = nersc_csum_thr + site_buf[j];
-        }
+        uint64_t e = std::min(words, (b + 1) * block);
+        uint32_t s = 0;
+        for (uint64_t j = b * block; j < e; j++) s += w[j];
+        nersc_csum_thr += s;
       });
 
       thread_critical
@@ -138,57 +154,84 @@ class BinaryIO {
 
   template<class fobj> static inline void ScidacChecksum(GridBase *grid,std::vector<fobj> &fbuf,uint32_t &scidac_csuma,uint32_t &scidac_csumb)
   {
-    int nd = grid->_ndimension;
-
     uint64_t lsites              =grid->lSites();
     if (fbuf.size()==1) {
       lsites=1;
     }
+    ScidacChecksum(grid,&fbuf[0],0,lsites,scidac_csuma,scidac_csumb);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Fast whole-object checksum (version 1 of the grid-checksum record):
+  //   sum over global lexicographic sites g of crc32c(site bytes) * (2g+1)  mod 2^64
+  // Order sensitive, independent of the decomposition and additive, so it
+  // can be accumulated chunk by chunk and reduced with a single GlobalSum.
+  // The site crc is always crc32c_update: GridChecksum::crc32c takes a
+  // different, byte swapped, path under USE_IPP and would change the record.
+  /////////////////////////////////////////////////////////////////////////////
+  static inline uint64_t GridSiteChecksum(uint32_t crc,uint64_t global_site)
+  {
+    return (uint64_t)crc * (2*global_site+1);
+  }
+
+  // fbuf[0] holds rank local lexicographic site site0; the site weights use its global index.
+  // Walks the buffer in x-lines so coordinates are worked out once per line rather than per site.
+  // If grid_csum is given the fast crc32c checksum is accumulated in the same pass.
+  template<class fobj> static inline void ScidacChecksum(GridBase *grid,fobj *fbuf,uint64_t site0,uint64_t nsites,
+							  uint32_t &scidac_csuma,uint32_t &scidac_csumb,
+							  uint64_t *grid_csum=nullptr)
+  {
+    int nd = grid->_ndimension;
+
     Coordinate local_vol   =grid->LocalDimensions();
     Coordinate local_start =grid->LocalStarts();
     Coordinate global_vol  =grid->FullDimensions();
 
+    uint64_t nx = local_vol[0];
+    if ( (site0%nx) || (nsites%nx) ) nx = 1;
+    uint64_t nlines = nsites/nx;
+
     thread_region
     { 
       Coordinate coor(nd);
       uint32_t scidac_csuma_thr=0;
       uint32_t scidac_csumb_thr=0;
-      uint32_t site_crc=0;
+      uint64_t grid_csum_thr=0;
 
-      thread_for_in_region( local_site, lsites, 
+      thread_for_in_region( line, nlines, 
       {
-
-	uint32_t * site_buf = (uint32_t *)&fbuf[local_site];
-
-	/* 
-	 * Scidac csum  is rather more heavyweight
-	 * FIXME -- 128^3 x 256 x 16 will overflow.
-	 */
-	
-	int global_site;
+	uint64_t local_site = site0 + line*nx;
 
 	Lexicographic::CoorFromIndex(coor,local_site,local_vol);
-
 	for(int d=0;d<nd;d++) {
 	  coor[d] = coor[d]+local_start[d];
 	}
-
-	Lexicographic::IndexFromCoor(coor,global_site,global_vol);
+	uint64_t global_site=0;
+	for(int d=nd-1;d>=0;d--) global_site = global_site*global_vol[d] + coor[d];
 
 	uint32_t gsite29   = global_site%29;
 	uint32_t gsite31   = global_site%31;
-	
-	site_crc = crc32(0,(unsigned char *)site_buf,sizeof(fobj));
-	//	std::cout << "Site "<<local_site << " crc "<<std::hex<<site_crc<<std::dec<<std::endl;
-	//	std::cout << "Site "<<local_site << std::hex<<site_buf[0] <<site_buf[1]<<std::dec <<std::endl;
-	scidac_csuma_thr ^= site_crc<<gsite29 | site_crc>>(32-gsite29);
-	scidac_csumb_thr ^= site_crc<<gsite31 | site_crc>>(32-gsite31);
+
+	for(uint64_t x=0;x<nx;x++){
+	  unsigned char *site_buf = (unsigned char *)&fbuf[line*nx+x];
+
+	  uint32_t site_crc = crc32(0,site_buf,sizeof(fobj));
+	  scidac_csuma_thr ^= site_crc<<gsite29 | site_crc>>(32-gsite29);
+	  scidac_csumb_thr ^= site_crc<<gsite31 | site_crc>>(32-gsite31);
+
+	  if ( grid_csum ) {
+	    grid_csum_thr += GridSiteChecksum(GridChecksum::crc32c_update(0,site_buf,sizeof(fobj)),global_site+x);
+	  }
+	  if ( ++gsite29 == 29 ) gsite29 = 0;
+	  if ( ++gsite31 == 31 ) gsite31 = 0;
+	}
       });
 
       thread_critical
       {
 	scidac_csuma^= scidac_csuma_thr;
 	scidac_csumb^= scidac_csumb_thr;
+	if ( grid_csum ) *grid_csum += grid_csum_thr;
       }
     }
   }
@@ -358,7 +401,16 @@ class BinaryIO {
 
       timer.Start();
 
-      if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) ) {
+      if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) && ioAggregators ) {
+	std::cout<< GridLogMessage<<"IOobject: aggregated read I/O "<< file<< " with "<<IOaggregatorCount(grid)<<" aggregators"<<std::endl;
+	int fd = IOaggregatorOpen(grid,file,offset,control);
+	if ( !IOaggregate(grid,fd,(char *)&iodata[0],0,lsites,sizeof(fobj),offset,control) ) IOabort("Read failed on",file);
+	if ( fd >= 0 ) ::close(fd);
+#ifdef USE_MPI_IO
+	MPI_Type_free(&fileArray);
+	MPI_Type_free(&localArray);
+#endif
+      } else if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) ) {
 #ifdef USE_MPI_IO
 	std::cout<< GridLogMessage<<"IOobject: MPI read I/O "<< file<< std::endl;
 	ierr=MPI_File_open(grid->communicator,(char *) file.c_str(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh);    assert(ierr==0);
@@ -415,7 +467,20 @@ class BinaryIO {
       grid->Barrier();
 
       timer.Start();
-      if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) ) {
+      if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) && ioAggregators ) {
+        std::cout << GridLogMessage <<"IOobject: aggregated write I/O " << file << " with "<<IOaggregatorCount(grid)<<" aggregators"<<std::endl;
+	int fd = IOaggregatorOpen(grid,file,offset,control);
+	if ( !IOaggregate(grid,fd,(char *)&iodata[0],0,lsites,sizeof(fobj),offset,control) ) IOabort("Write failed on",file);
+	if ( fd >= 0 ) {
+	  if ( ::fsync(fd) != 0 ) IOabort("fsync failed on",file);
+	  ::close(fd);
+	}
+	offset = offset + sizeof(fobj)*grid->gSites();
+#ifdef USE_MPI_IO
+	MPI_Type_free(&fileArray);
+	MPI_Type_free(&localArray);
+#endif
+      } else if ( (control & BINARYIO_LEXICOGRAPHIC) && (nrank > 1) ) {
 #ifdef USE_MPI_IO
         std::cout << GridLogMessage <<"IOobject: MPI write I/O " << file << std::endl;
         ierr = MPI_File_open(grid->communicator, (char *)file.c_str(), MPI_MODE_RDWR | MPI_MODE_CREATE, MPI_INFO_NULL, &fh);
@@ -534,6 +599,564 @@ class BinaryIO {
     }
   }
 
+  /////////////////////////////////////////////////////////////////////////////
+  // Rank local lexicographic I/O. Each rank transfers its own sub-volume as runs
+  // of x-lines (coalesced where contiguous in the file) with positioned POSIX
+  // I/O. No communicator is touched and no checksums or byte swaps are done, so
+  // this may run on a helper thread. Returns false on an I/O error.
+  /////////////////////////////////////////////////////////////////////////////
+  static inline bool IOtransfer(int fd,char *buf,uint64_t bytes,uint64_t offset,int control)
+  {
+    while ( bytes ) {
+      ssize_t n;
+      if ( control & BINARYIO_WRITE ) n = ::pwrite(fd,buf,bytes,offset);
+      else                            n = ::pread (fd,buf,bytes,offset);
+      if ( n <= 0 ) return false;
+      buf   +=n;
+      bytes -=n;
+      offset+=n;
+    }
+    return true;
+  }
+
+  // Transfer rank local lexicographic sites [site0,site0+nsites) of bytes_per_site each
+  // between buf and their global lexicographic place in the file.
+  static inline bool IOtransferSites(int fd,GridBase *grid,char *buf,
+				     uint64_t site0,uint64_t nsites,uint64_t bytes_per_site,
+				     uint64_t offset,int control)
+  {
+    int ndim            = grid->Dimensions();
+    Coordinate gLattice = grid->GlobalDimensions();
+    Coordinate lLattice = grid->LocalDimensions();
+    Coordinate lStart   = grid->LocalStarts();
+
+    uint64_t nx = lLattice[0];
+    if ( (site0%nx) || (nsites%nx) ) nx = 1;
+    uint64_t bytes = nx*bytes_per_site;
+    uint64_t run_site=0, run_bytes=0, run_offset=0;
+    Coordinate lcoor(ndim);
+    bool ok = true;
+    for(uint64_t l=site0;ok && l<site0+nsites;l+=nx){
+      Lexicographic::CoorFromIndex(lcoor,l,lLattice);
+      uint64_t gidx=0;
+      for(int d=ndim-1;d>=0;d--) gidx = gidx*gLattice[d] + lcoor[d] + lStart[d];
+      uint64_t off = offset + gidx*bytes_per_site;
+      if ( run_bytes && (off == run_offset+run_bytes) ) {
+	run_bytes += bytes;
+	continue;
+      }
+      if ( run_bytes ) ok = IOtransfer(fd,buf+(run_site-site0)*bytes_per_site,run_bytes,run_offset,control);
+      run_site   = l;
+      run_offset = off;
+      run_bytes  = bytes;
+    }
+    if ( ok && run_bytes ) ok = IOtransfer(fd,buf+(run_site-site0)*bytes_per_site,run_bytes,run_offset,control);
+    return ok;
+  }
+
+  template<class fobj>
+  static inline bool IOobjectLocal(GridBase *grid,
+				   std::vector<fobj> &iodata,
+				   const std::string &file,
+				   uint64_t offset,
+				   int control)
+  {
+    uint64_t lsites     = grid->lSites();
+    assert(iodata.size()==lsites);
+
+    int flags = (control & BINARYIO_WRITE) ? (O_WRONLY|O_CREAT) : O_RDONLY;
+    int fd = ::open(file.c_str(),flags,0644);
+    if ( fd < 0 ) return false;
+
+    bool ok = IOtransferSites(fd,grid,(char *)&iodata[0],0,lsites,sizeof(fobj),offset,control);
+    if ( ::close(fd) != 0 ) ok = false;
+    return ok;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Aggregated I/O. ioAggregators ranks, spread evenly through the rank list,
+  // each own a contiguous byte range of the object in the file, with interior
+  // boundaries rounded down to multiples of ioStripeBytes. Every rank ships
+  // its pieces of a range to the owner over MPI and only owners touch the
+  // file, issuing one transfer per contiguous run. Both ends derive the piece
+  // lists from the grid geometry so only payload goes over the wire.
+  // Ranges are moved in rounds of at most ioAggregatorBufferBytes (rounded
+  // to whole stripes, 0 means one round), which bounds the buffers of both
+  // aggregators and senders.
+  // ioAggregators==0 leaves multi-rank I/O to MPI-IO.
+  /////////////////////////////////////////////////////////////////////////////
+  struct IOsegment {
+    uint64_t buf;   // byte offset in the rank's buffer
+    uint64_t file;  // absolute byte offset in the file
+    uint64_t bytes;
+  };
+
+  static inline int IOaggregatorCount(GridBase *grid)
+  {
+    return std::max(1,std::min(ioAggregators,grid->ProcessorCount()));
+  }
+  static inline int IOaggregatorRank(GridBase *grid,int a)
+  {
+    return (int)(((uint64_t)a*grid->ProcessorCount())/IOaggregatorCount(grid));
+  }
+  static inline uint64_t IOaggregatorBound(GridBase *grid,uint64_t offset,uint64_t bytes_per_site,int a)
+  {
+    int      n     = IOaggregatorCount(grid);
+    uint64_t total = grid->gSites()*bytes_per_site;
+    if ( a==0 ) return offset;
+    if ( a==n ) return offset+total;
+    uint64_t b = offset + (total/n)*a;
+    if ( ioStripeBytes ) b = std::max(offset,(b/ioStripeBytes)*ioStripeBytes);
+    return b;
+  }
+  static inline uint64_t IOaggregatorRound(void)
+  {
+    uint64_t r = ioAggregatorBufferBytes;
+    if ( r && ioStripeBytes ) r = std::max(ioStripeBytes,(r/ioStripeBytes)*ioStripeBytes);
+    return r;
+  }
+
+  // Pieces of rank's local sites [site0,site0+nsites) falling in file bytes [lo,hi), in local site order
+  static inline void IOsegments(GridBase *grid,int rank,uint64_t site0,uint64_t nsites,uint64_t bytes_per_site,
+				uint64_t offset,uint64_t lo,uint64_t hi,std::vector<IOsegment> &seg)
+  {
+    int ndim            = grid->Dimensions();
+    Coordinate gLattice = grid->GlobalDimensions();
+    Coordinate lLattice = grid->LocalDimensions();
+    Coordinate pcoor;
+    grid->ProcessorCoorFromRank(rank,pcoor);
+
+    seg.resize(0);
+    uint64_t nx = lLattice[0];
+    if ( (site0%nx) || (nsites%nx) ) nx = 1;
+    uint64_t bytes = nx*bytes_per_site;
+    Coordinate lcoor(ndim);
+    auto fileOffset = [&](uint64_t l) {
+      Lexicographic::CoorFromIndex(lcoor,l,lLattice);
+      uint64_t gidx=0;
+      for(int d=ndim-1;d>=0;d--) gidx = gidx*gLattice[d] + lcoor[d] + pcoor[d]*lLattice[d];
+      return offset + gidx*bytes_per_site;
+    };
+    // File offsets grow with the local site index; start at the first run ending past lo
+    uint64_t nrun = nsites/nx;
+    uint64_t first=0, last=nrun;
+    while ( first < last ) {
+      uint64_t mid = (first+last)/2;
+      if ( fileOffset(site0+mid*nx)+bytes <= lo ) first = mid+1;
+      else                                        last  = mid;
+    }
+    for(uint64_t l=site0+first*nx;l<site0+nsites;l+=nx){
+      uint64_t off = fileOffset(l);
+      if ( off >= hi ) break;
+      uint64_t b   = std::max(off,lo);
+      uint64_t e   = std::min(off+bytes,hi);
+      if ( b >= e ) continue;
+      uint64_t pos = (l-site0)*bytes_per_site + (b-off);
+      if ( seg.size() && (seg.back().file+seg.back().bytes==b) && (seg.back().buf+seg.back().bytes==pos) ) {
+	seg.back().bytes += e-b;
+      } else {
+	seg.push_back({pos,b,e-b});
+      }
+    }
+  }
+
+  // Only aggregators get a descriptor; truncation follows the fstream path in IOobject
+  static inline int IOaggregatorOpen(GridBase *grid,const std::string &file,uint64_t offset,int control)
+  {
+    bool writing = (control & BINARYIO_WRITE);
+    if ( writing && (offset==0) && grid->IsBoss() ) {
+      int tfd = ::open(file.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+      if ( tfd < 0 ) IOabort("Error in opening the file for output",file);
+      ::close(tfd);
+    }
+    grid->Barrier();
+    int fd = -1;
+    for(int a=0;a<IOaggregatorCount(grid);a++){
+      if ( IOaggregatorRank(grid,a) == grid->ThisRank() ) {
+	fd = ::open(file.c_str(),writing ? (O_WRONLY|O_CREAT) : O_RDONLY,0644);
+	if ( fd < 0 ) IOabort(writing ? "Error in opening the file for output" : "Error in opening the file for input",file);
+      }
+    }
+    return fd;
+  }
+
+  // Collective over the grid; transfers rank local sites [site0,site0+nsites) held in buf
+  static inline bool IOaggregate(GridBase *grid,int fd,char *buf,uint64_t site0,uint64_t nsites,
+				 uint64_t bytes_per_site,uint64_t offset,int control)
+  {
+#ifdef USE_MPI_IO
+    const int tag = 0x10a9;
+    bool writing  = (control & BINARYIO_WRITE);
+    int  nrank    = grid->ProcessorCount();
+    int  myrank   = grid->ThisRank();
+    int  naggr    = IOaggregatorCount(grid);
+    bool ok       = true;
+
+    //////////////////////////////////////////////
+    // Every rank walks the same rounds; round j of
+    // aggregator a covers [lo+j*R,lo+(j+1)*R)
+    //////////////////////////////////////////////
+    uint64_t R      = IOaggregatorRound();
+    uint64_t rounds = 1;
+    if ( R ) {
+      rounds = 0;
+      for(int a=0;a<naggr;a++){
+	uint64_t span = IOaggregatorBound(grid,offset,bytes_per_site,a+1)-IOaggregatorBound(grid,offset,bytes_per_site,a);
+	rounds = std::max(rounds,(span+R-1)/R);
+      }
+    }
+    auto range = [&](int a,uint64_t j,uint64_t &lo,uint64_t &hi) {
+      lo = IOaggregatorBound(grid,offset,bytes_per_site,a);
+      hi = IOaggregatorBound(grid,offset,bytes_per_site,a+1);
+      if ( R ) {
+	lo = std::min(hi,lo+j*R);
+	hi = std::min(hi,lo+R);
+      }
+    };
+
+    for(uint64_t j=0;j<rounds;j++){
+
+      std::vector<MPI_Request>        reqs;
+      std::vector<std::vector<char> > mine(naggr);
+      std::vector<std::vector<IOsegment> > myseg(naggr);
+
+      //////////////////////////////////////////////
+      // This rank's share of every aggregator range
+      //////////////////////////////////////////////
+      for(int a=0;a<naggr;a++){
+	uint64_t lo,hi;
+	range(a,j,lo,hi);
+	IOsegments(grid,myrank,site0,nsites,bytes_per_site,offset,lo,hi,myseg[a]);
+	uint64_t bytes=0;
+	for(auto &s : myseg[a]) bytes+=s.bytes;
+	if ( bytes == 0 ) continue;
+	assert(bytes < (uint64_t)INT_MAX);
+	mine[a].resize(bytes);
+	MPI_Request req;
+	if ( writing ) {
+	  uint64_t m=0;
+	  for(auto &s : myseg[a]) { std::memcpy(&mine[a][m],buf+s.buf,s.bytes); m+=s.bytes; }
+	  MPI_Isend(&mine[a][0],bytes,MPI_BYTE,IOaggregatorRank(grid,a),tag,grid->communicator,&req);
+	} else {
+	  MPI_Irecv(&mine[a][0],bytes,MPI_BYTE,IOaggregatorRank(grid,a),tag,grid->communicator,&req);
+	}
+	reqs.push_back(req);
+      }
+
+      //////////////////////////////////////////////
+      // Aggregator side: sort pieces by file offset
+      // and move whole contiguous runs
+      //////////////////////////////////////////////
+      struct Piece { uint64_t file, bytes, msg; int rank; };
+      std::vector<std::vector<char> > msgs;
+      for(int a=0;a<naggr;a++){
+	if ( IOaggregatorRank(grid,a) != myrank ) continue;
+
+	uint64_t lo,hi;
+	range(a,j,lo,hi);
+	if ( lo >= hi ) continue;
+	std::vector<Piece> pieces;
+	std::vector<IOsegment> seg;
+	msgs.resize(nrank);
+	for(int r=0;r<nrank;r++){
+	  IOsegments(grid,r,site0,nsites,bytes_per_site,offset,lo,hi,seg);
+	  uint64_t m=0;
+	  for(auto &s : seg) { pieces.push_back({s.file,s.bytes,m,r}); m+=s.bytes; }
+	  msgs[r].resize(m);
+	}
+	std::sort(pieces.begin(),pieces.end(),[](const Piece &x,const Piece &y){ return x.file < y.file; });
+	uint64_t total=0;
+	for(auto &p : pieces) total+=p.bytes;
+	std::vector<char> agg(total);
+
+	std::vector<MPI_Request> rreqs;
+	if ( writing ) {
+	  for(int r=0;r<nrank;r++){
+	    if ( msgs[r].size()==0 ) continue;
+	    MPI_Request req;
+	    MPI_Irecv(&msgs[r][0],msgs[r].size(),MPI_BYTE,r,tag,grid->communicator,&req);
+	    rreqs.push_back(req);
+	  }
+	  if ( rreqs.size() ) MPI_Waitall(rreqs.size(),&rreqs[0],MPI_STATUSES_IGNORE);
+	  uint64_t pos=0;
+	  for(auto &p : pieces) { std::memcpy(&agg[pos],&msgs[p.rank][p.msg],p.bytes); pos+=p.bytes; }
+	}
+
+	uint64_t pos=0, run_pos=0, run_file=0, run_bytes=0;
+	for(auto &p : pieces) {
+	  if ( run_bytes && (p.file == run_file+run_bytes) ) {
+	    run_bytes+=p.bytes;
+	  } else {
+	    if ( run_bytes && ok ) ok = IOtransfer(fd,&agg[run_pos],run_bytes,run_file,control);
+	    run_pos   = pos;
+	    run_file  = p.file;
+	    run_bytes = p.bytes;
+	  }
+	  pos+=p.bytes;
+	}
+	if ( run_bytes && ok ) ok = IOtransfer(fd,&agg[run_pos],run_bytes,run_file,control);
+
+	if ( !writing ) {
+	  pos=0;
+	  for(auto &p : pieces) { std::memcpy(&msgs[p.rank][p.msg],&agg[pos],p.bytes); pos+=p.bytes; }
+	  for(int r=0;r<nrank;r++){
+	    if ( msgs[r].size()==0 ) continue;
+	    MPI_Request req;
+	    MPI_Isend(&msgs[r][0],msgs[r].size(),MPI_BYTE,r,tag,grid->communicator,&req);
+	    reqs.push_back(req);
+	  }
+	}
+      }
+      if ( reqs.size() ) MPI_Waitall(reqs.size(),&reqs[0],MPI_STATUSES_IGNORE);
+
+      if ( !writing ) {
+	for(int a=0;a<naggr;a++){
+	  uint64_t m=0;
+	  for(auto &s : myseg[a]) { std::memcpy(buf+s.buf,&mine[a][m],s.bytes); m+=s.bytes; }
+	}
+      }
+    }
+    return ok;
+#else
+    assert(0);
+    return false;
+#endif
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Streaming lattice I/O.
+  //
+  // The rank local volume is cut into chunks of whole slabs of the slowest local
+  // dimension, at most latticeChunkBytes of file objects each (0 means a single
+  // chunk). Each chunk is unvectorised and munged straight into a file buffer,
+  // checksummed and byte swapped there, and written while the next chunk is
+  // being prepared; reading runs the same pipeline backwards with one chunk of
+  // read ahead. Peak memory is the field plus two chunk buffers.
+  //
+  // Compute/I-O overlap needs a helper thread and is only done on the POSIX
+  // path; MPI-IO collectives and aggregated transfers are issued chunk by
+  // chunk from the main thread.
+  /////////////////////////////////////////////////////////////////////////////
+  static inline void IOabort(const std::string &what,const std::string &file)
+  {
+    std::cout << GridLogError << "BinaryIO: "<< what << " " << file << " : " << strerror(errno) << std::endl;
+#ifdef USE_MPI_IO
+    MPI_Abort(MPI_COMM_WORLD,1);
+#else
+    exit(1);
+#endif
+  }
+
+  template<class fobj,class stager>
+  static inline void streamLatticeObject(GridBase *grid,
+					 std::string file,
+					 stager stage,
+					 uint64_t offset,
+					 const std::string &format,
+					 int control,
+					 uint32_t &nersc_csum,
+					 uint32_t &scidac_csuma,
+					 uint32_t &scidac_csumb,
+					 uint64_t *grid_csum=nullptr)
+  {
+    int  nd        = grid->Dimensions();
+    int  nrank     = grid->ProcessorCount();
+    bool reading   = (control & BINARYIO_READ);
+
+    nersc_csum=0;
+    scidac_csuma=0;
+    scidac_csumb=0;
+    if ( grid_csum ) *grid_csum=0;
+
+    int ieee32big = (format == std::string("IEEE32BIG"));
+    int ieee32    = (format == std::string("IEEE32"));
+    int ieee64big = (format == std::string("IEEE64BIG"));
+    int ieee64    = (format == std::string("IEEE64") || format == std::string("IEEE64LITTLE"));
+    assert((ieee64+ieee32+ieee64big+ieee32big)==1);
+
+    //////////////////////////////////////////////////////////////////////////////
+    // Chunk geometry; identical on every rank so collectives pair up
+    //////////////////////////////////////////////////////////////////////////////
+    Coordinate lLattice = grid->LocalDimensions();
+    uint64_t lsites = grid->lSites();
+    uint64_t nslab  = lLattice[nd-1];
+    uint64_t slab   = lsites/nslab;
+    uint64_t per    = nslab;
+    if ( latticeChunkBytes ) {
+      per = std::max<uint64_t>(1,std::min<uint64_t>(nslab,latticeChunkBytes/(slab*sizeof(fobj))));
+    }
+    uint64_t nchunk = (nslab+per-1)/per;
+    std::vector<fobj> buf[2];
+    buf[0].resize(per*slab);
+    if ( nchunk > 1 ) buf[1].resize(per*slab);
+
+    // MPI-IO collectives or aggregated I/O with several ranks, positioned POSIX I/O otherwise
+    bool aggregate = (nrank > 1) && (ioAggregators > 0);
+    bool mpiio     = false;
+#ifdef USE_MPI_IO
+    mpiio = (nrank > 1) && !aggregate;
+    MPI_File fh;
+    MPI_Datatype mpiObject;
+    Coordinate gLattice = grid->GlobalDimensions();
+    Coordinate gStart   = grid->LocalStarts();
+    int ierr;
+    ierr = MPI_Type_contiguous(sizeof(fobj),MPI_BYTE,&mpiObject);  assert(ierr==0);
+    ierr = MPI_Type_commit(&mpiObject);                           assert(ierr==0);
+#endif
+    int fd = -1;
+
+    grid->Barrier();
+    if ( mpiio ) {
+#ifdef USE_MPI_IO
+      int mode = reading ? MPI_MODE_RDONLY : (MPI_MODE_RDWR | MPI_MODE_CREATE);
+      ierr=MPI_File_open(grid->communicator,(char *) file.c_str(), mode, MPI_INFO_NULL, &fh);
+      if ( ierr != MPI_SUCCESS ) IOabort("MPI_File_open failed on",file);
+#endif
+    } else if ( aggregate ) {
+      fd = IOaggregatorOpen(grid,file,offset,control);
+    } else {
+      // Matches the truncation semantics of the fstream path in IOobject
+      if ( !reading && (offset==0) && grid->IsBoss() ) {
+	int tfd = ::open(file.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+	if ( tfd < 0 ) IOabort("Error in opening the file for output",file);
+	::close(tfd);
+      }
+      grid->Barrier();
+      fd = ::open(file.c_str(),reading ? O_RDONLY : (O_WRONLY|O_CREAT),0644);
+      if ( fd < 0 ) IOabort(reading ? "Error in opening the file for input" : "Error in opening the file for output",file);
+    }
+
+    // Transfer one chunk, returns the microseconds spent in I/O; safe off the main thread on the POSIX path
+    bool threaded = !mpiio && !aggregate;
+    auto transfer = [&](uint64_t k,fobj *ptr) -> uint64_t {
+      GridStopWatch iot; iot.Start();
+      uint64_t t0     = k*per;
+      uint64_t nt     = std::min(per,nslab-t0);
+      bool ok = true;
+      if ( mpiio ) {
+#ifdef USE_MPI_IO
+	Coordinate subsize = lLattice;
+	Coordinate start   = gStart;
+	subsize[nd-1] = nt;
+	start[nd-1]  += t0;
+	MPI_Datatype fileArray;
+	MPI_Status status;
+	ierr=MPI_Type_create_subarray(nd,&gLattice[0],&subsize[0],&start[0],MPI_ORDER_FORTRAN,mpiObject,&fileArray); assert(ierr==0);
+	ierr=MPI_Type_commit(&fileArray);                                                                              assert(ierr==0);
+	ierr=MPI_File_set_view(fh,(MPI_Offset)offset,mpiObject,fileArray,"native",MPI_INFO_NULL);                      assert(ierr==0);
+	if ( reading ) ierr=MPI_File_read_all (fh,ptr,nt*slab,mpiObject,&status);
+	else           ierr=MPI_File_write_all(fh,ptr,nt*slab,mpiObject,&status);
+	ok = (ierr==MPI_SUCCESS);
+	MPI_Type_free(&fileArray);
+#endif
+      } else if ( aggregate ) {
+	ok = IOaggregate(grid,fd,(char *)ptr,t0*slab,nt*slab,sizeof(fobj),offset,control);
+      } else {
+	ok = IOtransferSites(fd,grid,(char *)ptr,t0*slab,nt*slab,sizeof(fobj),offset,control);
+      }
+      if ( !ok ) IOabort(reading ? "Read failed on" : "Write failed on",file);
+      iot.Stop();
+      return iot.useconds();
+    };
+
+    GridStopWatch wall, compute;
+    uint64_t iousecs = 0;
+    std::future<uint64_t> pending;
+
+    wall.Start();
+    {
+      if ( reading && threaded ) pending = std::async(std::launch::async,transfer,0,&buf[0][0]);
+
+      for(uint64_t k=0;k<nchunk;k++){
+
+	fobj    *ptr   = &buf[k%2][0];
+	uint64_t site0 = k*per*slab;
+	uint64_t n     = std::min(per,nslab-k*per)*slab;
+
+	if ( reading ) {
+	  if ( !threaded ) iousecs += transfer(k,ptr);
+	  else {
+	    iousecs += pending.get();
+	    if ( k+1<nchunk ) pending = std::async(std::launch::async,transfer,k+1,&buf[(k+1)%2][0]);
+	  }
+	  compute.Start();
+	  ScidacChecksum(grid,ptr,site0,n,scidac_csuma,scidac_csumb,grid_csum);
+	  if (ieee32big) be32toh_v((void *)ptr, sizeof(fobj)*n);
+	  if (ieee32)    le32toh_v((void *)ptr, sizeof(fobj)*n);
+	  if (ieee64big) be64toh_v((void *)ptr, sizeof(fobj)*n);
+	  if (ieee64)    le64toh_v((void *)ptr, sizeof(fobj)*n);
+	  NerscChecksum(ptr,n,nersc_csum);
+	  stage(ptr,site0,n);
+	  compute.Stop();
+	} else {
+	  compute.Start();
+	  stage(ptr,site0,n);
+	  NerscChecksum(ptr,n,nersc_csum);
+	  if (ieee32big) htobe32_v((void *)ptr, sizeof(fobj)*n);
+	  if (ieee32)    htole32_v((void *)ptr, sizeof(fobj)*n);
+	  if (ieee64big) htobe64_v((void *)ptr, sizeof(fobj)*n);
+	  if (ieee64)    htole64_v((void *)ptr, sizeof(fobj)*n);
+	  ScidacChecksum(grid,ptr,site0,n,scidac_csuma,scidac_csumb,grid_csum);
+	  compute.Stop();
+	  if ( !threaded ) iousecs += transfer(k,ptr);
+	  else {
+	    if ( k>0 ) iousecs += pending.get();
+	    pending = std::async(std::launch::async,transfer,k,ptr);
+	  }
+	}
+      }
+      if ( !reading && threaded ) iousecs += pending.get();
+    }
+    wall.Stop();
+
+    if ( mpiio ) {
+#ifdef USE_MPI_IO
+      MPI_File_close(&fh);
+#endif
+    } else if ( fd >= 0 ) {
+      if ( !reading && ::fsync(fd) != 0 ) IOabort("fsync failed on",file);
+      ::close(fd);
+    }
+#ifdef USE_MPI_IO
+    MPI_Type_free(&mpiObject);
+#endif
+
+    grid->Barrier();
+    grid->GlobalSum(nersc_csum);
+    grid->GlobalXOR(scidac_csuma);
+    grid->GlobalXOR(scidac_csumb);
+    if ( grid_csum ) grid->GlobalSum(*grid_csum);
+    grid->Barrier();
+
+    uint64_t usecs   = compute.useconds() + iousecs;
+    uint64_t overlap = (usecs > wall.useconds()) ? usecs - wall.useconds() : 0;
+    lastPerf.size            = sizeof(fobj)*grid->gSites();
+    lastPerf.time            = wall.useconds();
+    lastPerf.mbytesPerSecond = lastPerf.size/1024./1024./(lastPerf.time/1.0e6);
+    std::cout<<GridLogMessage<<"streamLatticeObject: "<< (reading ? "read  " : "write ")
+	     << lastPerf.size <<" bytes in "<< wall.Elapsed() <<" "<< lastPerf.mbytesPerSecond <<" MB/s "
+	     << nchunk << " chunk(s) of "<< per*slab*sizeof(fobj) <<" bytes" <<std::endl;
+    std::cout<<GridLogMessage<<"streamLatticeObject: I/O "<< iousecs <<" us, munge/endian/checksum "<< compute.useconds()
+	     <<" us, overlapped "<< overlap <<" us" <<std::endl;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Outer and inner index of local lexicographic site lidx. Coordinates are the
+  // reduced ones of LocalIndexToLocalCoor, so checkerboarded fields keep the
+  // layout of vectorizeFromLexOrdArray
+  /////////////////////////////////////////////////////////////////////////////
+  static inline void lexOrdSiteIndex(GridBase *grid,uint64_t lidx,int &o_idx,int &i_idx)
+  {
+    Coordinate lcoor;
+    grid->LocalIndexToLocalCoor(lidx,lcoor);
+    o_idx = 0;
+    i_idx = 0;
+    for(int d=0;d<grid->Nd();d++){
+      o_idx += grid->_ostride[d]*(lcoor[d]%grid->_rdimensions[d]);
+      i_idx += grid->_istride[d]*(lcoor[d]/grid->_rdimensions[d]);
+    }
+  }
+
   /////////////////////////////////////////////////////////////////////////////
   // Read a Lattice of object
   //////////////////////////////////////////////////////////////////////////////////////
@@ -545,30 +1168,24 @@ class BinaryIO {
 				       const std::string &format,
 				       uint32_t &nersc_csum,
 				       uint32_t &scidac_csuma,
-				       uint32_t &scidac_csumb)
+				       uint32_t &scidac_csumb,
+				       uint64_t *grid_csum=nullptr)
   {
     typedef typename vobj::scalar_object sobj;
-    typedef typename vobj::Realified::scalar_type word;    word w=0;
 
     GridBase *grid = Umu.Grid();
-    uint64_t lsites = grid->lSites();
-
-    std::vector<sobj> scalardata(lsites); 
-    std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
-    
-    IOobject(w,grid,iodata,file,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
-	     nersc_csum,scidac_csuma,scidac_csumb);
-
-    GridStopWatch timer; 
-    timer.Start();
-
-    thread_for(x,lsites, { munge(iodata[x], scalardata[x]); });
-
-    vectorizeFromLexOrdArray(scalardata,Umu);    
-    grid->Barrier();
-
-    timer.Stop();
-    std::cout<<GridLogMessage<<"readLatticeObject: vectorize overhead "<<timer.Elapsed()  <<std::endl;
+    autoView( U_v, Umu, CpuWrite);
+    auto unpack = [&](fobj *ptr,uint64_t site0,uint64_t n) {
+      thread_for(x,n,{
+	int o_idx, i_idx;
+	sobj s;
+	lexOrdSiteIndex(grid,site0+x,o_idx,i_idx);
+	munge(ptr[x],s);
+	insertLane(i_idx,U_v[o_idx],s);
+      });
+    };
+    streamLatticeObject<fobj>(grid,file,unpack,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
+			      nersc_csum,scidac_csuma,scidac_csumb,grid_csum);
   }
 
   /////////////////////////////////////////////////////////////////////////////
@@ -582,48 +1199,43 @@ class BinaryIO {
 					  const std::string &format,
 					  uint32_t &nersc_csum,
 					  uint32_t &scidac_csuma,
-					  uint32_t &scidac_csumb)
+					  uint32_t &scidac_csumb,
+					  uint64_t *grid_csum=nullptr)
   {
     typedef typename vobj::scalar_object sobj;
-    typedef typename vobj::Realified::scalar_type word;    word w=0;
+
     GridBase *grid = Umu.Grid();
-    uint64_t lsites = grid->lSites(), offsetCopy = offset;
     int attemptsLeft = std::max(0, BinaryIO::latticeWriteMaxRetry);
     bool checkWrite = (BinaryIO::latticeWriteMaxRetry >= 0);
 
-    std::vector<sobj> scalardata(lsites); 
-    std::vector<fobj>     iodata(lsites); // Munge, checksum, byte order in here
-
-    //////////////////////////////////////////////////////////////////////////////
-    // Munge [ .e.g 3rd row recon ]
-    //////////////////////////////////////////////////////////////////////////////
-    GridStopWatch timer; timer.Start();
-    unvectorizeToLexOrdArray(scalardata,Umu);    
-
-    thread_for(x, lsites, { munge(scalardata[x],iodata[x]); });
+    autoView( U_v, Umu, CpuRead);
+    auto pack = [&](fobj *ptr,uint64_t site0,uint64_t n) {
+      thread_for(x,n,{
+	int o_idx, i_idx;
+	lexOrdSiteIndex(grid,site0+x,o_idx,i_idx);
+	sobj s = extractLane(i_idx,U_v[o_idx]);
+	munge(s,ptr[x]);
+      });
+    };
+    auto nostage = [](fobj *ptr,uint64_t site0,uint64_t n) {};
 
-    grid->Barrier();
-    timer.Stop();
     while (attemptsLeft >= 0)
     {
-      grid->Barrier();
-      IOobject(w,grid,iodata,file,offset,format,BINARYIO_WRITE|BINARYIO_LEXICOGRAPHIC,
-	             nersc_csum,scidac_csuma,scidac_csumb);
+      streamLatticeObject<fobj>(grid,file,pack,offset,format,BINARYIO_WRITE|BINARYIO_LEXICOGRAPHIC,
+				nersc_csum,scidac_csuma,scidac_csumb,grid_csum);
       if (checkWrite)
       {
-        std::vector<fobj> ckiodata(lsites);
         uint32_t          cknersc_csum, ckscidac_csuma, ckscidac_csumb;
-        uint64_t          ckoffset = offsetCopy;
+        uint64_t          ckgrid_csum;
 
+        // Read back through the same pipeline but only accumulate checksums
         std::cout << GridLogMessage << "writeLatticeObject: read back object" << std::endl;
-        grid->Barrier();
-        IOobject(w,grid,ckiodata,file,ckoffset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
-	               cknersc_csum,ckscidac_csuma,ckscidac_csumb);
-        if ((cknersc_csum != nersc_csum) or (ckscidac_csuma != scidac_csuma) or (ckscidac_csumb != scidac_csumb))
+        streamLatticeObject<fobj>(grid,file,nostage,offset,format,BINARYIO_READ|BINARYIO_LEXICOGRAPHIC,
+				  cknersc_csum,ckscidac_csuma,ckscidac_csumb,grid_csum ? &ckgrid_csum : nullptr);
+        if ((cknersc_csum != nersc_csum) or (ckscidac_csuma != scidac_csuma) or (ckscidac_csumb != scidac_csumb)
+	    or (grid_csum && (ckgrid_csum != *grid_csum)))
         {
           std::cout << GridLogMessage << "writeLatticeObject: read test checksum failure, re-writing (" << attemptsLeft << " attempt(s) remaining)" << std::endl;
-          offset = offsetCopy;
-          thread_for(x,lsites, { munge(scalardata[x],iodata[x]); });
         }
         else
         {
@@ -633,9 +1245,6 @@ class BinaryIO {
       }
       attemptsLeft--;
     }
-    
-
-    std::cout<<GridLogMessage<<"writeLatticeObject: unvectorize overhead "<<timer.Elapsed()  <<std::endl;
   }
   
   /////////////////////////////////////////////////////////////////////////////
@@ -666,6 +1275,11 @@ class BinaryIO {
 
     GridStopWatch timer;
 
+    if ( isCounterRNG(grid,file,offset) ) {
+      readCounterRNG(serial_rng,parallel_rng,file,offset,nersc_csum,scidac_csuma,scidac_csumb);
+      return;
+    }
+
     std::cout << GridLogMessage << "RNG read I/O on file " << file << std::endl;
 
     std::vector<RNGstate> iodata(lsites);
@@ -732,6 +1346,11 @@ class BinaryIO {
     GridStopWatch timer;
     std::string format = "IEEE32BIG";
 
+    if ( parallel_rng.CounterBased() ) {
+      writeCounterRNG(serial_rng,parallel_rng,file,offset,nersc_csum,scidac_csuma,scidac_csumb);
+      return;
+    }
+
     std::cout << GridLogMessage << "RNG write I/O on file " << file << std::endl;
 
     timer.Start();
@@ -768,6 +1387,123 @@ class BinaryIO {
     std::cout << GridLogMessage << "RNG file checksumb " << std::hex << scidac_csumb << std::dec << std::endl;
     std::cout << GridLogMessage << "RNG state overhead " << timer.Elapsed() << std::endl;
   }
+  /////////////////////////////////////////////////////////////////////////////
+  // Counter based parallel RNG: the boss writes the few words of parallel state
+  // (big endian, led by a magic word) in place of the per site engines, then
+  // appends the serial state as writeRNG does. readRNG recognises either file.
+  //////////////////////////////////////////////////////////////////////////////////////
+  static inline bool isCounterRNG(GridBase *grid,const std::string &file,uint64_t offset)
+  {
+    uint64_t magic=0;
+    if ( grid->IsBoss() ) {
+      int fd = ::open(file.c_str(),O_RDONLY);
+      if ( fd >= 0 ) {
+	if ( IOtransfer(fd,(char *)&magic,sizeof(magic),offset,BINARYIO_READ) ) magic = Grid_ntohll(magic);
+	::close(fd);
+      }
+    }
+    grid->Broadcast(grid->BossRank(),(void *)&magic,sizeof(magic));
+    return magic == GridParallelRNG::CounterStateMagic;
+  }
+  static inline void writeCounterRNG(GridSerialRNG &serial_rng,
+				     GridParallelRNG &parallel_rng,
+				     std::string file,
+				     uint64_t offset,
+				     uint32_t &nersc_csum,
+				     uint32_t &scidac_csuma,
+				     uint32_t &scidac_csumb)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    typedef RngStateType word; word w=0;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    typedef std::array<RngStateType,RngStateCount> RNGstate;
+
+    GridBase *grid = parallel_rng.Grid();
+    std::string format = "IEEE32BIG";
+    std::cout << GridLogMessage << "Counter based RNG write I/O on file " << file << std::endl;
+
+    std::vector<uint64_t> state;
+    parallel_rng.GetCounterState(state);
+    uint64_t bytes = state.size()*sizeof(uint64_t);
+    htobe64_v((void *)&state[0],bytes);
+    nersc_csum = 0;
+    NerscChecksum(&state[0],state.size(),nersc_csum);
+    scidac_csuma = scidac_csumb = crc32(0,(unsigned char *)&state[0],bytes);
+    if ( grid->IsBoss() ) {
+      int fd = ::open(file.c_str(),O_WRONLY|O_CREAT,0644);
+      if ( fd < 0 ) IOabort("Error in opening the file for output",file);
+      if ( !IOtransfer(fd,(char *)&state[0],bytes,offset,BINARYIO_WRITE) ) IOabort("Write failed on",file);
+      if ( ::ftruncate(fd,offset+bytes) != 0 ) IOabort("Truncate failed on",file);
+      ::close(fd);
+    }
+    grid->Barrier();
+    offset += bytes;
+
+    uint32_t nersc_csum_tmp, scidac_csuma_tmp, scidac_csumb_tmp;
+    std::vector<RNGstate> iodata(1);
+    {
+      std::vector<RngStateType> tmp(RngStateCount);
+      serial_rng.GetState(tmp,0);
+      std::copy(tmp.begin(),tmp.end(),iodata[0].begin());
+    }
+    IOobject(w,grid,iodata,file,offset,format,BINARYIO_WRITE|BINARYIO_MASTER_APPEND,
+	     nersc_csum_tmp,scidac_csuma_tmp,scidac_csumb_tmp);
+
+    nersc_csum   = nersc_csum   + nersc_csum_tmp;
+    scidac_csuma = scidac_csuma ^ scidac_csuma_tmp;
+    scidac_csumb = scidac_csumb ^ scidac_csumb_tmp;
+    std::cout << GridLogMessage << "RNG file checksum " << std::hex << nersc_csum    << std::dec << std::endl;
+    std::cout << GridLogMessage << "RNG file checksuma " << std::hex << scidac_csuma << std::dec << std::endl;
+    std::cout << GridLogMessage << "RNG file checksumb " << std::hex << scidac_csumb << std::dec << std::endl;
+  }
+  static inline void readCounterRNG(GridSerialRNG &serial_rng,
+				    GridParallelRNG &parallel_rng,
+				    std::string file,
+				    uint64_t offset,
+				    uint32_t &nersc_csum,
+				    uint32_t &scidac_csuma,
+				    uint32_t &scidac_csumb)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    typedef RngStateType word; word w=0;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    typedef std::array<RngStateType,RngStateCount> RNGstate;
+
+    GridBase *grid = parallel_rng.Grid();
+    std::string format = "IEEE32BIG";
+    std::cout << GridLogMessage << "Counter based RNG read I/O on file " << file << std::endl;
+
+    std::vector<uint64_t> state(GridParallelRNG::CounterStateCount);
+    uint64_t bytes = state.size()*sizeof(uint64_t);
+    if ( grid->IsBoss() ) {
+      int fd = ::open(file.c_str(),O_RDONLY);
+      if ( fd < 0 ) IOabort("Error in opening the file for input",file);
+      if ( !IOtransfer(fd,(char *)&state[0],bytes,offset,BINARYIO_READ) ) IOabort("Read failed on",file);
+      ::close(fd);
+    }
+    grid->Broadcast(grid->BossRank(),(void *)&state[0],bytes);
+    nersc_csum = 0;
+    NerscChecksum(&state[0],state.size(),nersc_csum);
+    scidac_csuma = scidac_csumb = crc32(0,(unsigned char *)&state[0],bytes);
+    be64toh_v((void *)&state[0],bytes);
+    parallel_rng.SetCounterState(state);
+
+    uint32_t nersc_csum_tmp, scidac_csuma_tmp, scidac_csumb_tmp;
+    std::vector<RNGstate> iodata(1);
+    IOobject(w,grid,iodata,file,offset,format,BINARYIO_READ|BINARYIO_MASTER_APPEND,
+	     nersc_csum_tmp,scidac_csuma_tmp,scidac_csumb_tmp);
+    {
+      std::vector<RngStateType> tmp(RngStateCount);
+      std::copy(iodata[0].begin(),iodata[0].end(),tmp.begin());
+      serial_rng.SetState(tmp,0);
+    }
+    nersc_csum   = nersc_csum   + nersc_csum_tmp;
+    scidac_csuma = scidac_csuma ^ scidac_csuma_tmp;
+    scidac_csumb = scidac_csumb ^ scidac_csumb_tmp;
+    std::cout << GridLogMessage << "RNG file nersc_checksum   " << std::hex << nersc_csum << std::dec << std::endl;
+    std::cout << GridLogMessage << "RNG file scidac_checksuma " << std::hex << scidac_csuma << std::dec << std::endl;
+    std::cout << GridLogMessage << "RNG file scidac_checksumb " << std::hex << scidac_csumb << std::dec << std::endl;
+  }
 };
 
 NAMESPACE_END(Grid);
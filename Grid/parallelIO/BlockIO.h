@@ -0,0 +1,456 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/BlockIO.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Block structured checkpoint files
+//
+//   "GRIDBLK1"                       8 byte magic
+//   uint64_t xml_bytes
+//   <GridBlockHeader> xml
+//   uint64_t index[nblocks+1][4]     offset, bytes, crc32c, complete
+//   block data                       fixed size, fixed offsets
+//
+// Each rank's sub-volume is cut into slabs of the slowest local dimension;
+// block rank*per_rank+k is slab k of that rank, in host byte order. The last
+// index entry is an optional "extra" record (the serial RNG) owned by the boss.
+//
+// A block's index entry is cleared before its data is rewritten and marked
+// complete only after the data is synced. A write that finds the file already
+// laid out for the same header keeps every block whose entry is complete with
+// the same crc32c and whose data still checks out, so a write that died
+// half way is resumed by rewriting only the missing blocks.
+//
+// On read every rank reads and checks only its own blocks; corrupt blocks are
+// reported individually before failing. Reading needs the writing decomposition.
+////////////////////////////////////////////////////////////////////////////////
+class GridBlockHeader : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(GridBlockHeader,
+				  double, version,
+				  std::string, data_type,
+				  std::vector<int>, dimension,
+				  std::vector<int>, processors,
+				  uint32_t, bytes_per_site,
+				  uint32_t, blocks_per_rank,
+				  uint32_t, slabs_per_block,
+				  uint32_t, extra_bytes,
+				  std::string, byte_order);
+  GridBlockHeader(void) : version(1.0), bytes_per_site(0), blocks_per_rank(0), slabs_per_block(0), extra_bytes(0) {}
+};
+
+class BlockIO : public BinaryIO {
+public:
+
+  static const int IndexWords = 4;
+
+  struct BlockStats {
+    uint64_t written = 0;
+    uint64_t kept    = 0;
+    uint64_t bytes   = 0;
+    double   time    = 0;
+  };
+
+  static inline GridBlockHeader layout(GridBase *grid,const std::string &type,uint32_t bytes_per_site,
+				       uint32_t extra_bytes,uint64_t blockBytes)
+  {
+    int nd = grid->_ndimension;
+    Coordinate ldims = grid->LocalDimensions();
+    uint64_t nslab = ldims[nd-1];
+    uint64_t slab  = grid->lSites()/nslab;
+    uint64_t per   = std::max<uint64_t>(1,std::min<uint64_t>(nslab,blockBytes/(slab*bytes_per_site)));
+
+    GridBlockHeader header;
+    header.data_type       = type;
+    header.dimension       = std::vector<int>(grid->FullDimensions().toVector());
+    header.processors      = std::vector<int>(grid->ProcessorGrid().toVector());
+    header.bytes_per_site  = bytes_per_site;
+    header.slabs_per_block = per;
+    header.blocks_per_rank = (nslab+per-1)/per;
+    header.extra_bytes     = extra_bytes;
+#if BYTE_ORDER == BIG_ENDIAN
+    header.byte_order      = std::string("big");
+#else
+    header.byte_order      = std::string("little");
+#endif
+    return header;
+  }
+
+  static inline std::string headerString(const GridBlockHeader &header)
+  {
+    XmlWriter WR("","");
+    write(WR,"GridBlockHeader",header);
+    return WR.docString();
+  }
+
+  // Sites [site0,site0+nsites) of local block k
+  static inline void blockSites(GridBase *grid,const GridBlockHeader &header,uint64_t k,uint64_t &site0,uint64_t &nsites)
+  {
+    int nd = grid->_ndimension;
+    uint64_t nslab = grid->LocalDimensions()[nd-1];
+    uint64_t slab  = grid->lSites()/nslab;
+    uint64_t t0    = k*header.slabs_per_block;
+    site0  = t0*slab;
+    nsites = std::min<uint64_t>(header.slabs_per_block,nslab-t0)*slab;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Collective write. pack(lidx,char *site) fills bytes_per_site bytes for
+  // rank local lexicographic site lidx. extra (may be empty) is the boss's.
+  /////////////////////////////////////////////////////////////////////////////
+  template<class packer>
+  static inline BlockStats writeBlocks(GridBase *grid,const std::string &file,const std::string &type,
+				       uint32_t bytes_per_site,packer pack,
+				       const std::vector<char> &extra,uint64_t blockBytes=8*1024*1024)
+  {
+    BlockStats stats;
+    GridStopWatch timer;
+    timer.Start();
+
+    int      myrank = grid->ThisRank();
+    uint64_t lsites = grid->lSites();
+    uint32_t extra_bytes = extra.size();
+    grid->Broadcast(grid->BossRank(),(void *)&extra_bytes,sizeof(extra_bytes));
+
+    GridBlockHeader header = layout(grid,type,bytes_per_site,extra_bytes,blockBytes);
+    std::string xml = headerString(header);
+    uint64_t nb      = header.blocks_per_rank;
+    uint64_t nblocks = nb*grid->ProcessorCount();
+    uint64_t index_start = 16+xml.size();
+    uint64_t data_start  = index_start + (nblocks+1)*IndexWords*sizeof(uint64_t);
+    uint64_t rank_bytes  = lsites*bytes_per_site;
+    uint64_t extra_start = data_start + grid->ProcessorCount()*rank_bytes;
+    uint64_t file_bytes  = extra_start + extra_bytes;
+
+    //////////////////////////////////////////////
+    // Boss lays the file out unless it already
+    // holds this layout
+    //////////////////////////////////////////////
+    int reuse = 0;
+    if ( grid->IsBoss() ) {
+      int fd = ::open(file.c_str(),O_RDWR|O_CREAT,0644);
+      if ( fd < 0 ) IOabort("Error in opening the file for output",file);
+      std::vector<char> old(16+xml.size());
+      uint64_t xml_bytes = xml.size();
+      struct stat st;
+      if ( ::fstat(fd,&st)==0 && (uint64_t)st.st_size == file_bytes
+	   && IOtransfer(fd,&old[0],old.size(),0,BINARYIO_READ) ) {
+	reuse = !strncmp(&old[0],"GRIDBLK1",8)
+	  && !memcmp(&old[8],&xml_bytes,8)
+	  && !memcmp(&old[16],&xml[0],xml.size());
+      }
+      if ( !reuse ) {
+	if ( ::ftruncate(fd,0) != 0 ) IOabort("Truncate failed on",file);
+	std::vector<uint64_t> index((nblocks+1)*IndexWords,0);
+	bool ok = IOtransfer(fd,(char *)"GRIDBLK1",8,0,BINARYIO_WRITE);
+	ok = ok && IOtransfer(fd,(char *)&xml_bytes,8,8,BINARYIO_WRITE);
+	ok = ok && IOtransfer(fd,&xml[0],xml.size(),16,BINARYIO_WRITE);
+	ok = ok && IOtransfer(fd,(char *)&index[0],index.size()*sizeof(uint64_t),index_start,BINARYIO_WRITE);
+	if ( !ok || ::ftruncate(fd,file_bytes) != 0 ) IOabort("Write failed on",file);
+	if ( ::fsync(fd) != 0 ) IOabort("fsync failed on",file);
+      }
+      ::close(fd);
+    }
+    grid->Broadcast(grid->BossRank(),(void *)&reuse,sizeof(reuse));
+
+    //////////////////////////////////////////////
+    // My blocks (plus the extra record on the boss)
+    //////////////////////////////////////////////
+    struct Block { uint64_t entry, offset, bytes; const char *data; std::vector<char> buf; uint64_t crc; };
+    std::vector<Block> blocks(nb);
+    blocks.reserve(nb+1);
+    for(uint64_t k=0;k<nb;k++){
+      uint64_t site0,nsites;
+      blockSites(grid,header,k,site0,nsites);
+      Block &B = blocks[k];
+      B.entry  = myrank*nb+k;
+      B.offset = data_start + myrank*rank_bytes + site0*bytes_per_site;
+      B.bytes  = nsites*bytes_per_site;
+      B.buf.resize(B.bytes);
+      char *buf = &B.buf[0];
+      thread_for(s,nsites,{ pack(site0+s,buf+s*bytes_per_site); });
+      B.data = buf;
+      B.crc  = GridChecksum::crc32c(B.data,B.bytes);
+    }
+    if ( grid->IsBoss() && extra_bytes ) {
+      Block B;
+      B.entry  = nblocks;
+      B.offset = extra_start;
+      B.bytes  = extra_bytes;
+      B.data   = &extra[0];
+      B.crc    = GridChecksum::crc32c(B.data,B.bytes);
+      blocks.push_back(B);
+    }
+
+    int fd = ::open(file.c_str(),O_RDWR);
+    if ( fd < 0 ) IOabort("Error in opening the file for output",file);
+    std::vector<Block *> todo;
+    for(auto &B : blocks){
+      if ( reuse ) {
+	uint64_t ent[IndexWords];
+	bool ok = IOtransfer(fd,(char *)ent,sizeof(ent),index_start+B.entry*sizeof(ent),BINARYIO_READ);
+	if ( ok && ent[3]==1 && ent[1]==B.bytes && ent[2]==B.crc ) {
+	  std::vector<char> disk(B.bytes);
+	  ok = IOtransfer(fd,&disk[0],B.bytes,B.offset,BINARYIO_READ);
+	  if ( ok && GridChecksum::crc32c(&disk[0],B.bytes)==B.crc ) { stats.kept++; continue; }
+	}
+      }
+      todo.push_back(&B);
+    }
+    // Invalidate, write, sync, then mark complete: a crash never leaves a stale block marked good
+    bool ok = true;
+    uint64_t cleared[IndexWords] = {0,0,0,0};
+    for(auto B : todo) ok = ok && IOtransfer(fd,(char *)cleared,sizeof(cleared),index_start+B->entry*sizeof(cleared),BINARYIO_WRITE);
+    if ( todo.size() && ::fsync(fd) != 0 ) ok = false;
+    for(auto B : todo) ok = ok && IOtransfer(fd,(char *)B->data,B->bytes,B->offset,BINARYIO_WRITE);
+    if ( todo.size() && ::fsync(fd) != 0 ) ok = false;
+    for(auto B : todo){
+      uint64_t ent[IndexWords] = { B->offset, B->bytes, B->crc, 1 };
+      ok = ok && IOtransfer(fd,(char *)ent,sizeof(ent),index_start+B->entry*sizeof(ent),BINARYIO_WRITE);
+      stats.written++;
+      stats.bytes += B->bytes;
+    }
+    if ( todo.size() && ::fsync(fd) != 0 ) ok = false;
+    if ( !ok ) IOabort("Write failed on",file);
+    ::close(fd);
+
+    grid->GlobalSum(stats.written);
+    grid->GlobalSum(stats.kept);
+    grid->GlobalSum(stats.bytes);
+    timer.Stop();
+    stats.time = timer.useconds();
+    std::cout << GridLogMessage << "BlockIO: " << file << " " << type << " wrote " << stats.written
+	      << " blocks (" << stats.bytes << " bytes), kept " << stats.kept << " intact blocks, in "
+	      << timer.Elapsed() << std::endl;
+    return stats;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Collective read; unpack(lidx,const char *site). Returns the extra record.
+  /////////////////////////////////////////////////////////////////////////////
+  template<class unpacker>
+  static inline std::vector<char> readBlocks(GridBase *grid,const std::string &file,const std::string &type,
+					     uint32_t bytes_per_site,unpacker unpack)
+  {
+    GridStopWatch timer;
+    timer.Start();
+
+    // Header from the boss
+    uint64_t xml_bytes = 0;
+    std::vector<char> xmlbuf;
+    if ( grid->IsBoss() ) {
+      int fd = ::open(file.c_str(),O_RDONLY);
+      if ( fd < 0 ) IOabort("Error in opening the file for input",file);
+      char magic[8];
+      bool ok = IOtransfer(fd,magic,8,0,BINARYIO_READ);
+      ok = ok && IOtransfer(fd,(char *)&xml_bytes,8,8,BINARYIO_READ);
+      if ( !ok || strncmp(magic,"GRIDBLK1",8) ) IOabort("Not a Grid block file",file);
+      xmlbuf.resize(xml_bytes);
+      if ( !IOtransfer(fd,&xmlbuf[0],xml_bytes,16,BINARYIO_READ) ) IOabort("Read failed on",file);
+      ::close(fd);
+    }
+    grid->Broadcast(grid->BossRank(),(void *)&xml_bytes,sizeof(xml_bytes));
+    xmlbuf.resize(xml_bytes);
+    grid->Broadcast(grid->BossRank(),(void *)&xmlbuf[0],xml_bytes);
+    std::string xml(xmlbuf.begin(),xmlbuf.end());
+    GridBlockHeader header;
+    {
+      XmlReader RD(xml, true, "");
+      read(RD,"GridBlockHeader",header);
+    }
+    GridBlockHeader expect = layout(grid,type,bytes_per_site,header.extra_bytes,1);
+    if ( header.data_type != type || header.bytes_per_site != bytes_per_site
+	 || header.dimension != expect.dimension || header.processors != expect.processors
+	 || header.byte_order != expect.byte_order ) {
+      std::cout << GridLogError << "BlockIO: " << file << " holds " << header.data_type << " on processor grid "
+		<< header.processors << "; expected " << type << " on " << expect.processors << std::endl;
+      IOabort("Incompatible block file",file);
+    }
+
+    int      myrank = grid->ThisRank();
+    uint64_t nb     = header.blocks_per_rank;
+    uint64_t nblocks= nb*grid->ProcessorCount();
+    uint64_t index_start = 16+xml_bytes;
+    uint64_t data_start  = index_start + (nblocks+1)*IndexWords*sizeof(uint64_t);
+    uint64_t rank_bytes  = grid->lSites()*bytes_per_site;
+    uint64_t extra_start = data_start + grid->ProcessorCount()*rank_bytes;
+
+    int fd = ::open(file.c_str(),O_RDONLY);
+    if ( fd < 0 ) IOabort("Error in opening the file for input",file);
+    std::vector<uint64_t> index(nb*IndexWords);
+    if ( !IOtransfer(fd,(char *)&index[0],index.size()*sizeof(uint64_t),
+		     index_start+myrank*nb*IndexWords*sizeof(uint64_t),BINARYIO_READ) ) IOabort("Read failed on",file);
+
+    uint32_t bad = 0;
+    std::vector<char> buf;
+    for(uint64_t k=0;k<nb;k++){
+      uint64_t site0,nsites;
+      blockSites(grid,header,k,site0,nsites);
+      uint64_t *ent   = &index[k*IndexWords];
+      uint64_t offset = data_start + myrank*rank_bytes + site0*bytes_per_site;
+      uint64_t bytes  = nsites*bytes_per_site;
+      buf.resize(bytes);
+      bool ok = (ent[3]==1) && (ent[0]==offset) && (ent[1]==bytes);
+      ok = ok && IOtransfer(fd,&buf[0],bytes,offset,BINARYIO_READ);
+      ok = ok && (GridChecksum::crc32c(&buf[0],bytes)==ent[2]);
+      if ( !ok ) {
+	std::cout << GridLogError << "BlockIO: " << file << " block " << myrank*nb+k << " (rank " << myrank
+		  << " sites " << site0 << "-" << site0+nsites-1 << ") " << (ent[3]==1 ? "is corrupt" : "is missing")
+		  << std::endl;
+	bad++;
+	continue;
+      }
+      char *b = &buf[0];
+      thread_for(s,nsites,{ unpack(site0+s,b+s*bytes_per_site); });
+    }
+
+    std::vector<char> extra(header.extra_bytes);
+    if ( header.extra_bytes ) {
+      uint64_t ent[IndexWords];
+      bool ok = IOtransfer(fd,(char *)ent,sizeof(ent),index_start+nblocks*sizeof(ent),BINARYIO_READ);
+      ok = ok && IOtransfer(fd,&extra[0],extra.size(),extra_start,BINARYIO_READ);
+      ok = ok && ent[3]==1 && GridChecksum::crc32c(&extra[0],extra.size())==ent[2];
+      if ( !ok && grid->IsBoss() ) {
+	std::cout << GridLogError << "BlockIO: " << file << " extra record is corrupt" << std::endl;
+	bad++;
+      }
+    }
+    ::close(fd);
+
+    grid->GlobalSum(bad);
+    if ( bad ) {
+      std::cout << GridLogError << "BlockIO: " << bad << " bad block(s) in " << file << std::endl;
+      IOabort("Corrupt block file",file);
+    }
+    timer.Stop();
+    std::cout << GridLogMessage << "BlockIO: read " << file << " " << type << " " << nblocks << " blocks in "
+	      << timer.Elapsed() << std::endl;
+    return extra;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Lattice fields, stored as fobj (e.g. the double precision scalar object)
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj,class fobj>
+  static inline BlockStats writeLatticeBlocks(Lattice<vobj> &field,const std::string &file,uint64_t blockBytes=8*1024*1024)
+  {
+    typedef typename vobj::scalar_object sobj;
+    GridBase *grid = field.Grid();
+    assert(!grid->_isCheckerBoarded);
+    BinarySimpleUnmunger<fobj,sobj> munge;
+    autoView(f_v,field,CpuRead);
+    auto pack = [&](uint64_t lidx,char *site) {
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(lidx,lcoor);
+      sobj s = extractLane(grid->iIndex(lcoor),f_v[grid->oIndex(lcoor)]);
+      munge(s,*(fobj *)site);
+    };
+    std::vector<char> none;
+    return writeBlocks(grid,file,getFormatString<vobj>(),sizeof(fobj),pack,none,blockBytes);
+  }
+  template<class vobj,class fobj>
+  static inline void readLatticeBlocks(Lattice<vobj> &field,const std::string &file)
+  {
+    typedef typename vobj::scalar_object sobj;
+    GridBase *grid = field.Grid();
+    assert(!grid->_isCheckerBoarded);
+    BinarySimpleMunger<fobj,sobj> munge;
+    autoView(f_v,field,CpuWrite);
+    auto unpack = [&](uint64_t lidx,const char *site) {
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(lidx,lcoor);
+      fobj f;
+      memcpy((void *)&f,site,sizeof(fobj));
+      sobj s;
+      munge(f,s);
+      insertLane(grid->iIndex(lcoor),f_v[grid->oIndex(lcoor)],s);
+    };
+    readBlocks(grid,file,getFormatString<vobj>(),sizeof(fobj),unpack);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Parallel RNG per site, serial RNG as the extra record. A counter based
+  // parallel RNG is a few words; it goes in BinaryIO's compact form instead.
+  /////////////////////////////////////////////////////////////////////////////
+  static inline BlockStats writeRNGBlocks(GridSerialRNG &serial_rng,GridParallelRNG &parallel_rng,
+					  const std::string &file,uint64_t blockBytes=8*1024*1024)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    GridBase *grid = parallel_rng.Grid();
+    if ( parallel_rng.CounterBased() ) {
+      uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+      BlockStats stats;
+      GridStopWatch timer; timer.Start();
+      BinaryIO::writeRNG(serial_rng,parallel_rng,file,0,nersc_csum,scidac_csuma,scidac_csumb);
+      timer.Stop();
+      stats.time = timer.useconds();
+      return stats;
+    }
+    auto pack = [&](uint64_t lidx,char *site) {
+      std::vector<RngStateType> tmp(RngStateCount);
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(lidx,lcoor);
+      parallel_rng.GetState(tmp,parallel_rng.generator_idx(grid->oIndex(lcoor),grid->iIndex(lcoor)));
+      memcpy(site,&tmp[0],RngStateCount*sizeof(RngStateType));
+    };
+    std::vector<char> extra;
+    if ( grid->IsBoss() ) {
+      std::vector<RngStateType> tmp(RngStateCount);
+      serial_rng.GetState(tmp,0);
+      extra.resize(RngStateCount*sizeof(RngStateType));
+      memcpy(&extra[0],&tmp[0],extra.size());
+    }
+    return writeBlocks(grid,file,std::string("GridRNG"),RngStateCount*sizeof(RngStateType),pack,extra,blockBytes);
+  }
+  static inline void readRNGBlocks(GridSerialRNG &serial_rng,GridParallelRNG &parallel_rng,const std::string &file)
+  {
+    typedef typename GridSerialRNG::RngStateType RngStateType;
+    const int RngStateCount = GridSerialRNG::RngStateCount;
+    GridBase *grid = parallel_rng.Grid();
+    if ( BinaryIO::isCounterRNG(grid,file,0) ) {
+      uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+      BinaryIO::readRNG(serial_rng,parallel_rng,file,0,nersc_csum,scidac_csuma,scidac_csumb);
+      return;
+    }
+    auto unpack = [&](uint64_t lidx,const char *site) {
+      std::vector<RngStateType> tmp(RngStateCount);
+      memcpy(&tmp[0],site,RngStateCount*sizeof(RngStateType));
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(lidx,lcoor);
+      parallel_rng.SetState(tmp,parallel_rng.generator_idx(grid->oIndex(lcoor),grid->iIndex(lcoor)));
+    };
+    std::vector<char> extra = readBlocks(grid,file,std::string("GridRNG"),RngStateCount*sizeof(RngStateType),unpack);
+    std::vector<RngStateType> tmp(RngStateCount);
+    assert(extra.size()==RngStateCount*sizeof(RngStateType));
+    memcpy(&tmp[0],&extra[0],extra.size());
+    serial_rng.SetState(tmp,0);
+  }
+};
+
+NAMESPACE_END(Grid);
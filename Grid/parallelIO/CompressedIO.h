@@ -0,0 +1,536 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/CompressedIO.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <zlib.h>
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Grid native compressed lattice container
+//
+//   "GRIDCMP1"                               8 byte magic
+//   uint64_t xml_bytes
+//   <GridCompressedHeader> xml
+//   uint64_t index[nblocks][CompressedIO::indexWords(nd)]
+//   block payloads
+//
+// Every writing rank cuts its sub-volume into blocks of whole slabs of the
+// slowest dimension. Each index entry carries the global box of its block, so
+// a file can be read back on any decomposition. Within a block, sites are
+// encoded (optionally with SU(3) link reconstruction and 32 bit words), byte
+// shuffled, deflated and crc32c summed. Blocks are independent and are encoded
+// and decoded in parallel over threads as well as ranks.
+////////////////////////////////////////////////////////////////////////////////
+class GridCompressedHeader : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(GridCompressedHeader,
+				  double, version,
+				  std::string, data_type,
+				  int, nd,
+				  std::vector<int>, dimension,
+				  int, precision,
+				  int, reconstruct,
+				  std::string, compression,
+				  int, level,
+				  uint32_t, nblocks,
+				  std::string, byte_order,
+				  double, norm2);
+  GridCompressedHeader(void) : version(1.0), nd(0), precision(64), reconstruct(0), level(1), nblocks(0), norm2(0.) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Site codecs: map a scalar object to a run of reals and back.
+// reconstruct==0 stores every real; the gauge codec also offers 12 and 8 real
+// SU(3) links (two rows; or a2,a3,b1 plus the phases of a1 and c1). encode
+// returns false when a site cannot be represented to reconstructTolerance in
+// the requested form, and the writer then falls back for that block.
+////////////////////////////////////////////////////////////////////////////////
+template<class sobj> struct CompressedSiteCodec {
+  typedef typename getPrecision<sobj>::real_scalar_type Real;
+  static const int reals = sizeof(sobj)/sizeof(Real);
+
+  static std::string dataType(void)  { return std::string("generic"); }
+  static int  words(int recon)       { assert(recon==0); return reals; }
+  static int  fallback(int recon)    { return 0; }
+  static bool encode(const sobj &s,RealD *w,int recon) {
+    const Real *r = (const Real *)&s;
+    for(int i=0;i<reals;i++) w[i] = r[i];
+    return true;
+  }
+  static void decode(const RealD *w,sobj &s,int recon) {
+    Real *r = (Real *)&s;
+    for(int i=0;i<reals;i++) r[i] = w[i];
+  }
+};
+
+template<class T> struct CompressedSiteCodec<iVector<iScalar<iMatrix<T,Nc> >,Nd> > {
+  typedef iVector<iScalar<iMatrix<T,Nc> >,Nd> sobj;
+  typedef typename getPrecision<sobj>::real_scalar_type Real;
+  static const int reals = sizeof(sobj)/sizeof(Real);
+  static constexpr double reconstructTolerance  = 1.0e-10;
+  static constexpr double reconstruct8Threshold = 1.0e-4;
+
+  static std::string dataType(void) { return std::string("4D_SU")+std::to_string(Nc)+std::string("_GAUGE"); }
+  static int  words(int recon)      { return recon ? Nd*recon : reals; }
+  static int  fallback(int recon)   { return (recon==8) ? 12 : 0; }
+
+  static bool encode(const sobj &s,RealD *w,int recon) {
+    if ( recon==0 ) {
+      const Real *r = (const Real *)&s;
+      for(int i=0;i<reals;i++) w[i] = r[i];
+      return true;
+    }
+    assert(Nc==3);
+    for(int mu=0;mu<Nd;mu++){
+      RealD *l = w+mu*recon;
+      auto  &m = s(mu)();
+      if ( recon==12 ) {
+	for(int i=0;i<2;i++){
+	for(int j=0;j<3;j++){
+	  ComplexD z = m(i,j);
+	  l[2*(3*i+j)  ] = real(z);
+	  l[2*(3*i+j)+1] = imag(z);
+	}}
+      } else {
+	assert(recon==8);
+	ComplexD a1 = m(0,0), a2 = m(0,1), a3 = m(0,2), b1 = m(1,0), c1 = m(2,0);
+	if ( real(a2*conj(a2)+a3*conj(a3)) < reconstruct8Threshold ) return false;
+	l[0] = real(a2); l[1] = imag(a2);
+	l[2] = real(a3); l[3] = imag(a3);
+	l[4] = real(b1); l[5] = imag(b1);
+	l[6] = std::atan2(imag(a1),real(a1));
+	l[7] = std::atan2(imag(c1),real(c1));
+      }
+    }
+    // Only trust a reconstruction that gives the link back
+    sobj r;
+    decode(w,r,recon);
+    for(int mu=0;mu<Nd;mu++){
+      for(int i=0;i<Nc;i++){
+      for(int j=0;j<Nc;j++){
+	ComplexD d = ComplexD(r(mu)()(i,j)) - ComplexD(s(mu)()(i,j));
+	if ( real(d*conj(d)) > reconstructTolerance*reconstructTolerance ) return false;
+      }}
+    }
+    return true;
+  }
+
+  static void decode(const RealD *w,sobj &s,int recon) {
+    if ( recon==0 ) {
+      Real *r = (Real *)&s;
+      for(int i=0;i<reals;i++) r[i] = w[i];
+      return;
+    }
+    for(int mu=0;mu<Nd;mu++){
+      const RealD *l = w+mu*recon;
+      ComplexD a1,a2,a3,b1,b2,b3;
+      if ( recon==12 ) {
+	a1 = ComplexD(l[0],l[1]);  a2 = ComplexD(l[2],l[3]);  a3 = ComplexD(l[4],l[5]);
+	b1 = ComplexD(l[6],l[7]);  b2 = ComplexD(l[8],l[9]);  b3 = ComplexD(l[10],l[11]);
+      } else {
+	a2 = ComplexD(l[0],l[1]);
+	a3 = ComplexD(l[2],l[3]);
+	b1 = ComplexD(l[4],l[5]);
+	RealD row = real(a2*conj(a2)+a3*conj(a3));
+	RealD a1m = std::sqrt(std::max(0.0,1.0-row));
+	a1 = ComplexD(a1m*std::cos(l[6]),a1m*std::sin(l[6]));
+	RealD c1m = std::sqrt(std::max(0.0,1.0-a1m*a1m-real(b1*conj(b1))));
+	ComplexD c1(c1m*std::cos(l[7]),c1m*std::sin(l[7]));
+	// Second row from orthogonality to the first and (row0 x row1)^* = row2
+	b2 = -(conj(c1)*conj(a3) + a2*b1*conj(a1))/row;
+	b3 =  (conj(c1)*conj(a2) - a3*b1*conj(a1))/row;
+      }
+      auto &m = s(mu)();
+      m(0,0) = a1; m(0,1) = a2; m(0,2) = a3;
+      m(1,0) = b1; m(1,1) = b2; m(1,2) = b3;
+      m(2,0) = conj(a2*b3-a3*b2);
+      m(2,1) = conj(a3*b1-a1*b3);
+      m(2,2) = conj(a1*b2-a2*b1);
+    }
+  }
+};
+
+class CompressedIO : public BinaryIO {
+public:
+
+  static const int BLOCK_DEFLATED = 0x1;
+
+  // offset, stored bytes, encoded bytes, crc32c, flags|recon<<8, start[nd], extent[nd]
+  static inline int indexWords(int nd) { return 5+2*nd; }
+
+  static inline std::string hostByteOrder(void) {
+#if BYTE_ORDER == BIG_ENDIAN
+    return std::string("big");
+#else
+    return std::string("little");
+#endif
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Byte shuffle: gather byte b of every word together; floating point data
+  // deflates far better once exponents and mantissa bytes are grouped.
+  /////////////////////////////////////////////////////////////////////////////
+  static inline void shuffle(const unsigned char *in,unsigned char *out,uint64_t nword,int wordbytes)
+  {
+    for(uint64_t i=0;i<nword;i++)
+      for(int b=0;b<wordbytes;b++) out[b*nword+i] = in[i*wordbytes+b];
+  }
+  static inline void unshuffle(const unsigned char *in,unsigned char *out,uint64_t nword,int wordbytes)
+  {
+    for(uint64_t i=0;i<nword;i++)
+      for(int b=0;b<wordbytes;b++) out[i*wordbytes+b] = in[b*nword+i];
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Write; precision 32 or 64 bit words, reconstruct 0/12/8 (gauge fields),
+  // level 0 stores blocks uncompressed, 1..9 is the deflate level.
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  static inline void writeField(Lattice<vobj> &field,const std::string &file,
+				int precision=64,int reconstruct=0,int level=1,
+				uint64_t blockBytes=4*1024*1024)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef CompressedSiteCodec<sobj> Codec;
+
+    GridBase *grid = field.Grid();
+    assert(grid->_isCheckerBoarded==0);
+    assert(precision==32 || precision==64);
+    int nd      = grid->Nd();
+    int nrank   = grid->ProcessorCount();
+    int myrank  = grid->ThisRank();
+    int es      = precision/8;
+    int NW      = indexWords(nd);
+    Codec::words(reconstruct); // rejects reconstruction of non gauge objects
+
+    GridStopWatch encodeTimer, ioTimer;
+
+    Coordinate lLattice = grid->LocalDimensions();
+    Coordinate lStart   = grid->LocalStarts();
+    uint64_t lsites = grid->lSites();
+    uint64_t nslab  = lLattice[nd-1];
+    uint64_t slab   = lsites/nslab;
+    uint64_t per    = std::max<uint64_t>(1,std::min<uint64_t>(nslab,blockBytes/(slab*sizeof(sobj))));
+    uint64_t nb     = (nslab+per-1)/per;
+    uint64_t nblock = nb*nrank;
+
+    GridCompressedHeader header;
+    header.data_type   = Codec::dataType();
+    header.nd          = nd;
+    header.dimension   = std::vector<int>(grid->FullDimensions().toVector());
+    header.precision   = precision;
+    header.reconstruct = reconstruct;
+    header.compression = level ? std::string("shuffle-deflate") : std::string("none");
+    header.level       = level;
+    header.nblocks     = nblock;
+    header.byte_order  = hostByteOrder();
+    header.norm2       = norm2(field);
+
+    //////////////////////////////////////////////
+    // Encode my blocks, threaded over blocks
+    //////////////////////////////////////////////
+    std::vector<std::vector<unsigned char> > payload(nb);
+    std::vector<uint64_t> index(nblock*NW,0);
+    encodeTimer.Start();
+    {
+      autoView(f_v,field,CpuRead);
+      thread_for(k,nb,{
+	uint64_t t0    = k*per;
+	uint64_t nsite = std::min(per,nslab-t0)*slab;
+	uint64_t site0 = t0*slab;
+
+	std::vector<sobj> sites(nsite);
+	for(uint64_t x=0;x<nsite;x++){
+	  Coordinate lcoor;
+	  grid->LocalIndexToLocalCoor(site0+x,lcoor);
+	  sites[x] = extractLane(grid->iIndex(lcoor),f_v[grid->oIndex(lcoor)]);
+	}
+
+	int recon = reconstruct;
+	std::vector<RealD> w;
+	for(bool ok=false;!ok;){
+	  int nw = Codec::words(recon);
+	  w.resize(nsite*nw);
+	  ok = true;
+	  for(uint64_t x=0;ok && x<nsite;x++) ok = Codec::encode(sites[x],&w[x*nw],recon);
+	  if ( !ok ) recon = Codec::fallback(recon);
+	}
+
+	uint64_t nword = w.size();
+	std::vector<unsigned char> raw(nword*es);
+	if ( precision==32 ) for(uint64_t i=0;i<nword;i++) ((RealF *)&raw[0])[i] = w[i];
+	else                 for(uint64_t i=0;i<nword;i++) ((RealD *)&raw[0])[i] = w[i];
+
+	int flags = 0;
+	std::vector<unsigned char> &out = payload[k];
+	if ( level ) {
+	  std::vector<unsigned char> shuf(raw.size());
+	  shuffle(&raw[0],&shuf[0],nword,es);
+	  uLongf zbytes = compressBound(shuf.size());
+	  out.resize(zbytes);
+	  int err = compress2(&out[0],&zbytes,&shuf[0],shuf.size(),level);
+	  assert(err==Z_OK);
+	  if ( zbytes < raw.size() ) {
+	    out.resize(zbytes);
+	    flags |= BLOCK_DEFLATED;
+	  }
+	}
+	if ( !(flags & BLOCK_DEFLATED) ) out = raw;
+
+	uint64_t *ent = &index[(myrank*nb+k)*NW];
+	ent[1] = out.size();
+	ent[2] = raw.size();
+	ent[3] = GridChecksum::crc32c(&out[0],out.size());
+	ent[4] = flags | (recon<<8);
+	for(int d=0;d<nd;d++){
+	  ent[5+d]    = lStart[d] + ((d==nd-1) ? t0 : 0);
+	  ent[5+nd+d] = (d==nd-1) ? nsite/slab : lLattice[d];
+	}
+      });
+    }
+    encodeTimer.Stop();
+
+    //////////////////////////////////////////////
+    // Everyone learns every entry and lays out
+    // the file in block order
+    //////////////////////////////////////////////
+    grid->GlobalSumVector(&index[0],index.size());
+
+    XmlWriter WR("","");
+    write(WR,"GridCompressedHeader",header);
+    std::string xml = WR.docString();
+    uint64_t xml_bytes = xml.size();
+    uint64_t offset = 16 + xml_bytes + index.size()*sizeof(uint64_t);
+    uint64_t stored = 0, encoded = 0;
+    for(uint64_t b=0;b<nblock;b++){
+      index[b*NW] = offset;
+      offset  += index[b*NW+1];
+      stored  += index[b*NW+1];
+      encoded += index[b*NW+2];
+    }
+
+    ioTimer.Start();
+    if ( grid->IsBoss() ) {
+      int fd = ::open(file.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+      if ( fd < 0 ) IOabort("Error in opening the file for output",file);
+      bool ok = IOtransfer(fd,(char *)"GRIDCMP1",8,0,BINARYIO_WRITE);
+      ok = ok && IOtransfer(fd,(char *)&xml_bytes,sizeof(uint64_t),8,BINARYIO_WRITE);
+      ok = ok && IOtransfer(fd,&xml[0],xml_bytes,16,BINARYIO_WRITE);
+      ok = ok && IOtransfer(fd,(char *)&index[0],index.size()*sizeof(uint64_t),16+xml_bytes,BINARYIO_WRITE);
+      if ( !ok ) IOabort("Write failed on",file);
+      ::close(fd);
+    }
+    grid->Barrier();
+    {
+      int fd = ::open(file.c_str(),O_WRONLY);
+      if ( fd < 0 ) IOabort("Error in opening the file for output",file);
+      bool ok = true;
+      for(uint64_t k=0;ok && k<nb;k++){
+	uint64_t b = myrank*nb+k;
+	ok = IOtransfer(fd,(char *)&payload[k][0],payload[k].size(),index[b*NW],BINARYIO_WRITE);
+      }
+      if ( !ok ) IOabort("Write failed on",file);
+      if ( ::fsync(fd) != 0 ) IOabort("fsync failed on",file);
+      ::close(fd);
+    }
+    grid->Barrier();
+    ioTimer.Stop();
+
+    std::cout << GridLogMessage << "CompressedIO: wrote " << file << " " << header.data_type
+	      << " fp" << precision << " reconstruct " << reconstruct << " " << nblock << " blocks, "
+	      << stored << " bytes stored for " << sizeof(sobj)*grid->gSites() << " bytes of field ("
+	      << encoded << " encoded)" << std::endl;
+    std::cout << GridLogMessage << "CompressedIO: encode " << encodeTimer.Elapsed()
+	      << " I/O " << ioTimer.Elapsed() << std::endl;
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Read on any decomposition; each rank decodes the blocks meeting its
+  // sub-volume, threaded over blocks
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  static inline void readField(Lattice<vobj> &field,const std::string &file)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef CompressedSiteCodec<sobj> Codec;
+
+    GridBase *grid = field.Grid();
+    assert(grid->_isCheckerBoarded==0);
+    int nd = grid->Nd();
+    int NW = indexWords(nd);
+    GridStopWatch decodeTimer;
+
+    //////////////////////////////////////////////
+    // Boss reads header and index, broadcasts
+    //////////////////////////////////////////////
+    uint64_t meta_bytes = 0;
+    uint64_t xml_len    = 0;
+    std::vector<char> meta;
+    if ( grid->IsBoss() ) {
+      int fd = ::open(file.c_str(),O_RDONLY);
+      if ( fd < 0 ) IOabort("Error in opening the file for input",file);
+      char magic[8];
+      uint64_t xml_bytes;
+      bool ok = IOtransfer(fd,magic,8,0,BINARYIO_READ);
+      ok = ok && IOtransfer(fd,(char *)&xml_bytes,sizeof(uint64_t),8,BINARYIO_READ);
+      if ( !ok || strncmp(magic,"GRIDCMP1",8) ) IOabort("Not a Grid compressed lattice file",file);
+      meta.resize(xml_bytes);
+      ok = IOtransfer(fd,&meta[0],xml_bytes,16,BINARYIO_READ);
+      std::string xml(meta.begin(),meta.end());
+      XmlReader RD(xml, true, "");
+      GridCompressedHeader header;
+      read(RD,"GridCompressedHeader",header);
+      uint64_t index_bytes = (uint64_t)header.nblocks*NW*sizeof(uint64_t);
+      meta.resize(xml_bytes+index_bytes);
+      ok = ok && IOtransfer(fd,&meta[xml_bytes],index_bytes,16+xml_bytes,BINARYIO_READ);
+      if ( !ok ) IOabort("Read failed on",file);
+      ::close(fd);
+      meta_bytes = meta.size();
+      xml_len    = xml_bytes;
+    }
+    grid->Broadcast(0,(void *)&meta_bytes,sizeof(meta_bytes));
+    grid->Broadcast(0,(void *)&xml_len,sizeof(xml_len));
+    meta.resize(meta_bytes);
+    grid->Broadcast(0,(void *)&meta[0],meta_bytes);
+
+    // meta holds the xml followed by the (unaligned) index
+    std::string xml(meta.begin(),meta.begin()+xml_len);
+    XmlReader RD(xml, true, "");
+    GridCompressedHeader header;
+    read(RD,"GridCompressedHeader",header);
+    std::vector<uint64_t> index((meta_bytes-xml_len)/sizeof(uint64_t));
+    std::memcpy(&index[0],&meta[xml_len],index.size()*sizeof(uint64_t));
+
+    assert(header.byte_order == hostByteOrder());
+    assert(header.data_type  == Codec::dataType());
+    assert(header.nd == nd);
+    for(int d=0;d<nd;d++) assert(header.dimension[d]==grid->FullDimensions()[d]);
+    int es = header.precision/8;
+
+    //////////////////////////////////////////////
+    // Blocks meeting this rank's sub-volume
+    //////////////////////////////////////////////
+    Coordinate lLattice = grid->LocalDimensions();
+    Coordinate lStart   = grid->LocalStarts();
+    std::vector<uint64_t> mine;
+    for(uint64_t b=0;b<header.nblocks;b++){
+      const uint64_t *ent = &index[b*NW];
+      bool meets = true;
+      for(int d=0;d<nd;d++){
+	uint64_t lo = std::max<uint64_t>(ent[5+d],lStart[d]);
+	uint64_t hi = std::min<uint64_t>(ent[5+d]+ent[5+nd+d],lStart[d]+lLattice[d]);
+	if ( lo >= hi ) meets = false;
+      }
+      if ( meets ) mine.push_back(b);
+    }
+
+    int fd = ::open(file.c_str(),O_RDONLY);
+    if ( fd < 0 ) IOabort("Error in opening the file for input",file);
+    uint32_t failed = 0;
+    decodeTimer.Start();
+    {
+      autoView(f_v,field,CpuWrite);
+      uint64_t nmine = mine.size();
+      thread_for(m,nmine,{
+	const uint64_t *ent = &index[mine[m]*NW];
+	int      flags = ent[4] & 0xFF;
+	int      recon = ent[4] >> 8;
+	Coordinate bstart(nd), bext(nd);
+	uint64_t nsite = 1;
+	for(int d=0;d<nd;d++) { bstart[d] = ent[5+d]; bext[d] = ent[5+nd+d]; nsite *= bext[d]; }
+	int      nw    = Codec::words(recon);
+	uint64_t nword = nsite*nw;
+
+	std::vector<unsigned char> in(ent[1]);
+	std::vector<unsigned char> raw(ent[2]);
+	bool ok = IOtransfer(fd,(char *)&in[0],in.size(),ent[0],BINARYIO_READ);
+	ok = ok && (GridChecksum::crc32c(&in[0],in.size()) == ent[3]);
+	ok = ok && (raw.size() == nword*es);
+	if ( ok && (flags & BLOCK_DEFLATED) ) {
+	  std::vector<unsigned char> shuf(raw.size());
+	  uLongf zbytes = shuf.size();
+	  ok = (uncompress(&shuf[0],&zbytes,&in[0],in.size())==Z_OK) && (zbytes==shuf.size());
+	  if ( ok ) unshuffle(&shuf[0],&raw[0],nword,es);
+	} else if ( ok ) {
+	  raw = in;
+	}
+	if ( !ok ) {
+	  thread_critical { failed++; }
+	} else {
+	  std::vector<RealD> w(nw);
+	  Coordinate bcoor(nd), lcoor(nd);
+	  for(uint64_t x=0;x<nsite;x++){
+	    Lexicographic::CoorFromIndex(bcoor,x,bext);
+	    bool local = true;
+	    for(int d=0;d<nd;d++){
+	      lcoor[d] = bstart[d] + bcoor[d] - lStart[d];
+	      if ( lcoor[d] < 0 || lcoor[d] >= lLattice[d] ) local = false;
+	    }
+	    if ( !local ) continue;
+	    if ( es==4 ) for(int i=0;i<nw;i++) w[i] = ((RealF *)&raw[0])[x*nw+i];
+	    else         for(int i=0;i<nw;i++) w[i] = ((RealD *)&raw[0])[x*nw+i];
+	    sobj s;
+	    Codec::decode(&w[0],s,recon);
+	    insertLane(grid->iIndex(lcoor),f_v[grid->oIndex(lcoor)],s);
+	  }
+	}
+      });
+    }
+    decodeTimer.Stop();
+    ::close(fd);
+
+    grid->GlobalSum(failed);
+    if ( failed ) {
+      std::cout << GridLogError << "CompressedIO: " << failed << " corrupt block(s) in " << file << std::endl;
+      assert(0);
+    }
+    RealD n2 = norm2(field);
+    RealD rdiff = 0.5*fabs(header.norm2-n2)/(header.norm2+n2);
+    std::cout << GridLogMessage << "CompressedIO: read " << file << " " << header.data_type
+	      << " fp" << header.precision << " reconstruct " << header.reconstruct
+	      << " decoded " << mine.size() << " of " << header.nblocks << " blocks in " << decodeTimer.Elapsed()
+	      << ", norm2 rdiff " << rdiff << std::endl;
+    assert(rdiff < 1.0e-5);
+  }
+
+  /////////////////////////////////////////////////////////////////////////////
+  // Gauge configurations default to the NERSC style two row storage
+  /////////////////////////////////////////////////////////////////////////////
+  template<class vsimd>
+  static inline void writeConfiguration(Lattice<iLorentzColourMatrix<vsimd> > &Umu,const std::string &file,
+					int reconstruct=12,int precision=64,int level=1)
+  {
+    writeField(Umu,file,precision,reconstruct,level);
+  }
+  template<class vsimd>
+  static inline void readConfiguration(Lattice<iLorentzColourMatrix<vsimd> > &Umu,const std::string &file)
+  {
+    readField(Umu,file);
+  }
+};
+
+NAMESPACE_END(Grid);
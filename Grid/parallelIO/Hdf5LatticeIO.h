@@ -0,0 +1,288 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/Hdf5LatticeIO.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#ifdef HAVE_HDF5
+
+////////////////////////////////////////////////////////////////////////////////
+// Lattice fields as HDF5 datasets.
+//
+// A field becomes a dataset of shape [L_{nd-1}]...[L_0][reals], x fastest as in
+// the lexicographic files, with attributes recording the lattice, site_reals
+// and norm2. Any number of fields can go into one file.
+//
+// Every rank selects the hyperslab of its sub-volume. Datasets are chunked on
+// the processor grid, so each rank owns whole chunks; this keeps compressed
+// (shuffle + deflate) datasets writable in parallel.
+//
+// With a parallel HDF5 build and MPI comms, the file is opened through MPI-IO
+// and transfers are collective. Otherwise ranks take turns on the file, which
+// keeps a serial HDF5 library usable (and testable) on any decomposition.
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined(H5_HAVE_PARALLEL) && defined(USE_MPI_IO)
+#define GRID_HDF5_PARALLEL
+#endif
+
+NAMESPACE_BEGIN(Grid);
+
+class Hdf5LatticeIO {
+public:
+  // Dataset and hyperslab of the local sub-volume, slowest dimension first
+  static inline void hyperslab(GridBase *grid,int reals,
+			       std::vector<hsize_t> &global,
+			       std::vector<hsize_t> &start,
+			       std::vector<hsize_t> &count)
+  {
+    int nd = grid->_ndimension;
+    global.resize(nd+1);
+    start .resize(nd+1);
+    count .resize(nd+1);
+    Coordinate gdims  = grid->FullDimensions();
+    Coordinate lstart = grid->LocalStarts();
+    Coordinate ldims  = grid->LocalDimensions();
+    for(int d=0;d<nd;d++){
+      global[nd-1-d] = gdims[d];
+      start [nd-1-d] = lstart[d];
+      count [nd-1-d] = ldims[d];
+    }
+    global[nd] = reals;
+    start [nd] = 0;
+    count [nd] = reals;
+  }
+
+  // One chunk per rank, halving the slowest dimensions to stay below the 4GB chunk limit
+  static inline std::vector<hsize_t> chunking(const std::vector<hsize_t> &count,size_t wordbytes)
+  {
+    std::vector<hsize_t> chunk(count);
+    const hsize_t MaxBytes = 0xffffffffULL;
+    for(int d=0;d<chunk.size()-1;d++){
+      hsize_t bytes = wordbytes;
+      for(auto c : chunk) bytes *= c;
+      while ( bytes > MaxBytes && (chunk[d]&1)==0 ) { chunk[d]>>=1; bytes>>=1; }
+    }
+    return chunk;
+  }
+
+  static inline H5NS::FileAccPropList accessList(GridBase *grid)
+  {
+    H5NS::FileAccPropList fapl;
+#ifdef GRID_HDF5_PARALLEL
+    H5Pset_fapl_mpio(fapl.getId(),grid->communicator,MPI_INFO_NULL);
+#endif
+    return fapl;
+  }
+
+  static inline H5NS::DSetMemXferPropList transferList(void)
+  {
+    H5NS::DSetMemXferPropList dxpl;
+#ifdef GRID_HDF5_PARALLEL
+    H5Pset_dxpl_mpio(dxpl.getId(),H5FD_MPIO_COLLECTIVE);
+#endif
+    return dxpl;
+  }
+
+  static inline bool collective(void)
+  {
+#ifdef GRID_HDF5_PARALLEL
+    return true;
+#else
+    return false;
+#endif
+  }
+};
+
+class Hdf5LatticeWriter : public Hdf5LatticeIO {
+public:
+  // deflate 0 disables compression; 1..9 applies shuffle + deflate at that level
+  Hdf5LatticeWriter(GridBase *_grid,const std::string &_file,int _deflate=0)
+    : grid(_grid), fileName(_file), deflate(_deflate)
+  {
+    if ( collective() ) {
+      file = H5NS::H5File(fileName.c_str(),H5F_ACC_TRUNC,H5NS::FileCreatPropList::DEFAULT,accessList(grid));
+    } else {
+      if ( grid->IsBoss() ) H5NS::H5File(fileName.c_str(),H5F_ACC_TRUNC);
+      grid->Barrier();
+    }
+#if defined(GRID_HDF5_PARALLEL) && !H5_VERSION_GE(1,10,2)
+    if ( deflate ) {
+      std::cout << GridLogWarning << "Hdf5LatticeWriter: parallel filters need HDF5 1.10.2, writing uncompressed" << std::endl;
+      deflate = 0;
+    }
+#endif
+  }
+  ~Hdf5LatticeWriter()
+  {
+    if ( collective() ) file.close();
+  }
+
+  ///////////////////////////////////////////////////////////////////
+  // precision 0 keeps the field's own; 32 or 64 converts on the fly
+  ///////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void writeField(const std::string &name,const Lattice<vobj> &field,int precision=0)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename getPrecision<sobj>::real_scalar_type Real;
+    GridBase *fgrid = field.Grid();
+    assert(fgrid->ProcessorCount()==grid->ProcessorCount());
+    assert(!fgrid->_isCheckerBoarded);
+    int reals = sizeof(sobj)/sizeof(Real);
+
+    std::vector<sobj> buf(fgrid->lSites());
+    unvectorizeToLexOrdArray(buf,field);
+    RealD nrm = norm2(field);
+
+    std::vector<hsize_t> global, start, count;
+    hyperslab(fgrid,reals,global,start,count);
+
+    H5NS::DataType ftype = Hdf5Type<Real>::type();
+    size_t wordbytes = sizeof(Real);
+    if ( precision==32 ) { ftype = Hdf5Type<float >::type(); wordbytes=4; }
+    if ( precision==64 ) { ftype = Hdf5Type<double>::type(); wordbytes=8; }
+
+    H5NS::DSetCreatPropList dcpl;
+    std::vector<hsize_t> chunk = chunking(count,wordbytes);
+    dcpl.setChunk(chunk.size(),chunk.data());
+    if ( deflate ) {
+      dcpl.setShuffle();
+      dcpl.setDeflate(deflate);
+    }
+
+    GridStopWatch timer;
+    timer.Start();
+    H5NS::DataSpace fspace(global.size(),global.data());
+    H5NS::DataSpace mspace(count.size(),count.data());
+    auto writeSlab = [&](H5NS::DataSet &dset) {
+      H5NS::DataSpace slab = dset.getSpace();
+      slab.selectHyperslab(H5S_SELECT_SET,count.data(),start.data());
+      dset.write(buf.data(),Hdf5Type<Real>::type(),mspace,slab,transferList());
+    };
+    auto attributes = [&](H5NS::DataSet &dset) {
+      std::vector<int> dims(fgrid->FullDimensions().toVector());
+      hsize_t ndim = dims.size();
+      hsize_t one  = 1;
+      dset.createAttribute("dimensions",Hdf5Type<int>::type(),H5NS::DataSpace(1,&ndim))
+	.write(Hdf5Type<int>::type(),dims.data());
+      dset.createAttribute("site_reals",Hdf5Type<int>::type(),H5NS::DataSpace(1,&one))
+	.write(Hdf5Type<int>::type(),&reals);
+      dset.createAttribute("norm2",Hdf5Type<double>::type(),H5NS::DataSpace(1,&one))
+	.write(Hdf5Type<double>::type(),&nrm);
+    };
+
+    if ( collective() ) {
+      // Dataset creation and attributes are collective metadata operations
+      H5NS::DataSet dset = file.createDataSet(name,ftype,fspace,dcpl);
+      attributes(dset);
+      writeSlab(dset);
+    } else {
+      for(int r=0;r<grid->ProcessorCount();r++){
+	if ( r == grid->ThisRank() ) {
+	  H5NS::H5File f(fileName.c_str(),H5F_ACC_RDWR);
+	  H5NS::DataSet dset;
+	  if ( grid->IsBoss() ) {
+	    dset = f.createDataSet(name,ftype,fspace,dcpl);
+	    attributes(dset);
+	  } else {
+	    dset = f.openDataSet(name);
+	  }
+	  writeSlab(dset);
+	}
+	grid->Barrier();
+      }
+    }
+    timer.Stop();
+
+    uint64_t bytes = fgrid->gSites()*reals*wordbytes;
+    std::cout << GridLogMessage << "Hdf5LatticeWriter: " << fileName << ":" << name << " "
+	      << bytes << " bytes in " << timer.Elapsed() << " "
+	      << (double)bytes/timer.useconds() << " MB/s" << (collective() ? " (collective)" : " (serial)") << std::endl;
+  }
+
+private:
+  GridBase    *grid;
+  std::string  fileName;
+  int          deflate;
+  H5NS::H5File file;
+};
+
+class Hdf5LatticeReader : public Hdf5LatticeIO {
+public:
+  Hdf5LatticeReader(GridBase *_grid,const std::string &_file)
+    : grid(_grid), fileName(_file)
+  {
+    // Read only access can be shared by every rank at once
+    file = H5NS::H5File(fileName.c_str(),H5F_ACC_RDONLY,H5NS::FileCreatPropList::DEFAULT,accessList(grid));
+  }
+  ~Hdf5LatticeReader() { file.close(); }
+
+  template<class vobj>
+  void readField(const std::string &name,Lattice<vobj> &field)
+  {
+    typedef typename vobj::scalar_object sobj;
+    typedef typename getPrecision<sobj>::real_scalar_type Real;
+    GridBase *fgrid = field.Grid();
+    assert(fgrid->ProcessorCount()==grid->ProcessorCount());
+    assert(!fgrid->_isCheckerBoarded);
+    int reals = sizeof(sobj)/sizeof(Real);
+
+    std::vector<hsize_t> global, start, count;
+    hyperslab(fgrid,reals,global,start,count);
+
+    H5NS::DataSet dset = file.openDataSet(name);
+    H5NS::DataSpace fspace = dset.getSpace();
+    std::vector<hsize_t> fdims(fspace.getSimpleExtentNdims());
+    fspace.getSimpleExtentDims(fdims.data());
+    assert(fdims == global);
+
+    GridStopWatch timer;
+    timer.Start();
+    std::vector<sobj> buf(fgrid->lSites());
+    H5NS::DataSpace mspace(count.size(),count.data());
+    fspace.selectHyperslab(H5S_SELECT_SET,count.data(),start.data());
+    // HDF5 converts to the field's precision
+    dset.read(buf.data(),Hdf5Type<Real>::type(),mspace,fspace,transferList());
+    vectorizeFromLexOrdArray(buf,field);
+    timer.Stop();
+
+    double nrm;
+    dset.openAttribute("norm2").read(Hdf5Type<double>::type(),&nrm);
+    RealD n2 = norm2(field);
+    RealD rdiff = (nrm==0.0) ? n2 : 0.5*fabs(nrm-n2)/(nrm+n2);
+    std::cout << GridLogMessage << "Hdf5LatticeReader: " << fileName << ":" << name << " in " << timer.Elapsed()
+	      << " norm2 rdiff " << rdiff << std::endl;
+    assert(rdiff < 1.0e-5);
+  }
+
+private:
+  GridBase    *grid;
+  std::string  fileName;
+  H5NS::H5File file;
+};
+
+NAMESPACE_END(Grid);
+
+#endif
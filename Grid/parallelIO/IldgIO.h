@@ -166,6 +166,14 @@ assert(GRID_FIELD_NORM_CALC(FieldNormMetaData_, n2ck) < 1.0e-5);
    return 1;
  }
 
+static int gridChecksumVerify(gridChecksum &gridChecksum_,uint64_t grid_csum)
+ {
+   if ( gridChecksum_.version != 1.0 ) return 1; // newer record; nothing we can check
+   uint64_t grid_checksum = stoull(gridChecksum_.sum,0,16);
+   if ( grid_csum != grid_checksum ) return 0;
+   return 1;
+ }
+
 ////////////////////////////////////////////////////////////////////////////////////
 // Lime, ILDG and Scidac I/O classes
 ////////////////////////////////////////////////////////////////////////////////////
@@ -209,8 +217,10 @@ class GridLimeReader : public BinaryIO {
   {
     typedef typename vobj::scalar_object sobj;
     scidacChecksum scidacChecksum_;
+    gridChecksum   gridChecksum_;
     FieldNormMetaData  FieldNormMetaData_;
     uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    uint64_t grid_csum;
 
     std::string format = getFormatString<vobj>();
 
@@ -237,13 +247,13 @@ class GridLimeReader : public BinaryIO {
 	uint64_t offset= ftello(File);
 	//	std::cout << " ReadLatticeObject from offset "<<offset << std::endl;
 	BinarySimpleMunger<sobj,sobj> munge;
-	BinaryIO::readLatticeObject< vobj, sobj >(field, filename, munge, offset, format,nersc_csum,scidac_csuma,scidac_csumb);
+	BinaryIO::readLatticeObject< vobj, sobj >(field, filename, munge, offset, format,nersc_csum,scidac_csuma,scidac_csumb,&grid_csum);
 	std::cout << GridLogMessage << "SciDAC checksum A " << std::hex << scidac_csuma << std::dec << std::endl;
 	std::cout << GridLogMessage << "SciDAC checksum B " << std::hex << scidac_csumb << std::dec << std::endl;
 	/////////////////////////////////////////////
 	// Insist checksum is next record
 	/////////////////////////////////////////////
-	readScidacChecksum(scidacChecksum_,FieldNormMetaData_);
+	bool haveGridChecksum = readScidacChecksum(scidacChecksum_,FieldNormMetaData_,gridChecksum_);
 	/////////////////////////////////////////////
 	// Verify checksums
 	/////////////////////////////////////////////
@@ -254,18 +264,42 @@ class GridLimeReader : public BinaryIO {
 	  GRID_FIELD_NORM_CHECK(FieldNormMetaData_,n2ck);
 	}
 	assert(scidacChecksumVerify(scidacChecksum_,scidac_csuma,scidac_csumb)==1);
+	if ( haveGridChecksum ) {
+	  std::cout << GridLogMessage << "Grid checksum " << std::hex << grid_csum << std::dec << std::endl;
+	  assert(gridChecksumVerify(gridChecksum_,grid_csum)==1);
+	}
 
 	// find out if next field is a GridFieldNorm
 	return;
       }
     }
   }
-  void readScidacChecksum(scidacChecksum     &scidacChecksum_,
-			  FieldNormMetaData  &FieldNormMetaData_)
+  ////////////////////////////////////////////
+  // Find a binary record without reading it, for lazy (mapped) access.
+  // Returns the payload offset; checksums are not verified.
+  ////////////////////////////////////////////
+  uint64_t locateLimeBinaryObject(std::string record_name,uint64_t &bytes)
+  {
+    while ( limeReaderNextRecord(LimeR) == LIME_SUCCESS ) { 
+      if ( !strncmp(limeReaderType(LimeR), record_name.c_str(),strlen(record_name.c_str()) )  ) {
+	bytes = limeReaderBytes(LimeR);
+	return ftello(File);
+      }
+    }
+    std::cerr << "record '" << record_name << "' not found in '" << filename << "'" << std::endl;
+    abort();
+    return 0;
+  }
+  // Returns whether the optional grid-checksum record was present
+  bool readScidacChecksum(scidacChecksum     &scidacChecksum_,
+			  FieldNormMetaData  &FieldNormMetaData_,
+			  gridChecksum       &gridChecksum_)
   {
+    bool haveGridChecksum = false;
     FieldNormMetaData_.norm2 =0.0;
     std::string scidac_str(SCIDAC_CHECKSUM);
     std::string field_norm_str(GRID_FIELD_NORM);
+    std::string grid_csum_str(GRID_CHECKSUM);
     while ( limeReaderNextRecord(LimeR) == LIME_SUCCESS ) { 
       uint64_t nbytes = limeReaderBytes(LimeR);//size of this record (configuration)
       std::vector<char> xmlc(nbytes+1,'\0');
@@ -276,13 +310,18 @@ class GridLimeReader : public BinaryIO {
 	//	std::cout << "FieldNormMetaData "<<xmlstring<<std::endl;
 	read(RD,field_norm_str,FieldNormMetaData_);
       }
+      if ( !strncmp(limeReaderType(LimeR), grid_csum_str.c_str(),strlen(grid_csum_str.c_str()) )  ) {
+	read(RD,std::string("gridChecksum"),gridChecksum_);
+	haveGridChecksum = true;
+      }
       if ( !strncmp(limeReaderType(LimeR), scidac_str.c_str(),strlen(scidac_str.c_str()) )  ) {
 	//	std::cout << SCIDAC_CHECKSUM << " " <<xmlstring<<std::endl;
 	read(RD,std::string("scidacChecksum"),scidacChecksum_);
-	return;
+	return haveGridChecksum;
       }      
     }
     assert(0);
+    return false;
   }
   ////////////////////////////////////////////
   // Read a generic serialisable object
@@ -434,6 +473,7 @@ class GridLimeWriter : public BinaryIO
     typedef typename vobj::scalar_object sobj;
     int err;
     uint32_t nersc_csum,scidac_csuma,scidac_csumb;
+    uint64_t grid_csum;
     uint64_t PayloadSize = sizeof(sobj) * grid->_gsites;
     if ( boss_node ) {
       createLimeRecordHeader(record_name, 0, 0, PayloadSize);
@@ -458,7 +498,7 @@ class GridLimeWriter : public BinaryIO
     ///////////////////////////////////////////
     std::string format = getFormatString<vobj>();
     BinarySimpleMunger<sobj,sobj> munge;
-    BinaryIO::writeLatticeObject<vobj,sobj>(field, filename, munge, offset1, format,nersc_csum,scidac_csuma,scidac_csumb);
+    BinaryIO::writeLatticeObject<vobj,sobj>(field, filename, munge, offset1, format,nersc_csum,scidac_csuma,scidac_csumb,&grid_csum);
 
     ///////////////////////////////////////////
     // Wind forward and close the record
@@ -485,8 +525,12 @@ class GridLimeWriter : public BinaryIO
     std::stringstream streamb; streamb << std::hex << scidac_csumb;
     checksum.suma= streama.str();
     checksum.sumb= streamb.str();
+    gridChecksum gchecksum;
+    std::stringstream streamg; streamg << std::hex << grid_csum;
+    gchecksum.sum= streamg.str();
     if ( boss_node ) { 
       writeLimeObject(0,0,FNMD,std::string(GRID_FIELD_NORM),std::string(GRID_FIELD_NORM));
+      writeLimeObject(0,0,gchecksum,std::string("gridChecksum"),std::string(GRID_CHECKSUM));
       writeLimeObject(0,1,checksum,std::string("scidacChecksum"),std::string(SCIDAC_CHECKSUM));
     }
   }
@@ -535,6 +579,126 @@ class ScidacWriter : public GridLimeWriter {
     // Collective call
     writeLimeLatticeBinaryObject(field,std::string(ILDG_BINARY_DATA));      // Closes message with checksum
   }
+  ////////////////////////////////////////////////
+  // Many fields of one type (eigenvectors, A2A vectors) as consecutive
+  // records, byte identical to a loop over writeScidacFieldRecord.
+  //
+  // The file is opened once for the payloads. Each field is unvectorised and
+  // checksummed into one of two buffers while the previous one is written by
+  // a helper thread; the boss lays down the Lime records around each payload
+  // as soon as its checksums are known, seeking over the payload. Every rank
+  // writes its own sub-volume with positioned POSIX I/O, so as for
+  // AsyncBinaryHmcCheckpointer the file system must be coherent between ranks.
+  ////////////////////////////////////////////////
+  template <class vobj, class userRecord>
+  void writeScidacFieldRecords(std::vector<Lattice<vobj> > &fields,std::vector<userRecord> &_userRecords,
+			       const unsigned int recordScientificPrec = 0)
+  {
+    typedef typename vobj::scalar_object sobj;
+    int nfield = fields.size();
+    assert(_userRecords.size()==nfield);
+    if ( nfield==0 ) return;
+
+    GridBase *grid = fields[0].Grid();
+    assert(this->boss_node == grid->IsBoss());
+    uint64_t lsites      = grid->lSites();
+    uint64_t PayloadSize = sizeof(sobj) * grid->_gsites;
+    std::string format   = getFormatString<vobj>();
+    bool ieee64big = (format == std::string("IEEE64BIG"));
+
+    // All the norms in one reduction
+    std::vector<RealD> norms(nfield);
+    for(int i=0;i<nfield;i++) {
+      assert(fields[i].Grid()==grid);
+      norms[i] = real(rankInnerProduct(fields[i],fields[i]));
+    }
+    grid->GlobalSumVector(&norms[0],nfield);
+
+    int fd = -1;
+    if ( this->boss_node ) fflush(File);
+    grid->Barrier();
+    fd = ::open(filename.c_str(),O_WRONLY);
+    if ( fd < 0 ) IOabort("Error in opening the file for output",filename);
+
+    GridStopWatch wall, stage;
+    std::vector<sobj> buf[2];
+    buf[0].resize(lsites);
+    if ( nfield > 1 ) buf[1].resize(lsites);
+    std::future<bool> pending;
+    uint32_t failed = 0;
+
+    wall.Start();
+    for(int i=0;i<nfield;i++){
+      std::vector<sobj> &b = buf[i%2];
+
+      stage.Start();
+      unvectorizeToLexOrdArray(b,fields[i]);
+      if ( ieee64big ) htobe64_v((void *)&b[0],sizeof(sobj)*lsites);
+      else             htobe32_v((void *)&b[0],sizeof(sobj)*lsites);
+      uint32_t scidac_csuma=0, scidac_csumb=0;
+      uint64_t grid_csum=0;
+      ScidacChecksum(grid,&b[0],0,lsites,scidac_csuma,scidac_csumb,&grid_csum);
+      stage.Stop();
+      grid->GlobalXOR(scidac_csuma);
+      grid->GlobalXOR(scidac_csumb);
+      grid->GlobalSum(grid_csum);
+
+      // The whole Lime record, with a hole for the payload
+      uint64_t offset = 0;
+      if ( this->boss_node ) {
+	FieldMetaData header;
+	scidacRecord  _scidacRecord;
+	scidacFile    _scidacFile;
+	ScidacMetaData(fields[i],header,_scidacRecord,_scidacFile);
+	writeLimeObject(1,0,header ,std::string("FieldMetaData"),std::string(GRID_FORMAT));
+	writeLimeObject(0,0,_userRecords[i],_userRecords[i].SerialisableClassName(),std::string(SCIDAC_RECORD_XML), recordScientificPrec);
+	writeLimeObject(0,0,_scidacRecord,_scidacRecord.SerialisableClassName(),std::string(SCIDAC_PRIVATE_RECORD_XML));
+	createLimeRecordHeader(std::string(ILDG_BINARY_DATA), 0, 0, PayloadSize);
+	fflush(File);
+	offset = ftello(File);
+	fseeko(File,offset+PayloadSize,SEEK_SET);
+	int err=limeWriterCloseRecord(LimeW);  assert(err>=0);
+
+	FieldNormMetaData FNMD; FNMD.norm2 = norms[i];
+	scidacChecksum checksum;
+	std::stringstream streama; streama << std::hex << scidac_csuma;
+	std::stringstream streamb; streamb << std::hex << scidac_csumb;
+	checksum.suma= streama.str();
+	checksum.sumb= streamb.str();
+	gridChecksum gchecksum;
+	std::stringstream streamg; streamg << std::hex << grid_csum;
+	gchecksum.sum= streamg.str();
+	writeLimeObject(0,0,FNMD,std::string(GRID_FIELD_NORM),std::string(GRID_FIELD_NORM));
+	writeLimeObject(0,0,gchecksum,std::string("gridChecksum"),std::string(GRID_CHECKSUM));
+	writeLimeObject(0,1,checksum,std::string("scidacChecksum"),std::string(SCIDAC_CHECKSUM));
+      }
+      grid->Broadcast(0,(void *)&offset,sizeof(offset));
+
+      if ( i>0 && !pending.get() ) failed++;
+      pending = std::async(std::launch::async,[&b,grid,fd,lsites,offset]() {
+	return IOtransferSites(fd,grid,(char *)&b[0],0,lsites,sizeof(sobj),offset,BINARYIO_WRITE);
+      });
+    }
+    if ( !pending.get() ) failed++;
+    if ( ::fsync(fd) != 0 ) failed++;
+    ::close(fd);
+    wall.Stop();
+
+    grid->GlobalSum(failed);
+    if ( failed ) IOabort("Write failed on",filename);
+
+    double bytes = (double)PayloadSize*nfield;
+    std::cout << GridLogMessage << "writeScidacFieldRecords: " << nfield << " records, " << bytes << " bytes in "
+	      << wall.Elapsed() << " " << bytes/wall.useconds() << " MB/s; unvectorise/checksum "
+	      << stage.Elapsed() << std::endl;
+  }
+  template <class vobj, class userRecord>
+  void writeScidacFieldRecords(std::vector<Lattice<vobj> > &fields,userRecord _userRecord,
+			       const unsigned int recordScientificPrec = 0)
+  {
+    std::vector<userRecord> records(fields.size(),_userRecord);
+    writeScidacFieldRecords(fields,records,recordScientificPrec);
+  }
 };
 
 
@@ -572,6 +736,108 @@ class ScidacReader : public GridLimeReader {
     readLimeObject(_scidacRecord,_scidacRecord.SerialisableClassName(),std::string(SCIDAC_PRIVATE_RECORD_XML));
     readLimeLatticeBinaryObject(field,std::string(ILDG_BINARY_DATA));
   }
+  ////////////////////////////////////////////////
+  // As readScidacFieldRecord, but leave the binary data in the file;
+  // returns its offset for a MappedLatticeFile.
+  ////////////////////////////////////////////////
+  template <class userRecord>
+  uint64_t locateScidacFieldRecord(userRecord &_userRecord,uint64_t &bytes)
+  {
+    FieldMetaData header;
+    scidacRecord  _scidacRecord;
+    readLimeObject(header ,std::string("FieldMetaData"),std::string(GRID_FORMAT));
+    readLimeObject(_userRecord,_userRecord.SerialisableClassName(),std::string(SCIDAC_RECORD_XML));
+    readLimeObject(_scidacRecord,_scidacRecord.SerialisableClassName(),std::string(SCIDAC_PRIVATE_RECORD_XML));
+    return locateLimeBinaryObject(std::string(ILDG_BINARY_DATA),bytes);
+  }
+  ////////////////////////////////////////////////
+  // Read consecutive records into fields, as a loop over readScidacFieldRecord.
+  // The Lime metadata of all the records is walked first without touching
+  // the payloads; the payloads are then read through one descriptor, the
+  // next one in flight on a helper thread while the current one is
+  // checksummed and vectorised.
+  ////////////////////////////////////////////////
+  template <class vobj, class userRecord>
+  void readScidacFieldRecords(std::vector<Lattice<vobj> > &fields,std::vector<userRecord> &_userRecords)
+  {
+    typedef typename vobj::scalar_object sobj;
+    int nfield = fields.size();
+    _userRecords.resize(nfield);
+    if ( nfield==0 ) return;
+
+    GridBase *grid = fields[0].Grid();
+    uint64_t lsites      = grid->lSites();
+    uint64_t PayloadSize = sizeof(sobj) * grid->_gsites;
+    bool ieee64big = (getFormatString<vobj>() == std::string("IEEE64BIG"));
+
+    std::vector<uint64_t>          offsets(nfield);
+    std::vector<scidacChecksum>    checksums(nfield);
+    std::vector<FieldNormMetaData> fnmd(nfield);
+    std::vector<gridChecksum>      gchecksums(nfield);
+    std::vector<int>               haveGridChecksum(nfield);
+    for(int i=0;i<nfield;i++){
+      assert(fields[i].Grid()==grid);
+      uint64_t bytes;
+      offsets[i] = locateScidacFieldRecord(_userRecords[i],bytes);
+      assert(bytes == PayloadSize);
+      haveGridChecksum[i] = readScidacChecksum(checksums[i],fnmd[i],gchecksums[i]);
+    }
+
+    int fd = ::open(filename.c_str(),O_RDONLY);
+    if ( fd < 0 ) IOabort("Error in opening the file for input",filename);
+
+    GridStopWatch wall, stage;
+    std::vector<sobj> buf[2];
+    buf[0].resize(lsites);
+    if ( nfield > 1 ) buf[1].resize(lsites);
+    auto transfer = [&](int i) {
+      return IOtransferSites(fd,grid,(char *)&buf[i%2][0],0,lsites,sizeof(sobj),offsets[i],BINARYIO_READ);
+    };
+    std::future<bool> pending = std::async(std::launch::async,transfer,0);
+    uint32_t failed = 0;
+
+    wall.Start();
+    for(int i=0;i<nfield;i++){
+      if ( !pending.get() ) failed++;
+      if ( i+1<nfield ) pending = std::async(std::launch::async,transfer,i+1);
+      std::vector<sobj> &b = buf[i%2];
+
+      stage.Start();
+      uint32_t scidac_csuma=0, scidac_csumb=0;
+      uint64_t grid_csum=0;
+      ScidacChecksum(grid,&b[0],0,lsites,scidac_csuma,scidac_csumb,&grid_csum);
+      if ( ieee64big ) be64toh_v((void *)&b[0],sizeof(sobj)*lsites);
+      else             be32toh_v((void *)&b[0],sizeof(sobj)*lsites);
+      vectorizeFromLexOrdArray(b,fields[i]);
+      stage.Stop();
+
+      grid->GlobalSum(failed);
+      if ( failed ) IOabort("Read failed on",filename);
+      grid->GlobalXOR(scidac_csuma);
+      grid->GlobalXOR(scidac_csumb);
+      grid->GlobalSum(grid_csum);
+      if ( fnmd[i].norm2 != 0.0 ) {
+	RealD n2ck = norm2(fields[i]);
+	GRID_FIELD_NORM_CHECK(fnmd[i],n2ck);
+      }
+      assert(scidacChecksumVerify(checksums[i],scidac_csuma,scidac_csumb)==1);
+      if ( haveGridChecksum[i] ) assert(gridChecksumVerify(gchecksums[i],grid_csum)==1);
+    }
+    ::close(fd);
+    wall.Stop();
+
+    double bytes = (double)PayloadSize*nfield;
+    std::cout << GridLogMessage << "readScidacFieldRecords: " << nfield << " records, " << bytes << " bytes in "
+	      << wall.Elapsed() << " " << bytes/wall.useconds() << " MB/s; checksum/vectorise "
+	      << stage.Elapsed() << std::endl;
+  }
+  template <class vobj, class userRecord>
+  void readScidacFieldRecords(std::vector<Lattice<vobj> > &fields,userRecord &_userRecord)
+  {
+    std::vector<userRecord> records;
+    readScidacFieldRecords(fields,records);
+    if ( records.size() ) _userRecord = records.back();
+  }
   void skipPastBinaryRecord(void) {
     std::string rec_name(ILDG_BINARY_DATA);
     while ( limeReaderNextRecord(LimeR) == LIME_SUCCESS ) { 
@@ -39,6 +39,7 @@ NAMESPACE_BEGIN(Grid);
 /////////////////////////////////////////////////////////////////////////////////
 
 #define GRID_FORMAT      "grid-format"
+#define GRID_CHECKSUM    "grid-checksum"
 #define ILDG_FORMAT      "ildg-format"
 #define ILDG_BINARY_DATA "ildg-binary-data"
 #define ILDG_DATA_LFN    "ildg-data-lfn"
@@ -183,6 +184,20 @@ public:
     version=1.0; 
   };
 };
+////////////////////////
+// Grid fast checksum, see BinaryIO::GridSiteChecksum
+////////////////////////
+struct gridChecksum : Serializable { 
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(gridChecksum,
+				  double, version,
+				  std::string, algorithm,
+				  std::string, sum);
+  gridChecksum() { 
+    version=1.0; 
+    algorithm="crc32c-site-weighted-sum";
+  };
+};
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Type:           scidac-file-xml         <title>MILC ILDG archival gauge configuration</title>
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
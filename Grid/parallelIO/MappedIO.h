@@ -0,0 +1,247 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/parallelIO/MappedIO.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#pragma once
+
+#include <sys/mman.h>
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Lazy, memory mapped view of a lexicographic lattice file.
+//
+// The file is mapped read only and shared, so ranks on one node that map the
+// same file share its page cache, and several fields can be mapped at once.
+// Nothing is read at construction; readRegion / readSlice / readField touch
+// only the x-lines of the requested region, so e.g. a few timeslices of a
+// propagator cost a few timeslices of I/O. prefetch() issues readahead hints
+// for a region that will be wanted shortly.
+//
+// The payload is an array of fobj in global lexicographic order starting at
+// byte offset, in one of the BinaryIO formats (IEEE32BIG, IEEE64BIG, ...).
+// For a SciDAC/ILDG file the offset of a record is given by
+// ScidacReader::locateScidacFieldRecord.
+////////////////////////////////////////////////////////////////////////////////
+template<class fobj>
+class MappedLatticeFile {
+public:
+  typedef typename getPrecision<fobj>::real_scalar_type fword;
+
+  MappedLatticeFile(const std::string &_file,uint64_t _offset,const Coordinate &_dims,const std::string &format)
+    : file(_file), offset(_offset), dims(_dims), base(nullptr), bytes_touched(0)
+  {
+    big = (format == std::string("IEEE32BIG")) || (format == std::string("IEEE64BIG"));
+    assert(big || format == std::string("IEEE32") || format == std::string("IEEE64")
+	       || format == std::string("IEEE64LITTLE"));
+
+    gsites = 1;
+    for(int d=0;d<dims.size();d++) gsites *= dims[d];
+
+    fd = ::open(file.c_str(),O_RDONLY);
+    if ( fd < 0 ) BinaryIO::IOabort("Error in opening the file for mapping",file);
+    struct stat st;
+    assert(::fstat(fd,&st)==0);
+    map_bytes = st.st_size;
+    if ( map_bytes < offset + gsites*sizeof(fobj) ) BinaryIO::IOabort("File too short for lattice",file);
+
+    base = (char *)::mmap(nullptr,map_bytes,PROT_READ,MAP_SHARED,fd,0);
+    if ( base == MAP_FAILED ) BinaryIO::IOabort("mmap failed on",file);
+    // Fault in only what is asked for; prefetch() supplies the readahead
+    ::madvise(base,map_bytes,MADV_RANDOM);
+  }
+  ~MappedLatticeFile()
+  {
+    if ( base ) ::munmap(base,map_bytes);
+    ::close(fd);
+  }
+  MappedLatticeFile(const MappedLatticeFile &) = delete;
+  MappedLatticeFile &operator=(const MappedLatticeFile &) = delete;
+
+  const Coordinate &Dimensions(void) const { return dims; }
+  uint64_t BytesTouched(void)        const { return bytes_touched; }
+
+  //////////////////////////////////////////////////////////////////
+  // Readahead hints over the x-lines of a global region
+  //////////////////////////////////////////////////////////////////
+  void prefetch(const Coordinate &LowerLeft,const Coordinate &RegionSize) { advise(LowerLeft,RegionSize,MADV_WILLNEED); }
+  void release (const Coordinate &LowerLeft,const Coordinate &RegionSize) { advise(LowerLeft,RegionSize,MADV_DONTNEED); }
+
+  //////////////////////////////////////////////////////////////////
+  // localCopyRegion style: the region of the file at global FromLowerLeft
+  // lands at rank local ToLowerLeft of To. Purely local, no communication.
+  //////////////////////////////////////////////////////////////////
+  template<class vobj,class munger>
+  void readRegion(Lattice<vobj> &To,Coordinate FromLowerLeft,Coordinate ToLowerLeft,Coordinate RegionSize,munger munge)
+  {
+    typedef typename vobj::scalar_object sobj;
+    GridBase *grid = To.Grid();
+    assert(!grid->_isCheckerBoarded);
+    int nd = grid->_ndimension;
+    assert(nd == dims.size());
+
+    uint64_t nx     = RegionSize[0];
+    uint64_t nlines = 1;
+    for(int d=0;d<nd;d++) {
+      assert(FromLowerLeft[d]>=0 && FromLowerLeft[d]+RegionSize[d] <= dims[d]);
+      assert(ToLowerLeft[d]>=0   && ToLowerLeft[d]+RegionSize[d]   <= grid->_ldimensions[d]);
+      if ( RegionSize[d] <= 0 ) return;
+      if ( d>0 ) nlines *= RegionSize[d];
+    }
+    Coordinate lines = RegionSize; lines[0] = 1;
+
+    GridStopWatch timer;
+    timer.Start();
+    autoView(t_v,To,CpuWrite);
+    thread_region
+    {
+      std::vector<fobj> buf(nx);
+      Coordinate lcoor(nd), fcoor(nd), tcoor(nd);
+      thread_for_in_region(line,nlines,{
+	Lexicographic::CoorFromIndex(lcoor,line,lines);
+	for(int d=0;d<nd;d++) fcoor[d] = FromLowerLeft[d]+lcoor[d];
+	std::memcpy(&buf[0],base+offset+globalIndex(fcoor)*sizeof(fobj),nx*sizeof(fobj));
+	swap(&buf[0],nx);
+	for(uint64_t x=0;x<nx;x++){
+	  for(int d=0;d<nd;d++) tcoor[d] = ToLowerLeft[d]+lcoor[d];
+	  tcoor[0] += x;
+	  sobj s;
+	  munge(buf[x],s);
+	  insertLane(grid->iIndex(tcoor),t_v[grid->oIndex(tcoor)],s);
+	}
+      });
+    }
+    timer.Stop();
+    bytes_touched += nlines*nx*sizeof(fobj);
+    std::cout << GridLogDebug << "MappedLatticeFile: " << nlines*nx*sizeof(fobj) << " bytes of " << file
+	      << " in " << timer.Elapsed() << std::endl;
+  }
+  template<class vobj>
+  void readRegion(Lattice<vobj> &To,Coordinate FromLowerLeft,Coordinate ToLowerLeft,Coordinate RegionSize)
+  {
+    BinarySimpleMunger<fobj,typename vobj::scalar_object> munge;
+    readRegion(To,FromLowerLeft,ToLowerLeft,RegionSize,munge);
+  }
+
+  //////////////////////////////////////////////////////////////////
+  // Collective style helpers on a field spanning the whole file:
+  // every rank fills the part of its sub-volume that is asked for.
+  //////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void readField(Lattice<vobj> &field)
+  {
+    GridBase *grid = field.Grid();
+    Coordinate zero(grid->_ndimension,0);
+    readRegion(field,grid->LocalStarts(),zero,grid->LocalDimensions());
+  }
+  // Fills timeslice (or any slice) "slice" of direction orthog; other sites are untouched
+  template<class vobj>
+  void readSlice(Lattice<vobj> &field,int orthog,int slice)
+  {
+    GridBase *grid = field.Grid();
+    Coordinate lstart = grid->LocalStarts();
+    Coordinate ldims  = grid->LocalDimensions();
+    if ( slice < lstart[orthog] || slice >= lstart[orthog]+ldims[orthog] ) return;
+    Coordinate from = lstart;
+    Coordinate to(grid->_ndimension,0);
+    Coordinate size = ldims;
+    from[orthog] = slice;
+    to[orthog]   = slice-lstart[orthog];
+    size[orthog] = 1;
+    readRegion(field,from,to,size);
+  }
+  template<class vobj>
+  void prefetchSlice(Lattice<vobj> &field,int orthog,int slice)
+  {
+    GridBase *grid = field.Grid();
+    Coordinate lstart = grid->LocalStarts();
+    Coordinate size   = grid->LocalDimensions();
+    if ( slice < lstart[orthog] || slice >= lstart[orthog]+size[orthog] ) return;
+    lstart[orthog] = slice;
+    size[orthog]   = 1;
+    prefetch(lstart,size);
+  }
+
+private:
+  std::string file;
+  uint64_t    offset;
+  Coordinate  dims;
+  uint64_t    gsites;
+  char       *base;
+  size_t      map_bytes;
+  int         fd;
+  bool        big;
+  uint64_t    bytes_touched;
+
+  // 64 bit lexicographic index; files may exceed 2^31 sites
+  uint64_t globalIndex(const Coordinate &coor)
+  {
+    uint64_t idx=0;
+    for(int d=dims.size()-1;d>=0;d--) idx = idx*dims[d] + coor[d];
+    return idx;
+  }
+
+  void swap(fobj *buf,uint64_t n)
+  {
+#if BYTE_ORDER == BIG_ENDIAN
+    bool host_big = true;
+#else
+    bool host_big = false;
+#endif
+    if ( big == host_big ) return;
+    uint64_t words = n*sizeof(fobj)/sizeof(fword);
+    if ( sizeof(fword)==8 ) {
+      uint64_t *w = (uint64_t *)buf;
+      for(uint64_t i=0;i<words;i++) w[i] = __builtin_bswap64(w[i]);
+    } else {
+      uint32_t *w = (uint32_t *)buf;
+      for(uint64_t i=0;i<words;i++) w[i] = __builtin_bswap32(w[i]);
+    }
+  }
+
+  void advise(const Coordinate &LowerLeft,const Coordinate &RegionSize,int advice)
+  {
+    int nd = dims.size();
+    uint64_t page = ::sysconf(_SC_PAGESIZE);
+    uint64_t nlines = 1;
+    for(int d=1;d<nd;d++) nlines *= RegionSize[d];
+    Coordinate lines = RegionSize; lines[0] = 1;
+    Coordinate coor(nd);
+    // Merge the page ranges of consecutive lines before asking the kernel
+    uint64_t lo=0, hi=0;
+    for(uint64_t line=0;line<nlines;line++){
+      Lexicographic::CoorFromIndex(coor,line,lines);
+      for(int d=0;d<nd;d++) coor[d] += LowerLeft[d];
+      uint64_t b = offset + globalIndex(coor)*sizeof(fobj);
+      uint64_t e = b + RegionSize[0]*sizeof(fobj);
+      b = (b/page)*page;
+      if ( line && b <= hi ) { hi = std::max(hi,e); continue; }
+      if ( line ) ::madvise(base+lo,hi-lo,advice);
+      lo = b; hi = e;
+    }
+    if ( nlines ) ::madvise(base+lo,hi-lo,advice);
+  }
+};
+
+NAMESPACE_END(Grid);
@@ -77,22 +77,27 @@ public:
   void  Pdag(const FermionField &psi, FermionField &chi);
   
   /////////////////////////////////////////////////////
-  // Instantiate different versions depending on Impl
+  // Instantiate different versions depending on Impl.
+  // Non-virtual, so they can carry simd_dispatch clones;
+  // the virtual MooeeInv/MooeeInvDag forward to the kernels
   /////////////////////////////////////////////////////
-  void M5D(const FermionField &psi,
+  simd_dispatch void M5D(const FermionField &psi,
 	   const FermionField &phi,
 	   FermionField &chi,
 	   Vector<Coeff_t> &lower,
 	   Vector<Coeff_t> &diag,
 	   Vector<Coeff_t> &upper);
 
-  void M5Ddag(const FermionField &psi,
+  simd_dispatch void M5Ddag(const FermionField &psi,
 	      const FermionField &phi,
 	      FermionField &chi,
 	      Vector<Coeff_t> &lower,
 	      Vector<Coeff_t> &diag,
 	      Vector<Coeff_t> &upper);
 
+  simd_dispatch void MooeeInvKernel   (const FermionField &psi, FermionField &chi);
+  simd_dispatch void MooeeInvDagKernel(const FermionField &psi, FermionField &chi);
+
   virtual void   Instantiatable(void)=0;
 
   // force terms; five routines; default to Dhop on diagonal
@@ -71,22 +71,29 @@ public:
   virtual void   M5Ddag          (const FermionField& psi, FermionField& chi);
 
   /////////////////////////////////////////////////////
-  // Instantiate different versions depending on Impl
+  // Instantiate different versions depending on Impl.
+  // Non-virtual, so they can carry simd_dispatch clones;
+  // the virtual MooeeInv variants forward to the kernels
   /////////////////////////////////////////////////////
-  void M5D(const FermionField& psi, const FermionField& phi, FermionField& chi,
+  simd_dispatch void M5D(const FermionField& psi, const FermionField& phi, FermionField& chi,
 	   Vector<Coeff_t>& lower, Vector<Coeff_t>& diag, Vector<Coeff_t>& upper);
 
-  void M5D_shift(const FermionField& psi, const FermionField& phi, FermionField& chi,
+  simd_dispatch void M5D_shift(const FermionField& psi, const FermionField& phi, FermionField& chi,
 		 Vector<Coeff_t>& lower, Vector<Coeff_t>& diag, Vector<Coeff_t>& upper,
 		 Vector<Coeff_t>& shift_coeffs);
 
-  void M5Ddag(const FermionField& psi, const FermionField& phi, FermionField& chi,
+  simd_dispatch void M5Ddag(const FermionField& psi, const FermionField& phi, FermionField& chi,
 	      Vector<Coeff_t>& lower, Vector<Coeff_t>& diag, Vector<Coeff_t>& upper);
 
-  void M5Ddag_shift(const FermionField& psi, const FermionField& phi, FermionField& chi,
+  simd_dispatch void M5Ddag_shift(const FermionField& psi, const FermionField& phi, FermionField& chi,
 		    Vector<Coeff_t>& lower, Vector<Coeff_t>& diag, Vector<Coeff_t>& upper,
 		    Vector<Coeff_t>& shift_coeffs);
 
+  simd_dispatch void MooeeInvKernel         (const FermionField& psi, FermionField& chi);
+  simd_dispatch void MooeeInv_shiftKernel   (const FermionField& psi, FermionField& chi);
+  simd_dispatch void MooeeInvDagKernel      (const FermionField& psi, FermionField& chi);
+  simd_dispatch void MooeeInvDag_shiftKernel(const FermionField& psi, FermionField& chi);
+
   virtual void RefreshShiftCoefficients(RealD new_shift);
 
   // Constructors
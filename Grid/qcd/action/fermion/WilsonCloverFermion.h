@@ -117,12 +117,19 @@ public:
   virtual void MooeeInvDag(const FermionField &in, FermionField &out);
   virtual void MooeeInternal(const FermionField &in, FermionField &out, int dag, int inv);
 
+  // The site multiply of MooeeInternal; non-virtual to carry simd_dispatch clones
+  static simd_dispatch void MultClover(FermionField &out, const CloverFieldType &Clover, const FermionField &in, int dag);
+
   //virtual void MDeriv(GaugeField &mat, const FermionField &U, const FermionField &V, int dag);
   virtual void MooDeriv(GaugeField &mat, const FermionField &U, const FermionField &V, int dag);
   virtual void MeeDeriv(GaugeField &mat, const FermionField &U, const FermionField &V, int dag);
 
   void ImportGauge(const GaugeField &_Umu);
 
+  // Field strengths of the next ImportGauge from one halo exchange, in the
+  // grid's tiled order, see WilsonLoopsHalo; off by default
+  void UseHaloExchange(bool use=true) { halo = use; }
+
   // Derivative parts unpreconditioned pseudofermions
   void MDeriv(GaugeField &force, const FermionField &X, const FermionField &Y, int dag)
   {
@@ -251,6 +258,7 @@ private:
   RealD csw_r;                                               // Clover coefficient - spatial
   RealD csw_t;                                               // Clover coefficient - temporal
   RealD diag_mass;                                           // Mass term
+  bool halo = false;                                         // Field strengths from WilsonLoopsHalo
   CloverFieldType CloverTerm, CloverTermInv;                 // Clover term
   CloverFieldType CloverTermEven, CloverTermOdd;             // Clover term EO
   CloverFieldType CloverTermInvEven, CloverTermInvOdd;       // Clover term Inv EO
@@ -127,6 +127,20 @@ CayleyFermion5D<Impl>::M5Ddag(const FermionField &psi_i,
 template<class Impl>
 void
 CayleyFermion5D<Impl>::MooeeInv    (const FermionField &psi_i, FermionField &chi_i)
+{
+  MooeeInvKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void
+CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi_i, FermionField &chi_i)
+{
+  MooeeInvDagKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void
+CayleyFermion5D<Impl>::MooeeInvKernel   (const FermionField &psi_i, FermionField &chi_i)
 {
   chi_i.Checkerboard()=psi_i.Checkerboard();
   GridBase *grid=psi_i.Grid();
@@ -187,7 +201,7 @@ CayleyFermion5D<Impl>::MooeeInv    (const FermionField &psi_i, FermionField &chi
 
 template<class Impl>
 void
-CayleyFermion5D<Impl>::MooeeInvDag (const FermionField &psi_i, FermionField &chi_i)
+CayleyFermion5D<Impl>::MooeeInvDagKernel(const FermionField &psi_i, FermionField &chi_i)
 {
   chi_i.Checkerboard()=psi_i.Checkerboard();
   GridBase *grid=psi_i.Grid();
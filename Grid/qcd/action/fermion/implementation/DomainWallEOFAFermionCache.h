@@ -113,6 +113,18 @@ void DomainWallEOFAFermion<Impl>::M5Ddag(const FermionField& psi_i, const Fermio
 
 template<class Impl>
 void DomainWallEOFAFermion<Impl>::MooeeInv(const FermionField& psi_i, FermionField& chi_i)
+{
+  MooeeInvKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void DomainWallEOFAFermion<Impl>::MooeeInvDag(const FermionField& psi_i, FermionField& chi_i)
+{
+  MooeeInvDagKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void DomainWallEOFAFermion<Impl>::MooeeInvKernel(const FermionField& psi_i, FermionField& chi_i)
 {
   chi_i.Checkerboard() = psi_i.Checkerboard();
   GridBase* grid = psi_i.Grid();
@@ -168,7 +180,7 @@ void DomainWallEOFAFermion<Impl>::MooeeInv(const FermionField& psi_i, FermionFie
 }
 
 template<class Impl>
-void DomainWallEOFAFermion<Impl>::MooeeInvDag(const FermionField& psi_i, FermionField& chi_i)
+void DomainWallEOFAFermion<Impl>::MooeeInvDagKernel(const FermionField& psi_i, FermionField& chi_i)
 {
   chi_i.Checkerboard() = psi_i.Checkerboard();
   GridBase* grid = psi_i.Grid();
@@ -222,6 +222,30 @@ void MobiusEOFAFermion<Impl>::M5Ddag_shift(const FermionField &psi_i, const Ferm
 
 template<class Impl>
 void MobiusEOFAFermion<Impl>::MooeeInv(const FermionField &psi_i, FermionField &chi_i)
+{
+  MooeeInvKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void MobiusEOFAFermion<Impl>::MooeeInv_shift(const FermionField &psi_i, FermionField &chi_i)
+{
+  MooeeInv_shiftKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void MobiusEOFAFermion<Impl>::MooeeInvDag(const FermionField &psi_i, FermionField &chi_i)
+{
+  MooeeInvDagKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void MobiusEOFAFermion<Impl>::MooeeInvDag_shift(const FermionField &psi_i, FermionField &chi_i)
+{
+  MooeeInvDag_shiftKernel(psi_i,chi_i);
+}
+
+template<class Impl>
+void MobiusEOFAFermion<Impl>::MooeeInvKernel(const FermionField &psi_i, FermionField &chi_i)
 {
   chi_i.Checkerboard() = psi_i.Checkerboard();
   GridBase *grid = psi_i.Grid();
@@ -281,7 +305,7 @@ void MobiusEOFAFermion<Impl>::MooeeInv(const FermionField &psi_i, FermionField &
 }
 
 template<class Impl>
-void MobiusEOFAFermion<Impl>::MooeeInv_shift(const FermionField &psi_i, FermionField &chi_i)
+void MobiusEOFAFermion<Impl>::MooeeInv_shiftKernel(const FermionField &psi_i, FermionField &chi_i)
 {
   chi_i.Checkerboard() = psi_i.Checkerboard();
   GridBase *grid = psi_i.Grid();
@@ -347,7 +371,7 @@ void MobiusEOFAFermion<Impl>::MooeeInv_shift(const FermionField &psi_i, FermionF
 }
 
 template<class Impl>
-void MobiusEOFAFermion<Impl>::MooeeInvDag(const FermionField &psi_i, FermionField &chi_i)
+void MobiusEOFAFermion<Impl>::MooeeInvDagKernel(const FermionField &psi_i, FermionField &chi_i)
 {
   if(this->shift != 0.0){ MooeeInvDag_shift(psi_i,chi_i); return; }
 
@@ -406,7 +430,7 @@ void MobiusEOFAFermion<Impl>::MooeeInvDag(const FermionField &psi_i, FermionFiel
 }
 
 template<class Impl>
-void MobiusEOFAFermion<Impl>::MooeeInvDag_shift(const FermionField &psi_i, FermionField &chi_i)
+void MobiusEOFAFermion<Impl>::MooeeInvDag_shiftKernel(const FermionField &psi_i, FermionField &chi_i)
 {
   chi_i.Checkerboard() = psi_i.Checkerboard();
   GridBase *grid = psi_i.Grid();
@@ -72,12 +72,24 @@ void WilsonCloverFermion<Impl>::ImportGauge(const GaugeField &_Umu)
   typename Impl::GaugeLinkField Bx(grid), By(grid), Bz(grid), Ex(grid), Ey(grid), Ez(grid);
 
   // Compute the field strength terms mu>nu
-  WilsonLoops<Impl>::FieldStrength(Bx, _Umu, Zdir, Ydir);
-  WilsonLoops<Impl>::FieldStrength(By, _Umu, Zdir, Xdir);
-  WilsonLoops<Impl>::FieldStrength(Bz, _Umu, Ydir, Xdir);
-  WilsonLoops<Impl>::FieldStrength(Ex, _Umu, Tdir, Xdir);
-  WilsonLoops<Impl>::FieldStrength(Ey, _Umu, Tdir, Ydir);
-  WilsonLoops<Impl>::FieldStrength(Ez, _Umu, Tdir, Zdir);
+  if (halo && WilsonLoopsHalo<Impl>::Supported(grid)) {
+    // All six planes from one halo exchange
+    std::vector<typename Impl::GaugeLinkField> FS;
+    WilsonLoopsHalo<Impl>::FieldStrengths(FS, _Umu);
+    Bx = FS[Zdir * Nd + Ydir];
+    By = FS[Zdir * Nd + Xdir];
+    Bz = FS[Ydir * Nd + Xdir];
+    Ex = FS[Tdir * Nd + Xdir];
+    Ey = FS[Tdir * Nd + Ydir];
+    Ez = FS[Tdir * Nd + Zdir];
+  } else {
+    WilsonLoops<Impl>::FieldStrength(Bx, _Umu, Zdir, Ydir);
+    WilsonLoops<Impl>::FieldStrength(By, _Umu, Zdir, Xdir);
+    WilsonLoops<Impl>::FieldStrength(Bz, _Umu, Ydir, Xdir);
+    WilsonLoops<Impl>::FieldStrength(Ex, _Umu, Tdir, Xdir);
+    WilsonLoops<Impl>::FieldStrength(Ey, _Umu, Tdir, Ydir);
+    WilsonLoops<Impl>::FieldStrength(Ez, _Umu, Tdir, Zdir);
+  }
 
   // Compute the Clover Operator acting on Colour and Spin
   // multiply here by the clover coefficients for the anisotropy
@@ -186,12 +198,12 @@ void WilsonCloverFermion<Impl>::MooeeInternal(const FermionField &in, FermionFie
       {
         Clover = (inv) ? &CloverTermInvDagEven : &CloverTermDagEven;
       }
-      out = *Clover * in;
+      MultClover(out, *Clover, in, DaggerNo);
     }
     else
     {
       Clover = (inv) ? &CloverTermInv : &CloverTerm;
-      out = adj(*Clover) * in;
+      MultClover(out, *Clover, in, DaggerYes);
     }
   }
   else
@@ -209,18 +221,42 @@ void WilsonCloverFermion<Impl>::MooeeInternal(const FermionField &in, FermionFie
         //  std::cout << "Calling clover term Even" << std::endl;
         Clover = (inv) ? &CloverTermInvEven : &CloverTermEven;
       }
-      out = *Clover * in;
+      MultClover(out, *Clover, in, DaggerNo);
       //  std::cout << GridLogMessage << "*Clover.Checkerboard() "  << (*Clover).Checkerboard() << std::endl;
     }
     else
     {
       Clover = (inv) ? &CloverTermInv : &CloverTerm;
-      out = *Clover * in;
+      MultClover(out, *Clover, in, DaggerNo);
     }
   }
 
 } // MooeeInternal
 
+// An explicit site loop rather than an expression, so the loop itself is cloned
+template <class Impl>
+void WilsonCloverFermion<Impl>::MultClover(FermionField &out, const CloverFieldType &Clover, const FermionField &in, int dag)
+{
+  conformable(in.Grid(), Clover.Grid());
+  conformable(in.Grid(), out.Grid());
+  out.Checkerboard() = in.Checkerboard();
+  autoView(C_v, Clover, AcceleratorRead);
+  autoView(in_v, in, AcceleratorRead);
+  autoView(out_v, out, AcceleratorWrite);
+  if (dag)
+  {
+    accelerator_for(ss, in.Grid()->oSites(), Simd::Nsimd(), {
+      coalescedWrite(out_v[ss], adj(C_v(ss)) * in_v(ss));
+    });
+  }
+  else
+  {
+    accelerator_for(ss, in.Grid()->oSites(), Simd::Nsimd(), {
+      coalescedWrite(out_v[ss], C_v(ss) * in_v(ss));
+    });
+  }
+}
+
 
 // Derivative parts
 template <class Impl>
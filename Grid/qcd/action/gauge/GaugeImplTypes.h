@@ -135,7 +135,7 @@ public:
     autoView(P_v,P,AcceleratorRead);
     accelerator_for(ss, P.Grid()->oSites(),1,{
       for (int mu = 0; mu < Nd; mu++) {
-        U_v[ss](mu) = ProjectOnGroup(Exponentiate(P_v[ss](mu), ep, Nexp) * U_v[ss](mu));
+        U_v[ss](mu) = reunitarise(Exponentiate(P_v[ss](mu), ep, Nexp) * U_v[ss](mu), isSU3());
       }
     });
    //auto end = std::chrono::high_resolution_clock::now();
@@ -143,6 +143,27 @@ public:
    // std::cout << "Time to exponentiate matrix " << diff.count() << " s\n";
   }
 
+  // P = a*P + b*F followed by U = exp(ep*P)*U, fused into one pass over the
+  // links for the Runge-Kutta steps of the Wilson flow. F may be P itself.
+  static inline void update_field(Field& P, const Field& F, RealD a, RealD b, Field& U, double ep){
+    autoView(U_v,U,AcceleratorWrite);
+    autoView(P_v,P,AcceleratorWrite);
+    autoView(F_v,F,AcceleratorRead);
+    accelerator_for(ss, P.Grid()->oSites(),1,{
+      for (int mu = 0; mu < Nd; mu++) {
+        auto Pmu = a*P_v[ss](mu) + b*F_v[ss](mu);
+        P_v[ss](mu) = Pmu;
+        U_v[ss](mu) = reunitarise(Exponentiate(Pmu, ep, Nexp) * U_v[ss](mu), isSU3());
+      }
+    });
+  }
+
+  // 3x3 links (SU(3), or the SO(3) adjoint of SU(2)) are put back on the group
+  // with the two row ProjectSU3, larger representations with Gram-Schmidt
+  typedef std::integral_constant<bool, Nrepresentation == 3> isSU3;
+  template<class vobj> static accelerator_inline vobj reunitarise(const vobj &U, std::true_type)  { return ProjectSU3(U); }
+  template<class vobj> static accelerator_inline vobj reunitarise(const vobj &U, std::false_type) { return ProjectOnGroup(U); }
+
   static inline RealD FieldSquareNorm(Field& U){
     LatticeComplex Hloc(U.Grid());
     Hloc = Zero();
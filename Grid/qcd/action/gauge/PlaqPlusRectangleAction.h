@@ -43,9 +43,14 @@ public:
 private:
   RealD c_plaq;
   RealD c_rect;
+  bool halo;
 
 public:
-  PlaqPlusRectangleAction(RealD b,RealD c): c_plaq(b),c_rect(c){};
+  PlaqPlusRectangleAction(RealD b,RealD c): c_plaq(b),c_rect(c),halo(false){};
+
+  // Force from staples and rectangle staples in one depth two halo exchange,
+  // see WilsonLoopsHalo; off by default
+  void UseHaloExchange(bool use=true) { halo = use; }
 
   virtual std::string action_name(){return "PlaqPlusRectangleAction";}
       
@@ -78,6 +83,21 @@ public:
 
     GridBase *grid = Umu.Grid();
 
+    // Staples and rectangle staples from a single depth two halo exchange
+    if (halo && WilsonLoopsHalo<Gimpl>::Supported(grid)) {
+      std::vector<GaugeLinkField> staple, rect;
+      WilsonLoopsHalo<Gimpl>::StaplesAndRectStaples(staple,rect,Umu);
+      GaugeLinkField U(grid);
+      GaugeLinkField dSdU_mu(grid);
+      for (int mu=0; mu < Nd; mu++){
+	U = PeekIndex<LorentzIndex>(Umu,mu);
+	dSdU_mu = Ta(U*staple[mu])*factor_p;
+	dSdU_mu = dSdU_mu + Ta(U*rect[mu])*factor_r;
+	PokeIndex<LorentzIndex>(dSdU, dSdU_mu, mu);
+      }
+      return;
+    }
+
     std::vector<GaugeLinkField> U (Nd,grid);
     std::vector<GaugeLinkField> U2(Nd,grid);
 
@@ -44,7 +44,11 @@ public:
   INHERIT_GIMPL_TYPES(Gimpl);
 
   /////////////////////////// constructors
-  explicit WilsonGaugeAction(RealD beta_):beta(beta_){};
+  explicit WilsonGaugeAction(RealD beta_):beta(beta_),halo(false){};
+
+  // Force from all Nd staples in one halo exchange, see WilsonLoopsHalo;
+  // off by default
+  void UseHaloExchange(bool use=true) { halo = use; }
 
   virtual std::string action_name() {return "WilsonGaugeAction";}
 
@@ -72,6 +76,19 @@ public:
 
     GaugeLinkField Umu(U.Grid());
     GaugeLinkField dSdU_mu(U.Grid());
+
+    // All Nd staples from one halo exchange
+    if (halo && WilsonLoopsHalo<Gimpl>::Supported(U.Grid())) {
+      std::vector<GaugeLinkField> staple;
+      WilsonLoopsHalo<Gimpl>::Staples(staple, U);
+      for (int mu = 0; mu < Nd; mu++) {
+        Umu = PeekIndex<LorentzIndex>(U, mu);
+        dSdU_mu = Ta(Umu * staple[mu]) * factor;
+        PokeIndex<LorentzIndex>(dSdU, dSdU_mu, mu);
+      }
+      return;
+    }
+
     for (int mu = 0; mu < Nd; mu++) {
 
       Umu = PeekIndex<LorentzIndex>(U, mu);
@@ -85,6 +102,7 @@ public:
   }
 private:
   RealD beta;  
+  bool halo;
  };
 
 NAMESPACE_END(Grid);
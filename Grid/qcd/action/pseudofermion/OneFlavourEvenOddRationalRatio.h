@@ -53,13 +53,33 @@ NAMESPACE_BEGIN(Grid);
       MultiShiftFunction PowerQuarter;
       MultiShiftFunction PowerNegQuarter;
 
-    private:
+    protected:
      
       FermionOperator<Impl> & NumOp;// the basic operator
       FermionOperator<Impl> & DenOp;// the basic operator
       FermionField PhiEven; // the pseudo fermion field for this trajectory
       FermionField PhiOdd; // the pseudo fermion field for this trajectory
 
+      //////////////////////////////////////////////////////////////////////
+      // Solver hooks; overridden to change the multishift solver (e.g. mixed precision)
+      //////////////////////////////////////////////////////////////////////
+      virtual void ImportGauge(const GaugeField &U) {
+	NumOp.ImportGauge(U);
+	DenOp.ImportGauge(U);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const Integer MaxIter,
+				     const FermionField &in, FermionField &out) {
+	SchurDifferentiableOperator<Impl> schurOp(numerator ? NumOp : DenOp);
+	ConjugateGradientMultiShift<FermionField> msCG(MaxIter,approx);
+	msCG(schurOp,in,out);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const Integer MaxIter,
+				     const FermionField &in, std::vector<FermionField> &out_elems, FermionField &out) {
+	SchurDifferentiableOperator<Impl> schurOp(numerator ? NumOp : DenOp);
+	ConjugateGradientMultiShift<FermionField> msCG(MaxIter,approx);
+	msCG(schurOp,in,out_elems,out);
+      }
+
     public:
 
       OneFlavourEvenOddRatioRationalPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
@@ -128,19 +148,13 @@ NAMESPACE_BEGIN(Grid);
 	pickCheckerboard(Even,etaEven,eta);
 	pickCheckerboard(Odd,etaOdd,eta);
 
-	NumOp.ImportGauge(U);
-	DenOp.ImportGauge(U);
-
+	ImportGauge(U);
 
 	// MdagM^1/4 eta
-	SchurDifferentiableOperator<Impl> MdagM(DenOp);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerQuarter);
-	msCG_M(MdagM,etaOdd,tmp);
+	multiShiftInverse(false,PowerQuarter,param.MaxIter,etaOdd,tmp);
 
 	// VdagV^-1/4 MdagM^1/4 eta
-	SchurDifferentiableOperator<Impl> VdagV(NumOp);
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerNegQuarter);
-	msCG_V(VdagV,tmp,PhiOdd);
+	multiShiftInverse(true,PowerNegQuarter,param.MaxIter,tmp,PhiOdd);
 
 	assert(NumOp.ConstEE() == 1);
 	assert(DenOp.ConstEE() == 1);
@@ -153,24 +167,20 @@ NAMESPACE_BEGIN(Grid);
       //////////////////////////////////////////////////////
       virtual RealD S(const GaugeField &U) {
 
-	NumOp.ImportGauge(U);
-	DenOp.ImportGauge(U);
+	ImportGauge(U);
 
 	FermionField X(NumOp.FermionRedBlackGrid());
 	FermionField Y(NumOp.FermionRedBlackGrid());
 
 	// VdagV^1/4 Phi
-	SchurDifferentiableOperator<Impl> VdagV(NumOp);
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerQuarter);
-	msCG_V(VdagV,PhiOdd,X);
+	multiShiftInverse(true,PowerQuarter,param.MaxIter,PhiOdd,X);
 
 	// MdagM^-1/4 VdagV^1/4 Phi
-	SchurDifferentiableOperator<Impl> MdagM(DenOp);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerNegQuarter);
-	msCG_M(MdagM,X,Y);
+	multiShiftInverse(false,PowerNegQuarter,param.MaxIter,X,Y);
 
 	// Randomly apply rational bounds checks.
 	if ( (rand()%param.BoundsCheckFreq)==0 ) { 
+	  SchurDifferentiableOperator<Impl> MdagM(DenOp);
 	  FermionField gauss(NumOp.FermionRedBlackGrid());
 	  gauss = PhiOdd;
 	  HighBoundCheck(MdagM,gauss,param.hi);
@@ -229,18 +239,14 @@ NAMESPACE_BEGIN(Grid);
 
 	GaugeField   tmp(NumOp.GaugeGrid());
 
-	NumOp.ImportGauge(U);
-	DenOp.ImportGauge(U);
+	ImportGauge(U);
 
 	SchurDifferentiableOperator<Impl> VdagV(NumOp);
 	SchurDifferentiableOperator<Impl> MdagM(DenOp);
 
-	ConjugateGradientMultiShift<FermionField> msCG_V(param.MaxIter,PowerQuarter);
-	ConjugateGradientMultiShift<FermionField> msCG_M(param.MaxIter,PowerNegHalf);
-
-	msCG_V(VdagV,PhiOdd,MpvPhi_k,MpvPhi);
-	msCG_M(MdagM,MpvPhi,MfMpvPhi_k,MfMpvPhi);
-	msCG_V(VdagV,MfMpvPhi,MpvMfMpvPhi_k,MpvMfMpvPhi);
+	multiShiftInverse(true ,PowerQuarter,param.MaxIter,PhiOdd,MpvPhi_k,MpvPhi);
+	multiShiftInverse(false,PowerNegHalf,param.MaxIter,MpvPhi,MfMpvPhi_k,MfMpvPhi);
+	multiShiftInverse(true ,PowerQuarter,param.MaxIter,MfMpvPhi,MpvMfMpvPhi_k,MpvMfMpvPhi);
 
 	RealD ak;
 
@@ -282,6 +288,68 @@ NAMESPACE_BEGIN(Grid);
       };
     };
 
+    ///////////////////////////////////////////////////////////////////////
+    // As above, but the multishift solves run in single precision with
+    // reliable updates and double precision clean up of each pole.
+    // NumOpF/DenOpF are single precision copies of NumOp/DenOp.
+    ///////////////////////////////////////////////////////////////////////
+    template<class Impl,class ImplF>
+    class OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction
+      : public OneFlavourEvenOddRatioRationalPseudoFermionAction<Impl> {
+    public:
+
+      INHERIT_IMPL_TYPES(Impl);
+      typedef typename ImplF::FermionField FermionFieldF;
+      typedef typename ImplF::GaugeField   GaugeFieldF;
+      typedef OneFlavourRationalParams Params;
+
+    private:
+
+      FermionOperator<ImplF> & NumOpF;
+      FermionOperator<ImplF> & DenOpF;
+      RealD Delta; // reliable update parameter
+
+    protected:
+
+      virtual void ImportGauge(const GaugeField &U) {
+	OneFlavourEvenOddRatioRationalPseudoFermionAction<Impl>::ImportGauge(U);
+	GaugeFieldF Uf(NumOpF.GaugeGrid());
+	precisionChange(Uf,U);
+	NumOpF.ImportGauge(Uf);
+	DenOpF.ImportGauge(Uf);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const Integer MaxIter,
+				     const FermionField &in, FermionField &out) {
+	SchurDifferentiableOperator<Impl>  schurOp (numerator ? this->NumOp : this->DenOp);
+	SchurDifferentiableOperator<ImplF> schurOpF(numerator ? NumOpF : DenOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(MaxIter,approx,NumOpF.FermionRedBlackGrid(),schurOpF,Delta);
+	msCG(schurOp,in,out);
+      }
+      virtual void multiShiftInverse(bool numerator, MultiShiftFunction &approx, const Integer MaxIter,
+				     const FermionField &in, std::vector<FermionField> &out_elems, FermionField &out) {
+	SchurDifferentiableOperator<Impl>  schurOp (numerator ? this->NumOp : this->DenOp);
+	SchurDifferentiableOperator<ImplF> schurOpF(numerator ? NumOpF : DenOpF);
+	ConjugateGradientMultiShiftMixedPrec<FermionField,FermionFieldF>
+	  msCG(MaxIter,approx,NumOpF.FermionRedBlackGrid(),schurOpF,Delta);
+	msCG(schurOp,in,out_elems,out);
+      }
+
+    public:
+
+      OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
+								 FermionOperator<Impl>  &_DenOp, 
+								 FermionOperator<ImplF> &_NumOpF, 
+								 FermionOperator<ImplF> &_DenOpF, 
+								 Params & p,
+								 RealD _Delta=0.1) :
+	OneFlavourEvenOddRatioRationalPseudoFermionAction<Impl>(_NumOp,_DenOp,p),
+	NumOpF(_NumOpF), DenOpF(_DenOpF), Delta(_Delta)
+      {}
+
+      virtual std::string action_name(){return "OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction";}
+    };
+
 NAMESPACE_END(Grid);
 
 #endif
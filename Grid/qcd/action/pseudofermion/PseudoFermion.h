@@ -33,6 +33,7 @@ directory
 #include <Grid/qcd/action/pseudofermion/Bounds.h>
 
 #include <Grid/qcd/action/pseudofermion/EvenOddSchurDifferentiable.h>
+#include <Grid/qcd/action/pseudofermion/SharedDeflationSpace.h>
 #include <Grid/qcd/action/pseudofermion/TwoFlavour.h>
 #include <Grid/qcd/action/pseudofermion/TwoFlavourRatio.h>
 #include <Grid/qcd/action/pseudofermion/TwoFlavourEvenOdd.h>
@@ -0,0 +1,252 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/action/pseudofermion/SharedDeflationSpace.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef QCD_PSEUDOFERMION_SHARED_DEFLATION_SPACE_H
+#define QCD_PSEUDOFERMION_SHARED_DEFLATION_SPACE_H
+
+NAMESPACE_BEGIN(Grid);
+
+struct SharedDeflationSpaceParameters : Serializable {
+public:
+  GRID_SERIALIZABLE_CLASS_MEMBERS(SharedDeflationSpaceParameters,
+				  ChebyParams, Cheby,
+				  int, Nstop,
+				  int, Nk,
+				  int, Nm,
+				  RealD, resid,
+				  int, MaxIt,
+				  RealD, betastp,
+				  int, MinRes,
+				  RealD, RebuildResid);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Low modes of the Schur (odd checkerboard) MpcdagMpc of one light quark
+// operator, shared by every pseudofermion action inverting that operator.
+//
+// Refresh() runs the Lanczos; it is a no-op when the space was already built
+// on the same gauge field, so each sharing action may call it from refresh()
+// and the eigensolve happens once per trajectory. Update() follows the gauge
+// field through the trajectory with a Rayleigh-Ritz step in the existing
+// space (Nm applications of the operator) and is likewise done once per
+// gauge field. The Rayleigh-Ritz step only rotates within the space, which
+// drifts away from the low modes as the field moves: once the relative Ritz
+// residual |A v - theta v|/|A v| of any of the Nstop lowest vectors exceeds
+// RebuildResid (0 disables the check) the Lanczos is rerun on the current
+// field. The space only provides initial guesses; a stale or mismatched
+// space costs iterations, never accuracy.
+//
+// The Lanczos start vector comes from a private RNG, reseeded with fixed seeds
+// for every build, so the HMC random number stream is never consumed and a
+// trajectory is reproduced exactly whether or not the space is in use.
+////////////////////////////////////////////////////////////////////////////////
+template<class Impl>
+class SharedDeflationSpace {
+public:
+  INHERIT_IMPL_TYPES(Impl);
+
+  SharedDeflationSpaceParameters Params;
+  std::vector<FermionField> evec;
+  std::vector<RealD>        eval;
+
+private:
+  FermionOperator<Impl> &FermOp;
+  GridParallelRNG  RNG;
+  std::vector<int> Seeds;
+  GaugeField Ubuilt;   // gauge field of the last Lanczos
+  GaugeField Ucurrent; // gauge field the space was last rotated on
+  bool built;
+  int  rebuilds;
+
+  bool SameGauge(const GaugeField &U, const GaugeField &V) {
+    GaugeField diff(U.Grid());
+    diff = U - V;
+    return norm2(diff) == 0.0;
+  }
+
+public:
+  SharedDeflationSpace(FermionOperator<Impl> &Op, SharedDeflationSpaceParameters &P,
+		       const std::vector<int> &seeds = std::vector<int>({11,22,33,44}))
+    : Params(P), FermOp(Op), RNG(Op.FermionGrid()), Seeds(seeds),
+      Ubuilt(Op.GaugeGrid()), Ucurrent(Op.GaugeGrid()), built(false), rebuilds(0) {};
+
+  bool Built(void) { return built; }
+  int  Rebuilds(void) { return rebuilds; } // Lanczos reruns forced by Update
+
+  // Whether Op is the operator the space is built on: the same object, or one
+  // on the same grid whose (gauge independent for Wilson and Cayley types)
+  // Mooee agrees on a random vector
+  bool SameOperator(FermionOperator<Impl> &Op) {
+    if ( &Op == &FermOp ) return true;
+    if ( Op.FermionRedBlackGrid() != FermOp.FermionRedBlackGrid() ) return false;
+    FermionField eta(FermOp.FermionGrid());
+    FermionField x(FermOp.FermionRedBlackGrid());
+    FermionField y(FermOp.FermionRedBlackGrid());
+    FermionField z(FermOp.FermionRedBlackGrid());
+    RNG.SeedFixedIntegers(Seeds);
+    gaussian(RNG,eta);
+    pickCheckerboard(Odd,x,eta);
+    Op.Mooee(x,y);
+    FermOp.Mooee(x,z);
+    z = z - y;
+    return norm2(z) == 0.0;
+  }
+
+  void Refresh(const GaugeField &U) {
+    if ( built && SameGauge(U,Ubuilt) ) return;
+    Build(U);
+  }
+
+private:
+  void Build(const GaugeField &U) {
+    GridStopWatch Timer; Timer.Start();
+    FermOp.ImportGauge(U);
+    SchurDiagMooeeOperator<FermionOperator<Impl>,FermionField> HermOp(FermOp);
+    Chebyshev<FermionField>      Cheby(Params.Cheby);
+    FunctionHermOp<FermionField> OpCheby(Cheby,HermOp);
+    PlainHermOp<FermionField>    Op(HermOp);
+
+    FermionField eta(FermOp.FermionGrid());
+    FermionField src(FermOp.FermionRedBlackGrid());
+    RNG.SeedFixedIntegers(Seeds);
+    gaussian(RNG,eta);
+    pickCheckerboard(Odd,src,eta);
+
+    evec.resize(Params.Nm,FermOp.FermionRedBlackGrid());
+    eval.resize(Params.Nm);
+    int Nconv;
+    ImplicitlyRestartedLanczos<FermionField> IRL(OpCheby,Op,Params.Nstop,Params.Nk,Params.Nm,
+						  Params.resid,Params.MaxIt,Params.betastp,Params.MinRes);
+    IRL.calc(eval,evec,src,Nconv);
+    evec.resize(Nconv,FermOp.FermionRedBlackGrid());
+    eval.resize(Nconv);
+
+    Ubuilt   = U;
+    Ucurrent = U;
+    built    = true;
+    Timer.Stop();
+    std::cout << GridLogMessage << "SharedDeflationSpace: built "<<Nconv<<" low modes in "<<Timer.Elapsed()<<std::endl;
+  }
+
+public:
+  void Update(const GaugeField &U) {
+    if ( !built || SameGauge(U,Ucurrent) ) return;
+
+    GridStopWatch Timer; Timer.Start();
+    FermOp.ImportGauge(U);
+    SchurDiagMooeeOperator<FermionOperator<Impl>,FermionField> HermOp(FermOp);
+
+    // Rayleigh-Ritz: diagonalise v_i^dag MpcdagMpc v_j in the current space
+    int N = evec.size();
+    Eigen::MatrixXcd H(N,N);
+    FermionField Av(FermOp.FermionRedBlackGrid());
+    std::vector<ComplexD> ip(N);
+    for(int j=0;j<N;j++){
+      HermOp.HermOp(evec[j],Av);
+      basisInnerProducts(ip,evec,Av,0,N);
+      for(int i=0;i<N;i++) H(i,j) = ip[i];
+    }
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXcd> es(H);
+    Eigen::MatrixXcd Qt = es.eigenvectors().transpose();
+    basisRotate(evec,Qt,0,N,0,N,N);
+    for(int i=0;i<N;i++) eval[i] = es.eigenvalues()(i);
+
+    Ucurrent = U;
+    Timer.Stop();
+    std::cout << GridLogMessage << "SharedDeflationSpace: Rayleigh-Ritz update of "<<N<<" modes in "<<Timer.Elapsed()<<std::endl;
+
+    if ( Params.RebuildResid > 0.0 ) {
+      RealD resid = 0.0;
+      for(int i=0;i<std::min(N,Params.Nstop);i++){
+	HermOp.HermOp(evec[i],Av);
+	RealD nAv = norm2(Av);
+	Av = Av - eval[i]*evec[i];
+	resid = std::max(resid,std::sqrt(norm2(Av)/nAv));
+      }
+      std::cout << GridLogMessage << "SharedDeflationSpace: largest relative Ritz residual "<<resid<<std::endl;
+      if ( resid > Params.RebuildResid ) {
+	std::cout << GridLogMessage << "SharedDeflationSpace: Ritz residual above "<<Params.RebuildResid<<", rebuilding"<<std::endl;
+	Build(U);
+	rebuilds++;
+      }
+    }
+  }
+
+  // Deflated initial guess for MpcdagMpc x = src on the odd checkerboard
+  void operator()(const FermionField &src, FermionField &guess) {
+    guess.Checkerboard() = src.Checkerboard();
+    basisDeflate(evec,eval,src,guess);
+  }
+
+  // Low mode correction of an existing (e.g. chronological) guess
+  void Correct(LinearOperatorBase<FermionField> &HermOp, const FermionField &src, FermionField &guess) {
+    if ( evec.size() == 0 ) return;
+    if ( norm2(guess) == 0.0 ) { (*this)(src,guess); return; }
+    FermionField r(src.Grid());
+    FermionField dx(src.Grid());
+    HermOp.HermOp(guess,r);
+    r = src - r;
+    (*this)(r,dx);
+    guess = guess + dx;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Named deflation spaces, owned by the HMC resource manager. The first action
+// asking for a name builds the space on its operator with its parameters;
+// later actions giving the same name share it and must invert the same
+// operator, which is checked.
+////////////////////////////////////////////////////////////////////////////////
+class SharedDeflationSpaces {
+  struct Entry {
+    std::type_index type;
+    std::shared_ptr<void> space;
+  };
+  std::map<std::string,Entry> spaces;
+
+public:
+  template<class Impl>
+  SharedDeflationSpace<Impl> *Get(const std::string &name, FermionOperator<Impl> &Op, SharedDeflationSpaceParameters &P)
+  {
+    std::type_index type(typeid(SharedDeflationSpace<Impl>));
+    auto it = spaces.find(name);
+    if ( it == spaces.end() ) {
+      std::cout << GridLogMessage << "SharedDeflationSpaces: creating '" << name << "'" << std::endl;
+      it = spaces.emplace(name,Entry{type,std::make_shared<SharedDeflationSpace<Impl> >(Op,P)}).first;
+    }
+    assert(it->second.type == type);
+    SharedDeflationSpace<Impl> *space = static_cast<SharedDeflationSpace<Impl> *>(it->second.space.get());
+    if ( !space->SameOperator(Op) ) {
+      std::cout << GridLogError << "SharedDeflationSpaces: '" << name << "' is shared by actions with different operators" << std::endl;
+      assert(0);
+    }
+    return space;
+  }
+};
+
+NAMESPACE_END(Grid);
+
+#endif
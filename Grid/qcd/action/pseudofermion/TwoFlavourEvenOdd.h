@@ -51,6 +51,9 @@ private:
   FermionField PhiOdd;   // the pseudo fermion field for this trajectory
   FermionField PhiEven;  // the pseudo fermion field for this trajectory
 
+  ChronoForecast<FermionOperator<Impl>,FermionField> DerivForecast; // previous force solutions, this trajectory
+  SharedDeflationSpace<Impl> *LowModes = nullptr;        // optional, shared with other light quark actions
+
 public:
   /////////////////////////////////////////////////
   // Pass in required objects.
@@ -65,6 +68,12 @@ public:
       PhiOdd(Op.FermionRedBlackGrid())
   {};
   
+  // Extrapolate the force solve initial guess from up to depth previous solutions; 0 disables
+  void SetForecastDepth(int depth) { DerivForecast.Depth = depth; DerivForecast.Reset(); }
+
+  // Low mode space of the (denominator) operator used to deflate the force solve guess
+  void SetDeflationSpace(SharedDeflationSpace<Impl> *space) { LowModes = space; }
+
   virtual std::string action_name(){return "TwoFlavourEvenOddPseudoFermionAction";}
       
   virtual std::string LogParameters(){
@@ -105,7 +114,9 @@ public:
     
     PhiOdd =PhiOdd*scale;
     PhiEven=PhiEven*scale;
-    
+
+    DerivForecast.Reset();
+    if ( LowModes ) LowModes->Refresh(U);
   };
   
   //////////////////////////////////////////////////////
@@ -155,8 +166,13 @@ public:
     // Our conventions really make this UdSdU; We do not differentiate wrt Udag here.
     // So must take dSdU - adj(dSdU) and left multiply by mom to get dS/dt.
 
-    X=Zero();
+    DerivForecast(Mpc,PhiOdd,X);
+    if ( LowModes ) {
+      LowModes->Update(U);
+      LowModes->Correct(Mpc,PhiOdd,X);
+    }
     DerivativeSolver(Mpc,PhiOdd,X);
+    DerivForecast.Update(X);
     Mpc.Mpc(X,Y);
     Mpc.MpcDeriv(tmp , Y, X );    dSdU=tmp;
     Mpc.MpcDagDeriv(tmp , X, Y);  dSdU=dSdU+tmp;
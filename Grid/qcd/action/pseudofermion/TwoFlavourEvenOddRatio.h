@@ -50,6 +50,9 @@ NAMESPACE_BEGIN(Grid);
       FermionField PhiOdd;   // the pseudo fermion field for this trajectory
       FermionField PhiEven;  // the pseudo fermion field for this trajectory
 
+      ChronoForecast<FermionOperator<Impl>,FermionField> DerivForecast; // previous force solutions, this trajectory
+      SharedDeflationSpace<Impl> *LowModes = nullptr;        // optional, shared with other light quark actions
+
     public:
       TwoFlavourEvenOddRatioPseudoFermionAction(FermionOperator<Impl>  &_NumOp, 
                                                 FermionOperator<Impl>  &_DenOp, 
@@ -75,6 +78,12 @@ NAMESPACE_BEGIN(Grid);
           conformable(_NumOp.GaugeRedBlackGrid(), _DenOp.GaugeRedBlackGrid());
         };
 
+      // Extrapolate the force solve initial guess from up to depth previous solutions; 0 disables
+      void SetForecastDepth(int depth) { DerivForecast.Depth = depth; DerivForecast.Reset(); }
+
+      // Low mode space of the (denominator) operator used to deflate the force solve guess
+      void SetDeflationSpace(SharedDeflationSpace<Impl> *space) { LowModes = space; }
+
       virtual std::string action_name(){return "TwoFlavourEvenOddRatioPseudoFermionAction";}
 
       virtual std::string LogParameters(){
@@ -127,7 +136,9 @@ NAMESPACE_BEGIN(Grid);
 
         PhiOdd =PhiOdd*scale;
         PhiEven=PhiEven*scale;
-        
+
+        DerivForecast.Reset();
+        if ( LowModes ) LowModes->Refresh(U);
       };
 
       //////////////////////////////////////////////////////
@@ -187,8 +198,13 @@ NAMESPACE_BEGIN(Grid);
         //X = (Mdag M)^-1 V^dag phi
         //Y = (Mdag)^-1 V^dag  phi
         Vpc.MpcDag(PhiOdd,Y);          // Y= Vdag phi
-        X=Zero();
+        DerivForecast(Mpc,Y,X);
+        if ( LowModes ) {
+          LowModes->Update(U);
+          LowModes->Correct(Mpc,Y,X);
+        }
         DerivativeSolver(Mpc,Y,X);     // X= (MdagM)^-1 Vdag phi
+        DerivForecast.Update(X);
         Mpc.Mpc(X,Y);                  // Y=  Mdag^-1 Vdag phi
 
         // phi^dag V (Mdag M)^-1 dV^dag  phi
@@ -177,6 +177,9 @@ private:
 
     // Run it
     HMC.evolve();
+
+    // Complete any background checkpoint writes
+    Resources.GetCheckPointer()->Flush();
   }
 };
 
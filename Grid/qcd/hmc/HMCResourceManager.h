@@ -88,6 +88,10 @@ class HMCResourceManager {
   std::multimap<int, std::unique_ptr<ActionBaseModule> > ActionsList;
   std::vector<int> multipliers;
 
+  // Low mode spaces shared between actions; declared after the actions so
+  // they are destroyed before the operators they refer to
+  SharedDeflationSpaces DeflationSpaces;
+
   bool have_RNG;
   bool have_CheckPointer;
 
@@ -170,6 +174,7 @@ public:
  
     for(auto it = ActionsList.begin(); it != ActionsList.end(); it++){
       (*it).second->acquireResource(Grids["gauge"]);
+      (*it).second->acquireDeflationSpaces(DeflationSpaces);
       Aset[(*it).first-1].push_back((*it).second->getPtr());
     }
   }
@@ -266,6 +271,8 @@ public:
   }
 
   RegisterLoadCheckPointerFunction(Binary);
+  RegisterLoadCheckPointerFunction(AsyncBinary);
+  RegisterLoadCheckPointerFunction(Block);
   RegisterLoadCheckPointerFunction(Nersc);
 #ifdef HAVE_LIME
   RegisterLoadCheckPointerFunction(ILDG);
@@ -39,6 +39,10 @@ directory
 #include <Grid/parallelIO/IldgIOtypes.h>
 #include <Grid/parallelIO/IldgIO.h>
 #include <Grid/parallelIO/NerscIO.h>
+#include <Grid/parallelIO/BlockIO.h>
+#include <Grid/parallelIO/CompressedIO.h>
+#include <Grid/parallelIO/MappedIO.h>
+#include <Grid/parallelIO/Hdf5LatticeIO.h>
 #include <Grid/parallelIO/OpenQcdIO.h>
 #if !defined(GRID_COMMS_NONE)
 #include <Grid/parallelIO/OpenQcdIOChromaReference.h>
@@ -0,0 +1,332 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/hmc/AsyncBinaryCheckpointer.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef ASYNC_BINARY_CHECKPOINTER
+#define ASYNC_BINARY_CHECKPOINTER
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////
+// Binary checkpointer writing in the background.
+//
+// TrajectoryComplete only stages the configuration and RNG state in lexicographic
+// order and queues them; munging, checksums, byte ordering, the file writes and
+// the read-back check run on a helper thread while the next trajectory proceeds.
+// The helper never communicates: every rank writes its own sub-volume with
+// positioned I/O (BinaryIO::IOobjectLocal). The global checksum reduction is
+// deferred to the main thread, when a write is retired.
+//
+// At most MaxPending writes are outstanding; further saves first retire the
+// oldest, blocking if it has not finished. Flush() retires all of them and is
+// called at the end of the HMC run and before any restore. Retiring is
+// collective, so it is never done from the destructor: an owner that does not
+// flush gets a warning, and the destructor only waits for the local writes to
+// land, reporting local failures; their checksums are never reduced or printed.
+//
+// Files are identical to those of BinaryHmcCheckpointer and read back by it,
+// except that BinaryIO::writeRNG appends the serial RNG state once per rank and
+// this writer once, from the boss; readers take the last copy.
+///////////////////////////////////////////////////////////////////////////////
+template <class Impl>
+class AsyncBinaryHmcCheckpointer : public BinaryHmcCheckpointer<Impl> {
+public:
+  INHERIT_FIELD_TYPES(Impl);
+
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::scalar_object sobj;
+  typedef typename sobj::DoublePrecision sobj_double;
+
+  typedef typename GridSerialRNG::RngStateType RngStateType;
+  static const int RngStateCount = GridSerialRNG::RngStateCount;
+  typedef std::array<RngStateType,RngStateCount> RNGstate;
+
+private:
+  struct Job {
+    int traj;
+    GridBase *grid;
+    std::string config, rng;
+    std::vector<sobj>     scalardata; // staged configuration
+    std::vector<RNGstate> rngdata;    // staged parallel RNG
+    std::vector<RNGstate> serialdata; // staged serial RNG
+    uint32_t nersc_csum, scidac_csuma, scidac_csumb;
+    uint32_t rng_nersc_csum, rng_scidac_csuma, rng_scidac_csumb;
+    bool rng_written; // counter based RNG: a few words, written synchronously
+    bool ok;
+    bool done;
+  };
+
+  int MaxPending;
+  std::deque<std::shared_ptr<Job> > pending; // main thread, in submission order
+  std::deque<std::shared_ptr<Job> > work;    // shared with the writer
+  std::mutex mtx;
+  std::condition_variable cv;
+  bool stop;
+  std::thread writer;
+
+public:
+  AsyncBinaryHmcCheckpointer(const CheckpointerParameters &Params_, int _MaxPending = 1)
+    : BinaryHmcCheckpointer<Impl>(Params_), MaxPending(_MaxPending), stop(false)
+  {
+    assert(MaxPending>=1);
+    writer = std::thread([this]{ this->WriterLoop(); });
+  }
+
+  // Local only: drains the writer thread without communicating
+  ~AsyncBinaryHmcCheckpointer() {
+    if ( pending.size() ) {
+      std::cout << GridLogWarning << "AsyncBinaryHmcCheckpointer destroyed with " << pending.size()
+		<< " unretired write(s); call Flush() first" << std::endl;
+    }
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      stop = true;
+    }
+    cv.notify_all();
+    writer.join();
+    for(auto &job : pending) {
+      if ( !job->ok ) std::cout << GridLogError << "Background write of " << job->config << " failed on this rank" << std::endl;
+    }
+  }
+
+  void TrajectoryComplete(int traj, Field &U, GridSerialRNG &sRNG, GridParallelRNG &pRNG) {
+
+    if ((traj % this->Params.saveInterval) != 0) return;
+
+    GridBase *grid = U.Grid();
+
+    while ( (int)pending.size() >= MaxPending ) Retire();
+
+    GridStopWatch timer; timer.Start();
+    std::shared_ptr<Job> job(new Job);
+    job->traj = traj;
+    job->grid = grid;
+    job->ok   = true;
+    job->done = false;
+    job->rng_written = pRNG.CounterBased();
+    this->build_filenames(traj, this->Params, job->config, job->rng);
+
+    // Snapshot; cheap local copies, everything else is deferred
+    job->scalardata.resize(grid->lSites());
+    unvectorizeToLexOrdArray(job->scalardata,U);
+    if ( !job->rng_written ) StageRNG(sRNG,pRNG,job->rngdata,job->serialdata);
+
+    if ( grid->IsBoss() ) {
+      this->truncate(job->config);
+      if ( !job->rng_written ) this->truncate(job->rng);
+    }
+    grid->Barrier();
+    if ( job->rng_written ) {
+      BinaryIO::writeRNG(sRNG,pRNG,job->rng,0,job->rng_nersc_csum,job->rng_scidac_csuma,job->rng_scidac_csumb);
+    }
+    timer.Stop();
+
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      work.push_back(job);
+    }
+    cv.notify_all();
+    pending.push_back(job);
+
+    std::cout << GridLogMessage << "Queued Binary Configuration " << job->config
+	      << " for background write; staging took " << timer.Elapsed() << std::endl;
+  };
+
+  void Flush(void) {
+    while ( pending.size() ) Retire();
+  }
+
+  void CheckpointRestore(int traj, Field &U, GridSerialRNG &sRNG, GridParallelRNG &pRNG) {
+    Flush();
+    BinaryHmcCheckpointer<Impl>::CheckpointRestore(traj,U,sRNG,pRNG);
+  };
+
+private:
+
+  void StageRNG(GridSerialRNG &sRNG, GridParallelRNG &pRNG,
+		std::vector<RNGstate> &rngdata, std::vector<RNGstate> &serialdata) {
+    GridBase *grid = pRNG.Grid();
+    uint64_t lsites = grid->lSites();
+    rngdata.resize(lsites);
+    thread_for(lidx,lsites,{
+      std::vector<RngStateType> tmp(RngStateCount);
+      Coordinate lcoor;
+      grid->LocalIndexToLocalCoor(lidx, lcoor);
+      int o_idx=grid->oIndex(lcoor);
+      int i_idx=grid->iIndex(lcoor);
+      int gidx=pRNG.generator_idx(o_idx,i_idx);
+      pRNG.GetState(tmp,gidx);
+      std::copy(tmp.begin(),tmp.end(),rngdata[lidx].begin());
+    });
+    serialdata.resize(1);
+    std::vector<RngStateType> tmp(RngStateCount);
+    sRNG.GetState(tmp,0);
+    std::copy(tmp.begin(),tmp.end(),serialdata[0].begin());
+  }
+
+  // Wait for the oldest write, then reduce its checksums; collective
+  void Retire(void) {
+    std::shared_ptr<Job> job = pending.front();
+    pending.pop_front();
+    {
+      std::unique_lock<std::mutex> lock(mtx);
+      cv.wait(lock,[&]{ return job->done; });
+    }
+
+    GridBase *grid = job->grid;
+    uint32_t failed = job->ok ? 0 : 1;
+    grid->GlobalSum(failed);
+    if ( failed ) {
+      std::cout << GridLogError << "Background write of " << job->config << " failed on "
+		<< failed << " rank(s)" << std::endl;
+      exit(1);
+    }
+    grid->GlobalSum(job->nersc_csum);
+    grid->GlobalXOR(job->scidac_csuma);
+    grid->GlobalXOR(job->scidac_csumb);
+    if ( !job->rng_written ) {
+      grid->GlobalSum(job->rng_nersc_csum);
+      grid->GlobalXOR(job->rng_scidac_csuma);
+      grid->GlobalXOR(job->rng_scidac_csumb);
+    }
+
+    std::cout << GridLogMessage << "Written Binary Configuration " << job->config
+	      << " checksum " << std::hex
+	      << job->nersc_csum   <<"/"
+	      << job->scidac_csuma <<"/"
+	      << job->scidac_csumb
+	      << std::dec << std::endl;
+    std::cout << GridLogMessage << "Written RNG " << job->rng
+	      << " checksum " << std::hex
+	      << job->rng_nersc_csum   <<"/"
+	      << job->rng_scidac_csuma <<"/"
+	      << job->rng_scidac_csumb
+	      << std::dec << std::endl;
+  }
+
+  ///////////////////////////////////////////////////////////////////////////
+  // Helper thread; runs single threaded to leave the cores to the trajectory
+  ///////////////////////////////////////////////////////////////////////////
+  void WriterLoop(void) {
+#ifdef GRID_OMP
+    omp_set_num_threads(1);
+#endif
+    while (1) {
+      std::shared_ptr<Job> job;
+      {
+	std::unique_lock<std::mutex> lock(mtx);
+	cv.wait(lock,[&]{ return stop || work.size(); });
+	if ( work.empty() ) return; // stop requested and queue drained
+	job = work.front();
+	work.pop_front();
+      }
+      WriteJob(*job);
+      {
+	std::unique_lock<std::mutex> lock(mtx);
+	job->done = true;
+      }
+      cv.notify_all();
+    }
+  }
+
+  template<class fobj>
+  bool WriteChecked(GridBase *grid, std::vector<fobj> &iodata, const std::string &file, uint64_t offset) {
+    int attemptsLeft = std::max(0, BinaryIO::latticeWriteMaxRetry);
+    bool checkWrite  = (BinaryIO::latticeWriteMaxRetry >= 0);
+    while ( attemptsLeft >= 0 ) {
+      if ( !BinaryIO::IOobjectLocal(grid,iodata,file,offset,BinaryIO::BINARYIO_WRITE) ) return false;
+      if ( !checkWrite ) return true;
+      std::vector<fobj> ckiodata(iodata.size());
+      if ( BinaryIO::IOobjectLocal(grid,ckiodata,file,offset,BinaryIO::BINARYIO_READ) &&
+	   (memcmp(&ckiodata[0],&iodata[0],iodata.size()*sizeof(fobj)) == 0) ) return true;
+      attemptsLeft--;
+    }
+    return false;
+  }
+
+  void WriteJob(Job &job) {
+    GridBase *grid  = job.grid;
+    uint64_t lsites = grid->lSites();
+    const std::string &format = this->Params.format;
+
+    int ieee32big = (format == std::string("IEEE32BIG"));
+    int ieee32    = (format == std::string("IEEE32"));
+    int ieee64big = (format == std::string("IEEE64BIG"));
+    int ieee64    = (format == std::string("IEEE64") || format == std::string("IEEE64LITTLE"));
+    assert((ieee64+ieee32+ieee64big+ieee32big)==1);
+
+    // Configuration; as BinaryIO::writeLatticeObject
+    BinarySimpleUnmunger<sobj_double, sobj> munge;
+    std::vector<sobj_double> iodata(lsites);
+    for(uint64_t x=0;x<lsites;x++) munge(job.scalardata[x],iodata[x]);
+    job.scalardata.clear();
+    job.scalardata.shrink_to_fit();
+
+    job.nersc_csum = job.scidac_csuma = job.scidac_csumb = 0;
+    BinaryIO::NerscChecksum(grid,iodata,job.nersc_csum);
+    if (ieee32big) BinaryIO::htobe32_v((void *)&iodata[0], sizeof(sobj_double)*iodata.size());
+    if (ieee32)    BinaryIO::htole32_v((void *)&iodata[0], sizeof(sobj_double)*iodata.size());
+    if (ieee64big) BinaryIO::htobe64_v((void *)&iodata[0], sizeof(sobj_double)*iodata.size());
+    if (ieee64)    BinaryIO::htole64_v((void *)&iodata[0], sizeof(sobj_double)*iodata.size());
+    BinaryIO::ScidacChecksum(grid,iodata,job.scidac_csuma,job.scidac_csumb);
+    job.ok = WriteChecked(grid,iodata,job.config,0);
+    if ( job.rng_written ) return;
+
+    // RNG; as BinaryIO::writeRNG, the serial state appended by the boss
+    uint32_t nersc_tmp=0, csuma_tmp=0, csumb_tmp=0;
+    job.rng_nersc_csum = job.rng_scidac_csuma = job.rng_scidac_csumb = 0;
+    BinaryIO::NerscChecksum(grid,job.rngdata,job.rng_nersc_csum);
+    BinaryIO::htobe32_v((void *)&job.rngdata[0], sizeof(RNGstate)*job.rngdata.size());
+    BinaryIO::ScidacChecksum(grid,job.rngdata,job.rng_scidac_csuma,job.rng_scidac_csumb);
+    job.ok = job.ok && WriteChecked(grid,job.rngdata,job.rng,0);
+
+    BinaryIO::NerscChecksum(grid,job.serialdata,nersc_tmp);
+    BinaryIO::htobe32_v((void *)&job.serialdata[0], sizeof(RNGstate));
+    BinaryIO::ScidacChecksum(grid,job.serialdata,csuma_tmp,csumb_tmp);
+    if ( grid->IsBoss() ) {
+      int fd = ::open(job.rng.c_str(),O_WRONLY);
+      uint64_t offset = grid->gSites()*sizeof(RNGstate);
+      job.ok = job.ok && (fd>=0) && BinaryIO::IOtransfer(fd,(char *)&job.serialdata[0],sizeof(RNGstate),offset,BinaryIO::BINARYIO_WRITE);
+      if ( fd>=0 ) ::close(fd);
+    }
+    // Only the boss's serial state enters the reduction, as reported by BinaryIO::writeRNG
+    if ( grid->IsBoss() ) {
+      job.rng_nersc_csum   += nersc_tmp;
+      job.rng_scidac_csuma ^= csuma_tmp;
+      job.rng_scidac_csumb ^= csumb_tmp;
+    }
+    job.rngdata.clear();
+    job.rngdata.shrink_to_fit();
+  }
+};
+
+NAMESPACE_END(Grid);
+#endif
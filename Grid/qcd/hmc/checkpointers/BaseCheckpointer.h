@@ -89,6 +89,9 @@ public:
                                  GridSerialRNG &sRNG,
                                  GridParallelRNG &pRNG) = 0;
 
+  // Complete any outstanding writes; collective over all ranks
+  virtual void Flush(void) {};
+
 };  // class BaseHmcCheckpointer
 ///////////////////////////////////////////////////////////////////////////////
 
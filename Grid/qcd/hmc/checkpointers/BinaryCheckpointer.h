@@ -38,7 +38,7 @@ NAMESPACE_BEGIN(Grid);
 // Simple checkpointer, only binary file
 template <class Impl>
 class BinaryHmcCheckpointer : public BaseHmcCheckpointer<Impl> {
-private:
+protected:
   CheckpointerParameters Params;
 
 public:
@@ -0,0 +1,82 @@
+/*************************************************************************************
+
+Grid physics library, www.github.com/paboyle/Grid
+
+Source file: ./lib/qcd/hmc/BlockCheckpointer.h
+
+Copyright (C) 2015
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along
+with this program; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+See the full license in the file "LICENSE" in the top level distribution
+directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef BLOCK_CHECKPOINTER
+#define BLOCK_CHECKPOINTER
+
+#include <iostream>
+#include <sstream>
+#include <string>
+
+NAMESPACE_BEGIN(Grid);
+
+// Checkpointer using block structured files (BlockIO): per-block crc32c,
+// ranks read only their own blocks, and an interrupted save of the same
+// trajectory is completed by writing only the blocks that are missing.
+// Params.format is not used; the configuration is stored in double precision
+// in host byte order.
+template <class Impl>
+class BlockHmcCheckpointer : public BaseHmcCheckpointer<Impl> {
+protected:
+  CheckpointerParameters Params;
+
+public:
+  INHERIT_FIELD_TYPES(Impl);
+
+  typedef typename Field::vector_object vobj;
+  typedef typename vobj::scalar_object sobj;
+  typedef typename sobj::DoublePrecision sobj_double;
+
+  BlockHmcCheckpointer(const CheckpointerParameters &Params_) {
+    initialize(Params_);
+  }
+
+  void initialize(const CheckpointerParameters &Params_) { Params = Params_; }
+
+  void TrajectoryComplete(int traj, Field &U, GridSerialRNG &sRNG, GridParallelRNG &pRNG) {
+    if ((traj % Params.saveInterval) == 0) {
+      std::string config, rng;
+      this->build_filenames(traj, Params, config, rng);
+      BlockIO::writeRNGBlocks(sRNG, pRNG, rng);
+      BlockIO::writeLatticeBlocks<vobj, sobj_double>(U, config);
+      std::cout << GridLogMessage << "Written Block Configuration " << config << std::endl;
+    }
+  };
+
+  void CheckpointRestore(int traj, Field &U, GridSerialRNG &sRNG, GridParallelRNG &pRNG) {
+    std::string config, rng;
+    this->build_filenames(traj, Params, config, rng);
+    this->check_filename(rng);
+    this->check_filename(config);
+
+    BlockIO::readRNGBlocks(sRNG, pRNG, rng);
+    BlockIO::readLatticeBlocks<vobj, sobj_double>(U, config);
+    std::cout << GridLogMessage << "Read Block Configuration " << config << std::endl;
+  };
+};
+
+NAMESPACE_END(Grid);
+#endif
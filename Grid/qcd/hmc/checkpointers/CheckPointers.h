@@ -33,6 +33,8 @@ directory
 #include <Grid/qcd/hmc/checkpointers/BaseCheckpointer.h>
 #include <Grid/qcd/hmc/checkpointers/NerscCheckpointer.h>
 #include <Grid/qcd/hmc/checkpointers/BinaryCheckpointer.h>
+#include <Grid/qcd/hmc/checkpointers/AsyncBinaryCheckpointer.h>
+#include <Grid/qcd/hmc/checkpointers/BlockCheckpointer.h>
 #include <Grid/qcd/hmc/checkpointers/ILDGCheckpointer.h>
 #include <Grid/qcd/hmc/checkpointers/ScidacCheckpointer.h>
 //#include <Grid/qcd/hmc/checkpointers/CheckPointerModules.h>
@@ -45,6 +45,7 @@ class ActionModuleBase: public HMCModuleBase<Product>{
 public:
   typedef R Resource;
   virtual void acquireResource(R& ){};
+  virtual void acquireDeflationSpaces(SharedDeflationSpaces& ){};
 
 };
 
@@ -112,14 +113,33 @@ public:
 
 
 
+// Optional <HaloExchange>true</HaloExchange> beside <parameters> selects the
+// single halo exchange force (WilsonLoopsHalo)
+template <class ReaderClass>
+bool readHaloExchange(Reader<ReaderClass>& R){
+  bool halo = false;
+  if (R.push("HaloExchange")) {
+    R.pop();
+    read(R, "HaloExchange", halo);
+  }
+  return halo;
+}
+
 template <class Impl >
 class WilsonGModule: public ActionModule<WilsonGaugeAction<Impl>, BetaGaugeActionParameters> {
   typedef ActionModule<WilsonGaugeAction<Impl>, BetaGaugeActionParameters> ActionBase;
   using ActionBase::ActionBase; // for constructors
+  bool halo = false;
+
+public:
+  template <class ReaderClass>
+  WilsonGModule(Reader<ReaderClass>& R): ActionBase(R), halo(readHaloExchange(R)) {};
 
+private:
   // acquire resource
   virtual void initialize(){
     this->ActionPtr.reset(new WilsonGaugeAction<Impl>(this->Par_.beta));
+    this->ActionPtr->UseHaloExchange(halo);
   }
 
 };
@@ -128,10 +148,17 @@ template <class Impl >
 class PlaqPlusRectangleGModule: public ActionModule<PlaqPlusRectangleAction<Impl>, PlaqPlusRectangleGaugeActionParameters> {
   typedef ActionModule<PlaqPlusRectangleAction<Impl>, PlaqPlusRectangleGaugeActionParameters> ActionBase;
   using ActionBase::ActionBase; // for constructors
+  bool halo = false;
 
+public:
+  template <class ReaderClass>
+  PlaqPlusRectangleGModule(Reader<ReaderClass>& R): ActionBase(R), halo(readHaloExchange(R)) {};
+
+private:
   // acquire resource
   virtual void initialize(){
     this->ActionPtr.reset(new PlaqPlusRectangleAction<Impl>(this->Par_.c_plaq, this->Par_.c_rect));
+    this->ActionPtr->UseHaloExchange(halo);
   }
 
 };
@@ -221,6 +248,27 @@ protected:
     so = SolverFactory.create(solv_name, Reader);
     Reader.pop();    
   }
+
+  // Optional section; when absent the force solves start from a zero guess as before
+  template <class ReaderClass>
+  void getForecastDepth(Reader<ReaderClass>& Reader, int &depth, std::string section_name){
+    depth = 0;
+    if (Reader.push(section_name)) {
+      read(Reader,"depth", depth);
+      Reader.pop();
+    }
+  }
+
+  // Optional section; actions giving the same name share one low mode space
+  template <class ReaderClass>
+  void getDeflationSpace(Reader<ReaderClass>& Reader, std::string &name, SharedDeflationSpaceParameters &par, std::string section_name){
+    name = "";
+    if (Reader.push(section_name)) {
+      read(Reader,"name", name);
+      read(Reader,"Parameters", par);
+      Reader.pop();
+    }
+  }
 };
 
 
@@ -260,23 +308,37 @@ class TwoFlavourEOFModule: public PseudoFermionModuleBase<Impl, TwoFlavourEvenOd
 
   typename Base::operator_type fop_mod;
   typename Base::solver_type   solver_mod;
+  int forecast_depth;
+  std::string deflation_name;
+  SharedDeflationSpaceParameters deflation_par;
+  SharedDeflationSpace<Impl> *deflation = nullptr;
 
 public:
   virtual void acquireResource(typename Base::Resource& GridMod){
     fop_mod->AddGridPair(GridMod);
   }
 
+  virtual void acquireDeflationSpaces(SharedDeflationSpaces& Spaces){
+    if (deflation_name != "") deflation = Spaces.Get<Impl>(deflation_name, *(this->fop_mod->getPtr()), deflation_par);
+  }
+
   // constructor
   template <class ReaderClass>
   TwoFlavourEOFModule(Reader<ReaderClass>& R): PseudoFermionModuleBase<Impl, TwoFlavourEvenOddPseudoFermionAction>(R) {
     this->getSolverOperator(R, solver_mod, "Solver");
     this->getFermionOperator(R, fop_mod, "Operator");
+    this->getForecastDepth(R, forecast_depth, "Forecast");
+    this->getDeflationSpace(R, deflation_name, deflation_par, "Deflation");
   } 
 
   // acquire resource
   virtual void initialize() {
     // here temporarily assuming that the force and action solver are the same
-    this->ActionPtr.reset(new TwoFlavourEvenOddPseudoFermionAction<Impl>(*(this->fop_mod->getPtr()), *(this->solver_mod->getPtr()), *(this->solver_mod->getPtr())));
+    TwoFlavourEvenOddPseudoFermionAction<Impl> *action =
+      new TwoFlavourEvenOddPseudoFermionAction<Impl>(*(this->fop_mod->getPtr()), *(this->solver_mod->getPtr()), *(this->solver_mod->getPtr()));
+    action->SetForecastDepth(forecast_depth);
+    action->SetDeflationSpace(deflation);
+    this->ActionPtr.reset(action);
   }
 
 };
@@ -322,6 +384,10 @@ class TwoFlavourRatioEOFModule: public PseudoFermionModuleBase<Impl, TwoFlavourE
   typename Base::operator_type fop_numerator_mod;
   typename Base::operator_type fop_denominator_mod;
   typename Base::solver_type   solver_mod;
+  int forecast_depth;
+  std::string deflation_name;
+  SharedDeflationSpaceParameters deflation_par;
+  SharedDeflationSpace<Impl> *deflation = nullptr;
 
 public:
   virtual void acquireResource(typename Base::Resource& GridMod){
@@ -329,19 +395,30 @@ public:
     fop_denominator_mod->AddGridPair(GridMod);
   }
 
+  // The force solves invert the denominator
+  virtual void acquireDeflationSpaces(SharedDeflationSpaces& Spaces){
+    if (deflation_name != "") deflation = Spaces.Get<Impl>(deflation_name, *(this->fop_denominator_mod->getPtr()), deflation_par);
+  }
+
   // constructor
   template <class ReaderClass>
   TwoFlavourRatioEOFModule(Reader<ReaderClass>& R): Base(R) {
     this->getSolverOperator(R, solver_mod, "Solver");
     this->getFermionOperator(R, fop_numerator_mod, "Numerator");
     this->getFermionOperator(R, fop_denominator_mod, "Denominator");
+    this->getForecastDepth(R, forecast_depth, "Forecast");
+    this->getDeflationSpace(R, deflation_name, deflation_par, "Deflation");
   } 
 
   // acquire resource
   virtual void initialize() {
     // here temporarily assuming that the force and action solver are the same
-    this->ActionPtr.reset(new TwoFlavourEvenOddRatioPseudoFermionAction<Impl>(*(this->fop_numerator_mod->getPtr()), 
-									      *(this->fop_denominator_mod->getPtr()), *(this->solver_mod->getPtr()), *(this->solver_mod->getPtr())));
+    TwoFlavourEvenOddRatioPseudoFermionAction<Impl> *action =
+      new TwoFlavourEvenOddRatioPseudoFermionAction<Impl>(*(this->fop_numerator_mod->getPtr()), 
+							  *(this->fop_denominator_mod->getPtr()), *(this->solver_mod->getPtr()), *(this->solver_mod->getPtr()));
+    action->SetForecastDepth(forecast_depth);
+    action->SetDeflationSpace(deflation);
+    this->ActionPtr.reset(action);
   }
 
 };
@@ -467,6 +544,87 @@ public:
 
 };
 
+// Single precision partner of a fermion implementation, for the mixed precision actions
+template <class Impl> struct SinglePrecisionImpl;
+template <class S, class Representation, class Options>
+struct SinglePrecisionImpl<WilsonImpl<S,Representation,Options> > {
+  typedef WilsonImpl<vComplexF,Representation,Options> type;
+};
+
+template <class Impl>
+using OneFlavourEvenOddRatioRationalMixedPrecAction =
+  OneFlavourEvenOddRatioRationalMixedPrecPseudoFermionAction<Impl, typename SinglePrecisionImpl<Impl>::type>;
+
+// The multishift solves run in single precision; the single precision
+// operators are read from the same sections as the double precision ones
+template <class Impl >
+class OneFlavourRatioEOMixedPrecFModule: 
+  public PseudoFermionModuleBase<Impl, OneFlavourEvenOddRatioRationalMixedPrecAction, OneFlavourRationalParams>
+{
+
+  typedef PseudoFermionModuleBase<Impl, OneFlavourEvenOddRatioRationalMixedPrecAction, OneFlavourRationalParams> Base;
+  using Base::Base;
+
+  typedef typename SinglePrecisionImpl<Impl>::type ImplF;
+  typedef std::unique_ptr<FermionOperatorModuleBase<FermionOperator<ImplF>> > operatorF_type;
+
+  typename Base::operator_type fop_numerator_mod;
+  typename Base::operator_type fop_denominator_mod;
+  operatorF_type fopF_numerator_mod;
+  operatorF_type fopF_denominator_mod;
+  GridModule GridModF;
+  RealD delta;
+
+  template <class ReaderClass>
+  void getFermionOperatorF(Reader<ReaderClass>& Reader, operatorF_type &fo, std::string section_name){
+    auto &FOFactory = HMC_FermionOperatorModuleFactory<fermionop_string, ImplF, ReaderClass>::getInstance();
+    Reader.push(section_name);
+    std::string op_name;
+    read(Reader,"name", op_name);
+    fo = FOFactory.create(op_name, Reader);
+    Reader.pop();  
+  }
+
+public:
+  virtual void acquireResource(typename Base::Resource& GridMod){
+    fop_numerator_mod->AddGridPair(GridMod);
+    fop_denominator_mod->AddGridPair(GridMod);
+
+    GridCartesian *UGrid = GridMod.get_full();
+    GridModF.set_full(SpaceTimeGrid::makeFourDimGrid(UGrid->FullDimensions(),
+						     GridDefaultSimd(Nd,vComplexF::Nsimd()),
+						     UGrid->ProcessorGrid()));
+    GridModF.set_rb(SpaceTimeGrid::makeFourDimRedBlackGrid(GridModF.get_full()));
+    fopF_numerator_mod->AddGridPair(GridModF);
+    fopF_denominator_mod->AddGridPair(GridModF);
+  }
+
+  // constructor
+  template <class ReaderClass>
+  OneFlavourRatioEOMixedPrecFModule(Reader<ReaderClass>& R): Base(R) {
+    this->getFermionOperator(R, fop_numerator_mod, "Numerator");
+    this->getFermionOperator(R, fop_denominator_mod, "Denominator");
+    getFermionOperatorF(R, fopF_numerator_mod, "Numerator");
+    getFermionOperatorF(R, fopF_denominator_mod, "Denominator");
+    // Optional section
+    delta = 0.1;
+    if (R.push("ReliableUpdate")) {
+      read(R,"Delta", delta);
+      R.pop();
+    }
+  } 
+
+  // acquire resource
+  virtual void initialize() {
+    this->ActionPtr.reset(new OneFlavourEvenOddRatioRationalMixedPrecAction<Impl>(*(this->fop_numerator_mod->getPtr()), 
+										 *(this->fop_denominator_mod->getPtr()), 
+										 *(this->fopF_numerator_mod->getPtr()), 
+										 *(this->fopF_denominator_mod->getPtr()), 
+										 this->Par_, delta));
+  }
+
+};
+
 ////////////////////////////////////////
 // Factories specialisations
 ////////////////////////////////////////
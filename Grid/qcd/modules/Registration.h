@@ -67,6 +67,10 @@ static Registrar<OneFlavourRatioFModule<FermionImplementationPolicy> ,
 		 HMC_ActionModuleFactory<gauge_string, typename ImplementationPolicy::Field, Serialiser> > __OneFlavourRatioFmodXMLInit("OneFlavourRatio"); 
 static Registrar<OneFlavourRatioEOFModule<FermionImplementationPolicy>,
 		 HMC_ActionModuleFactory<gauge_string, typename ImplementationPolicy::Field, Serialiser> > __OneFlavourRatioEOFmodXMLInit("OneFlavourEvenOddRatio"); 
+#ifndef GRID_DEFAULT_PRECISION_SINGLE
+static Registrar<OneFlavourRatioEOMixedPrecFModule<FermionImplementationPolicy>,
+		 HMC_ActionModuleFactory<gauge_string, typename ImplementationPolicy::Field, Serialiser> > __OneFlavourRatioEOMPFmodXMLInit("OneFlavourEvenOddRatioMixedPrec"); 
+#endif
 
 
 
@@ -100,6 +104,17 @@ static Registrar< MobiusFermionModule<FermionImplementationPolicy>,
 static Registrar< DomainWallFermionModule<FermionImplementationPolicy>,   
                   HMC_FermionOperatorModuleFactory<fermionop_string, FermionImplementationPolicy, Serialiser> > __DWFOPmodXMLInit("DomainWall");
 
+#ifndef GRID_DEFAULT_PRECISION_SINGLE
+// Single precision copies for the mixed precision actions
+typedef typename SinglePrecisionImpl<FermionImplementationPolicy>::type FermionImplementationPolicyF;
+static Registrar< WilsonFermionModule<FermionImplementationPolicyF>,   
+                  HMC_FermionOperatorModuleFactory<fermionop_string, FermionImplementationPolicyF, Serialiser> > __WilsonFOPFmodXMLInit("Wilson"); 
+static Registrar< MobiusFermionModule<FermionImplementationPolicyF>,   
+                  HMC_FermionOperatorModuleFactory<fermionop_string, FermionImplementationPolicyF, Serialiser> > __MobiusFOPFmodXMLInit("Mobius");
+static Registrar< DomainWallFermionModule<FermionImplementationPolicyF>,   
+                  HMC_FermionOperatorModuleFactory<fermionop_string, FermionImplementationPolicyF, Serialiser> > __DWFOPFmodXMLInit("DomainWall");
+#endif
+
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Observables
@@ -112,6 +127,8 @@ static Registrar<PlaquetteMod<ImplementationPolicy>, HMC_ObservablesModuleFactor
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 static Registrar<BinaryCPModule<ImplementationPolicy>, HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPBinarymodXMLInit("Binary");
+static Registrar<AsyncBinaryCPModule<ImplementationPolicy>, HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPAsyncBinarymodXMLInit("AsyncBinary");
+static Registrar<BlockCPModule<ImplementationPolicy>, HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPBlockmodXMLInit("Block");
 static Registrar<NerscCPModule<ImplementationPolicy> , HMC_CPModuleFactory<cp_string, ImplementationPolicy, Serialiser> > __CPNerscmodXMLInit("Nersc");
 
 #ifdef HAVE_LIME
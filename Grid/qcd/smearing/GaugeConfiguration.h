@@ -88,15 +88,15 @@ private:
   {
     GridBase* grid = GaugeK.Grid();
     GaugeField C(grid), SigmaK(grid), iLambda(grid);
+
+    StoutSmearing->BaseSmear(C, GaugeK);
+
+#ifdef GRID_CUDA
+    // Lattice-wide form; the site kernel is not validated on CUDA
     GaugeLinkField iLambda_mu(grid);
     GaugeLinkField iQ(grid), e_iQ(grid);
     GaugeLinkField SigmaKPrime_mu(grid);
     GaugeLinkField GaugeKmu(grid), Cmu(grid);
-
-    StoutSmearing->BaseSmear(C, GaugeK);
-    SigmaK = Zero();
-    iLambda = Zero();
-
     for (int mu = 0; mu < Nd; mu++)
     {
       Cmu = peekLorentz(C, mu);
@@ -107,6 +107,29 @@ private:
       pokeLorentz(SigmaK, SigmaKPrime_mu * e_iQ + adj(Cmu) * iLambda_mu, mu);
       pokeLorentz(iLambda, iLambda_mu, mu);
     }
+#else
+    // exp(iQ), Lambda and Sigma for all directions in one pass over the links
+    {
+      autoView(C_v, C, AcceleratorRead);
+      autoView(GaugeK_v, GaugeK, AcceleratorRead);
+      autoView(SigmaKPrime_v, SigmaKPrime, AcceleratorRead);
+      autoView(SigmaK_v, SigmaK, AcceleratorWrite);
+      autoView(iLambda_v, iLambda, AcceleratorWrite);
+      accelerator_for(ss, grid->oSites(), 1, {
+        for (int mu = 0; mu < Nd; mu++)
+        {
+          auto Cmu = C_v[ss](mu)();
+          auto GaugeKmu = GaugeK_v[ss](mu)();
+          auto SigmaKPrime_mu = SigmaKPrime_v[ss](mu)();
+          auto iQ = Ta(Cmu * adj(GaugeKmu));
+          decltype(iQ) iLambda_mu, e_iQ;
+          Smear_Stout<Gimpl>::site_iLambda(iLambda_mu, e_iQ, iQ, SigmaKPrime_mu, GaugeKmu);
+          SigmaK_v[ss](mu)() = SigmaKPrime_mu * e_iQ + adj(Cmu) * iLambda_mu;
+          iLambda_v[ss](mu)() = iLambda_mu;
+        }
+      });
+    }
+#endif
     StoutSmearing->derivative(SigmaK, iLambda,
                              GaugeK);  // derivative of SmearBase
     return SigmaK;
@@ -118,6 +141,7 @@ private:
     return SmearedSet[Level];
   }
 
+#ifdef GRID_CUDA
   //====================================================================
   void set_iLambda(GaugeLinkField& iLambda, GaugeLinkField& e_iQ,
                    const GaugeLinkField& iQ, const GaugeLinkField& Sigmap,
@@ -210,6 +234,7 @@ private:
 
     iLambda = Ta(iGamma);
   }
+#endif
 
   //====================================================================
 public:
@@ -81,26 +81,43 @@ public:
 
   void smear(GaugeField& u_smr, const GaugeField& U) const {
     GaugeField C(U.Grid());
-    GaugeLinkField tmp(U.Grid()), iq_mu(U.Grid()), Umu(U.Grid());
 
     std::cout << GridLogDebug << "Stout smearing started\n";
 
     // Smear the configurations
     SmearBase->smear(C, U);
 
+#ifdef GRID_CUDA
+    // Lattice-wide form; the site kernel is not validated on CUDA
+    GaugeLinkField tmp(U.Grid()), iq_mu(U.Grid()), Umu(U.Grid());
     for (int mu = 0; mu < Nd; mu++) {
-      if( mu == OrthogDim )
-        tmp = 1.0;  // Don't smear in the orthogonal direction
-      else {
+      Umu = peekLorentz(U, mu);
+      if( mu == OrthogDim ) {
+        pokeLorentz(u_smr, Umu, mu);  // Don't smear in the orthogonal direction
+      } else {
         tmp = peekLorentz(C, mu);
-        Umu = peekLorentz(U, mu);
-        iq_mu = Ta(
-                   tmp *
-                   adj(Umu));  // iq_mu = Ta(Omega_mu) to match the signs with the paper
+        iq_mu = Ta(tmp * adj(Umu));  // iq_mu = Ta(Omega_mu) to match the signs with the paper
         exponentiate_iQ(tmp, iq_mu);
+        pokeLorentz(u_smr, tmp * Umu, mu);  // u_smr = exp(iQ_mu)*U_mu
       }
-      pokeLorentz(u_smr, tmp * Umu, mu);  // u_smr = exp(iQ_mu)*U_mu
     }
+#else
+    // u_smr = exp(iQ_mu)*U_mu with iQ_mu = Ta(Omega_mu), one pass over the links
+    int orthog = OrthogDim;
+    autoView(C_v, C, AcceleratorRead);
+    autoView(U_v, U, AcceleratorRead);
+    autoView(u_smr_v, u_smr, AcceleratorWrite);
+    accelerator_for(ss, U.Grid()->oSites(), 1, {
+      for (int mu = 0; mu < Nd; mu++) {
+        if ( mu == orthog ) {
+          u_smr_v[ss](mu) = U_v[ss](mu);  // Don't smear in the orthogonal direction
+        } else {
+          auto iQ = Ta(C_v[ss](mu)() * adj(U_v[ss](mu)()));  // to match the signs with the paper
+          u_smr_v[ss](mu)() = site_exponentiate_iQ(iQ) * U_v[ss](mu)();
+        }
+      }
+    });
+#endif
     std::cout << GridLogDebug << "Stout smearing completed\n";
   };
 
@@ -114,9 +131,7 @@ public:
   };
 
 
-  // Repetion of code here (use the Tensor_exp.h function)
   void exponentiate_iQ(GaugeLinkField& e_iQ, const GaugeLinkField& iQ) const {
-    // Put this outside
     // only valid for SU(3) matrices
 
     // only one Lorentz direction at a time
@@ -125,7 +140,8 @@ public:
     // exp ( input matrix )
     // the i sign is coming from outside
     // input matrix is anti-hermitian NOT hermitian
-
+#ifdef GRID_CUDA
+    // Lattice-wide form; the site kernel is not validated on CUDA
     GridBase* grid = iQ.Grid();
     GaugeLinkField unity(grid);
     unity = 1.0;
@@ -137,13 +153,116 @@ public:
     iQ2 = iQ * iQ;
     iQ3 = iQ * iQ2;
 
-    //We should check sgn(c0) here already and then apply eq (34) from 0311018
     set_uw(u, w, iQ2, iQ3);
     set_fj(f0, f1, f2, u, w);
 
     e_iQ = f0 * unity + timesMinusI(f1) * iQ - f2 * iQ2;
+#else
+    autoView(iQ_v, iQ, AcceleratorRead);
+    autoView(e_iQ_v, e_iQ, AcceleratorWrite);
+    accelerator_for(ss, iQ.Grid()->oSites(), 1, {
+      e_iQ_v[ss]()() = site_exponentiate_iQ(iQ_v[ss]()());
+    });
+#endif
   };
 
+  ////////////////////////////////////////////////////////////////////////
+  // Site kernels on the colour matrix (Cayley-Hamilton, hep-lat/0311018).
+  // Everything stays in registers, so smearing and the smeared force are
+  // single passes over the gauge field with no lattice temporaries.
+  ////////////////////////////////////////////////////////////////////////
+  template <class vtype, int N>
+  static accelerator_inline iMatrix<vtype, N> site_exponentiate_iQ(const iMatrix<vtype, N>& iQ) {
+    typedef iScalar<vtype> scalar;
+    iMatrix<vtype, N> unity(1.0);
+    iMatrix<vtype, N> iQ2 = iQ * iQ;
+    iMatrix<vtype, N> iQ3 = iQ * iQ2;
+    scalar u, w, f0, f1, f2;
+    CayleyHamiltonCoefficients(u, w, f0, f1, f2, iQ2, iQ3);
+    return f0 * unity + timesMinusI(f1) * iQ - f2 * iQ2;
+  }
+
+  // e_iQ = exp(iQ) and iLambda of eq (73) for the force Sigmap on the smeared link
+  template <class vtype, int N>
+  static accelerator_inline void site_iLambda(iMatrix<vtype, N>& iLambda, iMatrix<vtype, N>& e_iQ,
+                                              const iMatrix<vtype, N>& iQ, const iMatrix<vtype, N>& Sigmap,
+                                              const iMatrix<vtype, N>& GaugeK) {
+    typedef iScalar<vtype> scalar;
+    typedef iMatrix<vtype, N> mat;
+    mat unity(1.0);
+    scalar one(1.0);
+    scalar u, w, f0, f1, f2;
+    scalar xi0, xi1, u2, w2, cosw, sinw;
+    scalar emiu, e2iu, fden;
+    scalar r01, r11, r21, r02, r12, r22;
+    scalar b10, b11, b12, b20, b21, b22;
+
+    // Exponential
+    mat iQ2 = iQ * iQ;
+    mat iQ3 = iQ * iQ2;
+    CayleyHamiltonCoefficients(u, w, f0, f1, f2, iQ2, iQ3);
+    e_iQ = f0 * unity + timesMinusI(f1) * iQ - f2 * iQ2;
+
+    // Getting B1, B2, Gamma and Lambda
+    u2 = u * u;
+    w2 = w * w;
+    cosw = cos(w);
+    sinw = sin(w);
+    xi0 = sinw / w;
+    xi1 = cosw / w2 - sinw / (w2 * w);
+
+    emiu = cos(u) - timesI(sin(u));
+    e2iu = cos(2.0 * u) + timesI(sin(2.0 * u));
+
+    r01 = (2.0 * u + timesI(2.0 * (u2 - w2))) * e2iu +
+      emiu * ((16.0 * u * cosw + 2.0 * u * (3.0 * u2 + w2) * xi0) +
+	      timesI(-8.0 * u2 * cosw + 2.0 * (9.0 * u2 + w2) * xi0));
+
+    r11 = (2.0 * one + timesI(4.0 * u)) * e2iu +
+      emiu * ((-2.0 * cosw + (3.0 * u2 - w2) * xi0) +
+	      timesI((2.0 * u * cosw + 6.0 * u * xi0)));
+
+    r21 =
+      2.0 * timesI(e2iu) + emiu * (-3.0 * u * xi0 + timesI(cosw - 3.0 * xi0));
+
+    r02 = -2.0 * e2iu +
+      emiu * (-8.0 * u2 * xi0 +
+	      timesI(2.0 * u * (cosw + xi0 + 3.0 * u2 * xi1)));
+
+    r12 = emiu * (2.0 * u * xi0 + timesI(-cosw - xi0 + 3.0 * u2 * xi1));
+
+    r22 = emiu * (xi0 - timesI(3.0 * u * xi1));
+
+    fden = one / (2.0 * (9.0 * u2 - w2) * (9.0 * u2 - w2));
+
+    b10 = 2.0 * u * r01 + (3.0 * u2 - w2) * r02 - (30.0 * u2 + 2.0 * w2) * f0;
+    b11 = 2.0 * u * r11 + (3.0 * u2 - w2) * r12 - (30.0 * u2 + 2.0 * w2) * f1;
+    b12 = 2.0 * u * r21 + (3.0 * u2 - w2) * r22 - (30.0 * u2 + 2.0 * w2) * f2;
+
+    b20 = r01 - (3.0 * u) * r02 - (24.0 * u) * f0;
+    b21 = r11 - (3.0 * u) * r12 - (24.0 * u) * f1;
+    b22 = r21 - (3.0 * u) * r22 - (24.0 * u) * f2;
+
+    b10 = b10 * fden;
+    b11 = b11 * fden;
+    b12 = b12 * fden;
+    b20 = b20 * fden;
+    b21 = b21 * fden;
+    b22 = b22 * fden;
+
+    mat B1 = b10 * unity + timesMinusI(b11) * iQ - b12 * iQ2;
+    mat B2 = b20 * unity + timesMinusI(b21) * iQ - b22 * iQ2;
+    mat USigmap = GaugeK * Sigmap;
+
+    scalar tr1 = trace(USigmap * B1);
+    scalar tr2 = trace(USigmap * B2);
+
+    mat iGamma = tr1 * iQ - timesI(tr2) * iQ2 +
+      timesI(f1) * USigmap + f2 * (iQ * USigmap) + f2 * (USigmap * iQ);
+
+    iLambda = Ta(iGamma);
+  }
+
   void set_uw(LatticeComplex& u, LatticeComplex& w, GaugeLinkField& iQ2,
               GaugeLinkField& iQ3) const {
     Complex one_over_three = 1.0 / 3.0;
@@ -86,19 +86,15 @@ template <class Gimpl>
 void WilsonFlow<Gimpl>::evolve_step(typename Gimpl::GaugeField &U) const{
   GaugeField Z(U.Grid());
   GaugeField tmp(U.Grid());
+  // Each stage combines Z and the new force and updates U in one pass
   SG.deriv(U, Z);
-  Z *= 0.25;                                  // Z0 = 1/4 * F(U)
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // U = W1 = exp(ep*Z0)*W0
-
-  Z *= -17.0/8.0;
-  SG.deriv(U, tmp); Z += tmp;                 // -17/32*Z0 +Z1
-  Z *= 8.0/9.0;                               // Z = -17/36*Z0 +8/9*Z1
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // U_= W2 = exp(ep*Z)*W1
-
-  Z *= -4.0/3.0;
-  SG.deriv(U, tmp); Z += tmp;                 // 4/3*(17/36*Z0 -8/9*Z1) +Z2
-  Z *= 3.0/4.0;                               // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // V(t+e) = exp(ep*Z)*W2
+  Gimpl::update_field(Z, Z, 0.25, 0.0, U, -2.0*epsilon);           // Z0 = 1/4 * F(U), U = W1 = exp(ep*Z0)*W0
+
+  SG.deriv(U, tmp);
+  Gimpl::update_field(Z, tmp, -17.0/9.0, 8.0/9.0, U, -2.0*epsilon); // Z = -17/36*Z0 +8/9*Z1, U_= W2 = exp(ep*Z)*W1
+
+  SG.deriv(U, tmp);
+  Gimpl::update_field(Z, tmp, -1.0, 3.0/4.0, U, -2.0*epsilon);     // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2, V(t+e) = exp(ep*Z)*W2
 }
 
 template <class Gimpl>
@@ -113,20 +109,14 @@ void WilsonFlow<Gimpl>::evolve_step_adaptive(typename Gimpl::GaugeField &U, Real
   Uprime = U;
   SG.deriv(U, Z);
   Zprime = -Z;
-  Z *= 0.25;                                  // Z0 = 1/4 * F(U)
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // U = W1 = exp(ep*Z0)*W0
+  Gimpl::update_field(Z, Z, 0.25, 0.0, U, -2.0*epsilon);           // Z0 = 1/4 * F(U), U = W1 = exp(ep*Z0)*W0
 
-  Z *= -17.0/8.0;
-  SG.deriv(U, tmp); Z += tmp;                 // -17/32*Z0 +Z1
+  SG.deriv(U, tmp);
   Zprime += 2.0*tmp;
-  Z *= 8.0/9.0;                               // Z = -17/36*Z0 +8/9*Z1
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // U_= W2 = exp(ep*Z)*W1
-    
+  Gimpl::update_field(Z, tmp, -17.0/9.0, 8.0/9.0, U, -2.0*epsilon); // Z = -17/36*Z0 +8/9*Z1, U_= W2 = exp(ep*Z)*W1
 
-  Z *= -4.0/3.0;
-  SG.deriv(U, tmp); Z += tmp;                 // 4/3*(17/36*Z0 -8/9*Z1) +Z2
-  Z *= 3.0/4.0;                               // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2
-  Gimpl::update_field(Z, U, -2.0*epsilon);    // V(t+e) = exp(ep*Z)*W2
+  SG.deriv(U, tmp);
+  Gimpl::update_field(Z, tmp, -1.0, 3.0/4.0, U, -2.0*epsilon);     // Z = 17/36*Z0 -8/9*Z1 +3/4*Z2, V(t+e) = exp(ep*Z)*W2
 
   // Ramos 
   Gimpl::update_field(Zprime, Uprime, -2.0*epsilon); // V'(t+e) = exp(ep*Z')*W0
@@ -0,0 +1,428 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/qcd/utils/WilsonLoopsHalo.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution
+    directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef QCD_UTILS_WILSON_LOOPS_HALO_H
+#define QCD_UTILS_WILSON_LOOPS_HALO_H
+
+NAMESPACE_BEGIN(Grid);
+
+////////////////////////////////////////////////////////////////////////////////
+// Gauge link paths evaluated from a single halo exchange.
+//
+// A path is a start offset and a list of steps; step mu+1 goes forward in mu
+// and multiplies by U_mu(y), step -(mu+1) goes backward and multiplies by
+// U_mu(y-mu)^dag. Each output is a signed sum of path products.
+//
+// All the link offsets the paths touch go into one GeneralHaloStencil, so the
+// gauge field is exchanged once, to the depth the paths need, and every
+// product is formed site locally from the haloed links. The kernel visits the
+// sites of the local grid only (in its tiled order, if any), reading the links
+// of the padded field in place and writing the outputs directly. Products
+// associate from the right, as the nested CovShiftForward/Backward forms do.
+//
+// Only for periodic gauge fields; charge conjugate boundaries need the
+// Cshift based forms in WilsonLoops.
+////////////////////////////////////////////////////////////////////////////////
+template <class Gimpl> class GaugeLinkPaths {
+public:
+  INHERIT_GIMPL_TYPES(Gimpl);
+
+  typedef typename Gimpl::GaugeLinkField GaugeMat;
+  typedef typename Gimpl::GaugeField GaugeLorentz;
+
+  struct LinkRead {
+    int mu;
+    int point;
+    int dag;
+  };
+
+  static int Forward (int mu) { return mu+1; }
+  static int Backward(int mu) { return -(mu+1); }
+
+  // Full periodic grids with a local volume at least as deep as the halo
+  static bool Supported(GridBase *grid,int depth)
+  {
+    if ( !Gimpl::isPeriodicGaugeField() ) return false;
+    if ( dynamic_cast<GridCartesian *>(grid)==nullptr ) return false;
+    for(int d=0;d<grid->Nd();d++){
+      if ( grid->_ldimensions[d] < depth ) return false;
+      if ( grid->_simd_layout[d] > 2 ) return false;
+    }
+    return true;
+  }
+
+  GaugeLinkPaths(GridBase *grid,int nout) : _grid(grid), _nout(nout), _paths(nout) {};
+
+  void AddPath(int out,int sign,const Coordinate &start,const std::vector<int> &steps)
+  {
+    assert(out<_nout);
+    assert(_stencil==nullptr);
+    _paths[out].push_back(Path{sign,start,steps});
+  }
+
+  ////////////////////////////////////////////////////////////////////////////
+  // out[o] = sum_p sign_p * product along path p
+  ////////////////////////////////////////////////////////////////////////////
+  void Evaluate(const GaugeLorentz &Umu,std::vector<GaugeMat> &out)
+  {
+    conformable(Umu.Grid(),_grid);
+    if ( !_stencil ) Build();
+    GridBase *pgrid = _stencil->PaddedGrid();
+
+    // The only communication
+    GaugeLorentz pad(pgrid);
+    _stencil->Exchange(Umu,pad);
+
+    out.resize(_nout,GaugeMat(_grid));
+    for(int o=0;o<_nout;o++) conformable(out[o].Grid(),_grid);
+
+    typedef decltype(out[0].View(AcceleratorWrite)) View;
+    typedef typename GaugeMat::vector_object vobj;
+    Vector<View> out_v;  out_v.reserve(_nout);
+    for(int o=0;o<_nout;o++)  out_v.push_back(out[o].View(AcceleratorWrite));
+    autoView(pad_v,pad,AcceleratorRead);
+
+    View *out_p     = &out_v[0];
+    LinkRead *reads = &_reads[0];
+    int *path_begin = &_path_begin[0];
+    int *path_sign  = &_path_sign[0];
+    int *out_begin  = &_out_begin[0];
+    int nout        = _nout;
+    auto st_v       = _stencil->View();
+    const uint64_t *interior = _stencil->Interior();
+
+    accelerator_for_tiled(ss,_grid,vobj::Nsimd(),{
+      uint64_t ps = interior[ss];
+      for(int o=0;o<nout;o++){
+	decltype(coalescedRead(out_p[0][ss])) sum, prod, link;
+	sum = Zero();
+	for(int p=out_begin[o];p<out_begin[o+1];p++){
+	  int l = path_begin[p+1]-1;
+	  readLink(prod,pad_v,st_v,reads[l],ps);
+	  for(l--;l>=path_begin[p];l--){
+	    readLink(link,pad_v,st_v,reads[l],ps);
+	    prod = link*prod;
+	  }
+	  if ( path_sign[p]>0 ) sum = sum + prod;
+	  else                  sum = sum - prod;
+	}
+	coalescedWrite(out_p[o][ss],sum);
+      }
+    });
+
+    for(int o=0;o<_nout;o++) out_v[o].ViewClose();
+  }
+
+  int Depth(void) const {
+    int depth=0;
+    if ( _stencil ) for(int d=0;d<Nd;d++) depth = std::max(depth,_stencil->Depth()[d]);
+    return depth;
+  }
+
+private:
+  struct Path {
+    int sign;
+    Coordinate start;
+    std::vector<int> steps;
+  };
+
+  // Link r.mu of the padded site r.point away from padded site ss
+  template<class calcMat,class PadView> static accelerator_inline
+  void readLink(calcMat &link,const PadView &pad_v,GeneralLocalStencilView &st_v,const LinkRead &r,uint64_t ss)
+  {
+    auto SE = st_v.GetEntry(r.point,ss);
+    link() = coalescedReadGeneralPermute(pad_v[SE->_offset](r.mu),SE->_permute);
+    if ( r.dag ) link = adj(link);
+  }
+
+  // Walk the paths, recording which link and which stencil point each step reads
+  void Build(void)
+  {
+    std::map<std::vector<int>,int> points;
+    std::vector<Coordinate> shifts;
+    auto point = [&](const Coordinate &x) {
+      std::vector<int> key(x.toVector());
+      auto it = points.find(key);
+      if ( it != points.end() ) return it->second;
+      int p = shifts.size();
+      points[key] = p;
+      shifts.push_back(x);
+      return p;
+    };
+
+    _out_begin.resize(0);
+    _out_begin.push_back(0);
+    for(int o=0;o<_nout;o++){
+      for(auto &path : _paths[o]){
+	Coordinate y = path.start;
+	_path_begin.push_back(_reads.size());
+	_path_sign.push_back(path.sign);
+	for(auto step : path.steps){
+	  int mu = std::abs(step)-1;
+	  assert(mu>=0 && mu<Nd);
+	  LinkRead r;
+	  r.mu = mu;
+	  if ( step > 0 ) {
+	    r.dag   = 0;
+	    r.point = point(y);
+	    y[mu]++;
+	  } else {
+	    y[mu]--;
+	    r.dag   = 1;
+	    r.point = point(y);
+	  }
+	  _reads.push_back(r);
+	}
+	assert(path.steps.size()>0);
+      }
+      _out_begin.push_back(_path_begin.size());
+    }
+    _path_begin.push_back(_reads.size());
+
+    _stencil.reset(new GeneralHaloStencil(_grid,shifts));
+  }
+
+  GridBase *_grid;
+  int _nout;
+  std::vector<std::vector<Path> > _paths;
+  std::unique_ptr<GeneralHaloStencil> _stencil;
+
+  Vector<LinkRead> _reads;
+  Vector<int>      _path_begin;
+  Vector<int>      _path_sign;
+  Vector<int>      _out_begin;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Staples, rectangles, plaquettes and clover leaves from haloed links.
+// Conventions and term order follow WilsonLoops, which keeps its Cshift forms;
+// callers opt in here, as the gauge actions do after UseHaloExchange().
+//
+// Evaluators are built on first use for each grid and kept in the grid's
+// cache, so they are freed with it. The first halo stencil of a given depth on
+// a grid splits its communicator, so all ranks must make the same calls.
+////////////////////////////////////////////////////////////////////////////////
+template <class Gimpl> class WilsonLoopsHalo {
+public:
+  INHERIT_GIMPL_TYPES(Gimpl);
+
+  typedef typename Gimpl::GaugeLinkField GaugeMat;
+  typedef typename Gimpl::GaugeField GaugeLorentz;
+  typedef GaugeLinkPaths<Gimpl> Paths;
+
+  // Path sets; the single direction and single plane sets take an argument
+  enum { StapleSet, StapleRectSet, PlaquetteSet, RectangleSet, CloverSet,
+	 StapleMuSet, RectStapleMuSet, CloverMuNuSet };
+
+  static bool Supported(GridBase *grid) { return Paths::Supported(grid,2); }
+
+  //////////////////////////////////////////////////
+  // staple[mu] for every mu, one exchange
+  //////////////////////////////////////////////////
+  static void Staples(std::vector<GaugeMat> &staple,const GaugeLorentz &Umu)
+  {
+    Get(Umu.Grid(),StapleSet).Evaluate(Umu,staple);
+  }
+  static void Staple(GaugeMat &staple,const GaugeLorentz &Umu,int mu)
+  {
+    std::vector<GaugeMat> one;
+    Get(Umu.Grid(),StapleMuSet,mu).Evaluate(Umu,one);
+    staple = one[0];
+  }
+  //////////////////////////////////////////////////
+  // staple[mu] and rect[mu] for every mu, one depth two exchange
+  //////////////////////////////////////////////////
+  static void StaplesAndRectStaples(std::vector<GaugeMat> &staple,std::vector<GaugeMat> &rect,const GaugeLorentz &Umu)
+  {
+    std::vector<GaugeMat> all;
+    Get(Umu.Grid(),StapleRectSet).Evaluate(Umu,all);
+    staple.assign(all.begin(),all.begin()+Nd);
+    rect  .assign(all.begin()+Nd,all.end());
+  }
+  static void RectStaple(GaugeMat &rect,const GaugeLorentz &Umu,int mu)
+  {
+    std::vector<GaugeMat> one;
+    Get(Umu.Grid(),RectStapleMuSet,mu).Evaluate(Umu,one);
+    rect = one[0];
+  }
+  //////////////////////////////////////////////////
+  // trace of the plaquettes (rectangles) summed over planes
+  //////////////////////////////////////////////////
+  static void sitePlaquette(ComplexField &Plaq,const GaugeLorentz &Umu)
+  {
+    std::vector<GaugeMat> sum;
+    Get(Umu.Grid(),PlaquetteSet).Evaluate(Umu,sum);
+    Plaq = trace(sum[0]);
+  }
+  static void siteRectangle(ComplexField &Rect,const GaugeLorentz &Umu)
+  {
+    std::vector<GaugeMat> sum;
+    Get(Umu.Grid(),RectangleSet).Evaluate(Umu,sum);
+    Rect = trace(sum[0]);
+  }
+  //////////////////////////////////////////////////
+  // Clover field strength in every plane, out[mu*Nd+nu]; mu==nu is zero.
+  // Leaves are formed for mu>nu only, F_nu,mu = -F_mu,nu.
+  //////////////////////////////////////////////////
+  static void FieldStrengths(std::vector<GaugeMat> &FS,const GaugeLorentz &Umu)
+  {
+    std::vector<GaugeMat> leaves;
+    Get(Umu.Grid(),CloverSet).Evaluate(Umu,leaves);
+    FS.resize(Nd*Nd,GaugeMat(Umu.Grid()));
+    for(int mu=0;mu<Nd;mu++){
+      FS[mu*Nd+mu] = Zero();
+      for(int nu=0;nu<mu;nu++){
+	GaugeMat &C = leaves[mu*(mu-1)/2+nu];
+	FS[mu*Nd+nu] = 0.125*(C - adj(C));
+	FS[nu*Nd+mu] = -FS[mu*Nd+nu];
+      }
+    }
+  }
+  static void FieldStrength(GaugeMat &FS,const GaugeLorentz &Umu,int mu,int nu)
+  {
+    std::vector<GaugeMat> one;
+    Get(Umu.Grid(),CloverMuNuSet,mu*Nd+nu).Evaluate(Umu,one);
+    FS = 0.125*(one[0] - adj(one[0]));
+  }
+
+  static Paths &Get(GridBase *grid,int set,int arg=0)
+  {
+    auto &paths = grid->Cache<Evaluators>().paths[std::make_pair(set,arg)];
+    if ( !paths ) {
+      assert(Supported(grid));
+      paths.reset(Make(grid,set,arg));
+    }
+    return *paths;
+  }
+
+private:
+  // The evaluators of one grid, kept in its cache and freed with it
+  struct Evaluators {
+    std::map<std::pair<int,int>,std::unique_ptr<Paths> > paths;
+  };
+
+  static int F(int mu) { return Paths::Forward(mu); }
+  static int B(int mu) { return Paths::Backward(mu); }
+  static Coordinate Unit(int mu) { Coordinate x(Nd,0); if ( mu>=0 ) x[mu]=1; return x; }
+
+  // Open paths from x+mu back to x; U_mu(x)*staple closes the loops
+  static void AddStaples(Paths &P,int out,int mu)
+  {
+    for(int nu=0;nu<Nd;nu++){
+      if ( nu==mu ) continue;
+      P.AddPath(out,1,Unit(mu),{F(nu),B(mu),B(nu)});
+      P.AddPath(out,1,Unit(mu),{B(nu),B(mu),F(nu)});
+    }
+  }
+  static void AddRectStaples(Paths &P,int out,int mu)
+  {
+    for(int nu=0;nu<Nd;nu++){
+      if ( nu==mu ) continue;
+      P.AddPath(out,1,Unit(mu),{F(mu),F(nu),B(mu),B(mu),B(nu)});
+      P.AddPath(out,1,Unit(mu),{F(mu),B(nu),B(mu),B(mu),F(nu)});
+      P.AddPath(out,1,Unit(mu),{B(nu),B(mu),B(mu),F(nu),F(mu)});
+      P.AddPath(out,1,Unit(mu),{F(nu),B(mu),B(mu),B(nu),F(mu)});
+      P.AddPath(out,1,Unit(mu),{F(nu),F(nu),B(mu),B(nu),B(nu)});
+      P.AddPath(out,1,Unit(mu),{B(nu),B(nu),B(mu),F(nu),F(nu)});
+    }
+  }
+
+  static void AddClover(Paths &P,int out,int mu,int nu)
+  {
+    // Fmn +--<--+  Ut +--<--+
+    //     |     |     |     |
+    //  (x)+-->--+     +-->--+(x)  - h.c.
+    //     |     |     |     |
+    //     +--<--+     +--<--+
+    Coordinate x(Nd,0);
+    if ( mu==nu ) return;
+    P.AddPath(out, 1,x,{F(mu),F(nu),B(mu),B(nu)});
+    P.AddPath(out,-1,x,{F(mu),B(nu),B(mu),F(nu)});
+    P.AddPath(out, 1,x,{F(nu),B(mu),B(nu),F(mu)});
+    P.AddPath(out,-1,x,{B(nu),B(mu),F(nu),F(mu)});
+  }
+
+  static Paths *Make(GridBase *grid,int set,int arg)
+  {
+    Paths *P;
+    Coordinate x(Nd,0);
+    switch(set){
+    case StapleSet:
+      P = new Paths(grid,Nd);
+      for(int mu=0;mu<Nd;mu++) AddStaples(*P,mu,mu);
+      break;
+    case StapleRectSet:
+      P = new Paths(grid,2*Nd);
+      for(int mu=0;mu<Nd;mu++) AddStaples(*P,mu,mu);
+      for(int mu=0;mu<Nd;mu++) AddRectStaples(*P,Nd+mu,mu);
+      break;
+    case PlaquetteSet:
+      P = new Paths(grid,1);
+      for(int mu=1;mu<Nd;mu++){
+	for(int nu=0;nu<mu;nu++){
+	  P->AddPath(0,1,x,{F(mu),F(nu),B(mu),B(nu)});
+	}
+      }
+      break;
+    case RectangleSet:
+      P = new Paths(grid,1);
+      for(int mu=1;mu<Nd;mu++){
+	for(int nu=0;nu<mu;nu++){
+	  P->AddPath(0,1,x,{F(mu),F(mu),F(nu),B(mu),B(mu),B(nu)});
+	  P->AddPath(0,1,x,{F(mu),F(nu),F(nu),B(mu),B(nu),B(nu)});
+	}
+      }
+      break;
+    case CloverSet:
+      P = new Paths(grid,Nd*(Nd-1)/2);
+      for(int mu=1;mu<Nd;mu++){
+	for(int nu=0;nu<mu;nu++){
+	  AddClover(*P,mu*(mu-1)/2+nu,mu,nu);
+	}
+      }
+      break;
+    case StapleMuSet:
+      P = new Paths(grid,1);
+      AddStaples(*P,0,arg);
+      break;
+    case RectStapleMuSet:
+      P = new Paths(grid,1);
+      AddRectStaples(*P,0,arg);
+      break;
+    case CloverMuNuSet:
+      P = new Paths(grid,1);
+      AddClover(*P,0,arg/Nd,arg%Nd);
+      break;
+    default:
+      assert(0);
+    }
+    return P;
+  }
+};
+
+NAMESPACE_END(Grid);
+
+#endif
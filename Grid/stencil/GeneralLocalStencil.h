@@ -137,5 +137,311 @@ public:
   
 };
 
+////////////////////////////////////////////////////////////////////////////////
+// General stencil with communication.
+//
+// Any set of displacement vectors, including diagonals and hops of more than
+// one site. The halo depth in each dimension is the largest |shift|. Fields are
+// copied into a per-rank padded grid and the halo is filled in a single
+// exchange. Faces, edges and corners are all posted at once, up to 3^Nd-1
+// messages, each going straight to the rank that needs it, so there is no
+// sequence of axis-by-axis exchanges.
+//
+// Each SIMD lane's share of the local volume is padded by depth on both sides:
+// the padded grid has the same simd layout and local extent
+// simd*(ldim/simd+2*depth), and local outer site x sits at padded outer site
+// x+depth in the same lane. Interior sites are copied in and out as whole
+// vector objects, and their stencil neighbours never need a permute. Only the
+// halo is written lane by lane, from other lanes of the field or from the
+// receive buffers, with gather and scatter tables built once per stencil.
+//
+// The GeneralLocalStencil entries are built on the padded grid. At interior
+// sites every neighbour is read directly, with no wrap-around:
+//
+//   GeneralHaloStencil st(grid,shifts);
+//   auto pad = st.Exchange(field);            // on st.PaddedGrid()
+//   autoView(p_v,pad,AcceleratorRead);
+//   auto st_v = st.View();
+//   accelerator_for(ss,pad.Grid()->oSites(),vobj::Nsimd(),{
+//     auto SE = st_v.GetEntry(point,ss);
+//     auto nbr = coalescedReadGeneralPermute(p_v[SE->_offset],SE->_permute);
+//     ...
+//   });
+//   st.Extract(result,padded_result);         // interior back to grid
+//
+// Results computed at halo sites are meaningless and are dropped by Extract.
+//
+// The padded grid is a single rank grid split from the parent's communicator.
+// It is built by the first stencil of a given depth on a grid, which is
+// collective over the grid's ranks, then shared by later stencils of that
+// depth and freed with the grid.
+////////////////////////////////////////////////////////////////////////////////
+struct GeneralHaloPaddedGrids {
+  std::map<std::vector<int>,std::unique_ptr<GridCartesian> > grids;
+};
+
+struct GeneralHaloCopy {
+  uint64_t to;
+  uint64_t from;
+  uint32_t to_lane;
+  uint32_t from_lane;
+};
+
+class GeneralHaloStencil : public GeneralLocalStencil {
+protected:
+  GridBase      *_local;
+  Coordinate     _depth;
+
+  struct Message {
+    int      to_rank;
+    int      from_rank;
+    uint64_t offset;
+    uint64_t words;
+  };
+  std::vector<Message> _messages;
+
+  // Resident in managed memory
+  Vector<uint64_t>        _interior;   // padded outer site of each local outer site
+  Vector<GeneralHaloCopy> _send;       // local site/lane -> send buffer
+  Vector<GeneralHaloCopy> _halo_local; // local site/lane -> padded halo site/lane
+  Vector<GeneralHaloCopy> _halo_recv;  // receive buffer  -> padded halo site/lane
+
+public:
+  GridBase *PaddedGrid(void) const { return _grid; }
+  GridBase *LocalGrid(void)  const { return _local; }
+  const Coordinate &Depth(void) const { return _depth; }
+  // Padded outer site of each outer site of the local grid
+  const uint64_t *Interior(void) const { return &_interior[0]; }
+
+  static Coordinate HaloDepth(GridBase *grid,const std::vector<Coordinate> &shifts)
+  {
+    int nd = grid->Nd();
+    Coordinate depth(nd,0);
+    for(auto &shift : shifts){
+      assert(shift.size()==nd);
+      for(int d=0;d<nd;d++) depth[d] = std::max(depth[d],std::abs(shift[d]));
+    }
+    for(int d=0;d<nd;d++) assert(depth[d]<=grid->_ldimensions[d]);
+    return depth;
+  }
+
+  // Collective on first use for a given grid and depth
+  static GridBase *PaddedGrid(GridBase *grid,const Coordinate &depth)
+  {
+    GridCartesian *parent = dynamic_cast<GridCartesian *>(grid);
+    assert(parent!=nullptr); // no checkerboarded grids
+
+    auto &padded = grid->Cache<GeneralHaloPaddedGrids>().grids[depth.toVector()];
+    if ( !padded ) {
+      int nd = grid->Nd();
+      Coordinate pdims(nd);
+      Coordinate procs(nd,1);
+      for(int d=0;d<nd;d++){
+	pdims[d] = grid->_simd_layout[d]*(grid->_rdimensions[d]+2*depth[d]);
+      }
+      padded.reset(new GridCartesian(pdims,grid->_simd_layout,procs,*parent));
+    }
+    return padded.get();
+  }
+
+  GeneralHaloStencil(GridBase *grid,const std::vector<Coordinate> &shifts)
+    : GeneralLocalStencil(PaddedGrid(grid,HaloDepth(grid,shifts)),shifts), _local(grid)
+  {
+    _depth = HaloDepth(grid,shifts);
+    BuildTables();
+  }
+
+  GeneralHaloStencil(const GeneralHaloStencil &) = delete;
+  GeneralHaloStencil &operator=(const GeneralHaloStencil &) = delete;
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Fill padded from in; the halo holds the neighbouring sites, periodic in
+  // the global lattice.
+  ////////////////////////////////////////////////////////////////////////////
+  template<class vobj>
+  void Exchange(const Lattice<vobj> &in,Lattice<vobj> &padded)
+  {
+    typedef typename vobj::scalar_object sobj;
+    conformable(in.Grid(),_local);
+    conformable(padded.Grid(),_grid);
+
+    uint64_t nbuf = _send.size();
+    commVector<sobj> send_buf(nbuf);
+    commVector<sobj> recv_buf(nbuf);
+    std::vector<CommsRequest_t> requests;
+
+    autoView(in_v ,in    ,AcceleratorRead);
+    autoView(pad_v,padded,AcceleratorWrite);
+
+    // Pack every face, edge and corner and post every message before waiting on any
+    if ( nbuf ) {
+      GeneralHaloCopy *table = &_send[0];
+      sobj *send_p = &send_buf[0];
+      accelerator_for(i,nbuf,1,{
+	send_p[i] = extractLane(table[i].from_lane,in_v[table[i].from]);
+      });
+    }
+    for(auto &m : _messages){
+      _local->SendToRecvFromBegin(requests,
+				  (void *)&send_buf[m.offset],m.to_rank,
+				  (void *)&recv_buf[m.offset],m.from_rank,
+				  m.words*sizeof(sobj));
+    }
+
+    // Interior and on-rank halo while the messages are in flight
+    {
+      uint64_t *interior = &_interior[0];
+      accelerator_for(ss,_local->oSites(),vobj::Nsimd(),{
+	coalescedWrite(pad_v[interior[ss]],coalescedRead(in_v[ss]));
+      });
+    }
+    uint64_t nlocal = _halo_local.size();
+    if ( nlocal ) {
+      GeneralHaloCopy *table = &_halo_local[0];
+      accelerator_for(i,nlocal,1,{
+	insertLane(table[i].to_lane,pad_v[table[i].to],extractLane(table[i].from_lane,in_v[table[i].from]));
+      });
+    }
+
+    _local->SendToRecvFromComplete(requests);
+
+    uint64_t nrecv = _halo_recv.size();
+    if ( nrecv ) {
+      GeneralHaloCopy *table = &_halo_recv[0];
+      sobj *recv_p = &recv_buf[0];
+      accelerator_for(i,nrecv,1,{
+	insertLane(table[i].to_lane,pad_v[table[i].to],recv_p[table[i].from]);
+      });
+    }
+  }
+  template<class vobj>
+  Lattice<vobj> Exchange(const Lattice<vobj> &in)
+  {
+    Lattice<vobj> padded(_grid);
+    Exchange(in,padded);
+    return padded;
+  }
+
+  // Interior of a padded field back on the original grid
+  template<class vobj>
+  void Extract(Lattice<vobj> &out,const Lattice<vobj> &padded)
+  {
+    conformable(out.Grid(),_local);
+    conformable(padded.Grid(),_grid);
+
+    autoView(out_v,out   ,AcceleratorWrite);
+    autoView(pad_v,padded,AcceleratorRead);
+    uint64_t *interior = &_interior[0];
+    accelerator_for(ss,_local->oSites(),vobj::Nsimd(),{
+      coalescedWrite(out_v[ss],coalescedRead(pad_v[interior[ss]]));
+    });
+  }
+
+private:
+  ////////////////////////////////////////////////////////////////////////////
+  // Box e in {-1,0,1}^Nd of the halo comes from rank pcoor+e, which sends the
+  // matching slab of its own volume. Boxes whose source rank is this one
+  // (e=0, or dimensions that are not distributed) are read from the field.
+  ////////////////////////////////////////////////////////////////////////////
+  void BuildTables(void)
+  {
+    int nd = _local->Nd();
+    Coordinate L     = _local->_ldimensions;
+    Coordinate R     = _local->_rdimensions;
+    Coordinate procs = _local->ProcessorGrid();
+    Coordinate pcoor = _local->ThisProcessorCoor();
+    int me = _local->ThisRank();
+
+    Coordinate c(nd);
+    _interior.resize(_local->oSites());
+    for(int o=0;o<_local->oSites();o++){
+      _local->oCoorFromOindex(c,o);
+      for(int d=0;d<nd;d++) c[d]+=_depth[d];
+      _interior[o] = _grid->oIndexReduced(c);
+    }
+
+    int nbox = 1;
+    for(int d=0;d<nd;d++) nbox*=3;
+
+    std::vector<Coordinate> src_lo(nbox), size(nbox);
+    std::vector<uint64_t> offset(nbox);
+    std::vector<int> remote(nbox,0);
+    uint64_t nbuf = 0;
+    for(int b=0;b<nbox;b++){
+      Coordinate e(nd), from(nd), to(nd);
+      src_lo[b].resize(nd); size[b].resize(nd);
+      int r = b;
+      uint64_t vol = 1;
+      for(int d=0;d<nd;d++){
+	e[d] = r%3-1; r/=3;
+	if ( e[d]==0 ) { src_lo[b][d]=0;              size[b][d]=L[d];      }
+	if ( e[d]<0  ) { src_lo[b][d]=L[d]-_depth[d]; size[b][d]=_depth[d]; }
+	if ( e[d]>0  ) { src_lo[b][d]=0;              size[b][d]=_depth[d]; }
+	vol *= size[b][d];
+	from[d] = (pcoor[d]+e[d]+procs[d])%procs[d];
+	to  [d] = (pcoor[d]-e[d]+procs[d])%procs[d];
+      }
+      int from_rank = _local->RankFromProcessorCoor(from);
+      int to_rank   = _local->RankFromProcessorCoor(to);
+      if ( vol==0 || from_rank==me ) {
+	assert(to_rank==me || vol==0);
+	continue;
+      }
+
+      remote[b] = 1;
+      offset[b] = nbuf;
+      _messages.push_back(Message{to_rank,from_rank,nbuf,vol});
+      for(uint64_t idx=0;idx<vol;idx++){
+	Coordinate bcoor(nd), lcoor(nd);
+	Lexicographic::CoorFromIndex(bcoor,idx,size[b]);
+	for(int d=0;d<nd;d++) lcoor[d] = src_lo[b][d]+bcoor[d];
+	GeneralHaloCopy copy;
+	copy.to        = nbuf+idx;
+	copy.to_lane   = 0;
+	copy.from      = _local->oIndex(lcoor);
+	copy.from_lane = _local->iIndex(lcoor);
+	_send.push_back(copy);
+      }
+      nbuf += vol;
+    }
+
+    // Every lane of every padded outer site outside the interior
+    Coordinate ic(nd), x(nd);
+    for(int po=0;po<_grid->oSites();po++){
+      _grid->oCoorFromOindex(c,po);
+      int interior = 1;
+      for(int d=0;d<nd;d++) interior = interior && (c[d]>=_depth[d]) && (c[d]<_depth[d]+R[d]);
+      if ( interior ) continue;
+
+      for(int lane=0;lane<_grid->Nsimd();lane++){
+	_grid->iCoorFromIindex(ic,lane);
+	int b = 0;
+	for(int d=nd-1;d>=0;d--){
+	  x[d] = ic[d]*R[d]+c[d]-_depth[d];
+	  int e = (x[d]<0) ? -1 : ( (x[d]>=L[d]) ? 1 : 0 );
+	  x[d] -= e*L[d];
+	  b = 3*b+e+1;
+	}
+	GeneralHaloCopy copy;
+	copy.to      = po;
+	copy.to_lane = lane;
+	if ( remote[b] ) {
+	  Coordinate bcoor(nd);
+	  int idx;
+	  for(int d=0;d<nd;d++) bcoor[d] = x[d]-src_lo[b][d];
+	  Lexicographic::IndexFromCoor(bcoor,idx,size[b]);
+	  copy.from      = offset[b]+idx;
+	  copy.from_lane = 0;
+	  _halo_recv.push_back(copy);
+	} else {
+	  copy.from      = _local->oIndex(x);
+	  copy.from_lane = _local->iIndex(x);
+	  _halo_local.push_back(copy);
+	}
+      }
+    }
+  }
+};
+
 NAMESPACE_END(Grid);
 
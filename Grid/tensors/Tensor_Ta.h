@@ -87,7 +87,15 @@ template<class vtype,int N> accelerator_inline iVector<vtype,N> ProjectOnGroup(c
   }
   return ret;
 }
-template<class vtype,int N, typename std::enable_if< GridTypeMapper<vtype>::TensorLevel == 0 >::type * =nullptr> 
+// SU(2)..SU(6) fundamental: Gram-Schmidt unrolled at compile time (Tensor_arith_unrolled.h)
+template<class vtype,int N, IfUnrolledColour<vtype,N> = 0>
+accelerator_inline iMatrix<vtype,N> ProjectOnGroup(const iMatrix<vtype,N> &arg)
+{
+  iMatrix<vtype,N> ret(arg);
+  unrolledGramSchmidt(ret,colour_sequence<N>());
+  return ret;
+}
+template<class vtype,int N, typename std::enable_if< (GridTypeMapper<vtype>::TensorLevel == 0) && ((N < 2) || (N > 6)) >::type * =nullptr> 
 accelerator_inline iMatrix<vtype,N> ProjectOnGroup(const iMatrix<vtype,N> &arg)
 {
   // need a check for the group type?
@@ -119,6 +127,51 @@ accelerator_inline iMatrix<vtype,N> ProjectOnGroup(const iMatrix<vtype,N> &arg)
   return ret;
 }
 
+/////////////////////////////////////////////// 
+// ProjectSU3: reunitarisation onto SU(3) after a link update.
+// Rows 0 and 1 are orthonormalised, row 2 is the complex conjugate
+// of their cross product: det=1 exactly and the third Gram-Schmidt
+// row is not needed
+/////////////////////////////////////////////// 
+template<class vtype> accelerator_inline iScalar<vtype> ProjectSU3(const iScalar<vtype>&r)
+{
+  iScalar<vtype> ret;
+  ret._internal = ProjectSU3(r._internal);
+  return ret;
+}
+template<class vtype,int N> accelerator_inline iVector<vtype,N> ProjectSU3(const iVector<vtype,N>&r)
+{
+  iVector<vtype,N> ret;
+  for(int i=0;i<N;i++){
+    ret._internal[i] = ProjectSU3(r._internal[i]);
+  }
+  return ret;
+}
+template<class vtype, typename std::enable_if< GridTypeMapper<vtype>::TensorLevel == 0 >::type * =nullptr> 
+accelerator_inline iMatrix<vtype,3> ProjectSU3(const iMatrix<vtype,3> &arg)
+{
+  iMatrix<vtype,3> ret(arg);
+  vtype inner, nrm, pr;
+
+  zeroit(inner);
+  for(int c=0;c<3;c++) inner += innerProduct(ret._internal[0][c],ret._internal[0][c]);
+  nrm = rsqrt(inner);
+  for(int c=0;c<3;c++) ret._internal[0][c] *= nrm;
+
+  zeroit(pr);
+  for(int c=0;c<3;c++) pr += conjugate(ret._internal[0][c])*ret._internal[1][c];
+  for(int c=0;c<3;c++) ret._internal[1][c] -= pr*ret._internal[0][c];
+  zeroit(inner);
+  for(int c=0;c<3;c++) inner += innerProduct(ret._internal[1][c],ret._internal[1][c]);
+  nrm = rsqrt(inner);
+  for(int c=0;c<3;c++) ret._internal[1][c] *= nrm;
+
+  ret._internal[2][0] = conjugate(ret._internal[0][1]*ret._internal[1][2] - ret._internal[0][2]*ret._internal[1][1]);
+  ret._internal[2][1] = conjugate(ret._internal[0][2]*ret._internal[1][0] - ret._internal[0][0]*ret._internal[1][2]);
+  ret._internal[2][2] = conjugate(ret._internal[0][0]*ret._internal[1][1] - ret._internal[0][1]*ret._internal[1][0]);
+  return ret;
+}
+
 NAMESPACE_END(Grid);
 
 #endif
@@ -33,6 +33,7 @@ Author: Peter Boyle <paboyle@ph.ed.ac.uk>
 #include "Tensor_arith_mac.h"
 #include "Tensor_arith_mul.h"
 #include "Tensor_arith_scalar.h"
+#include "Tensor_arith_unrolled.h"
 
 #endif
 
@@ -0,0 +1,181 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./lib/tensors/Tensor_arith_unrolled.h
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+*************************************************************************************/
+/*  END LEGAL */
+#ifndef GRID_MATH_ARITH_UNROLLED_H
+#define GRID_MATH_ARITH_UNROLLED_H
+
+NAMESPACE_BEGIN(Grid);
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+// Colour kernels unrolled at compile time for leaf N x N matrices with 2 <= N <= 6, i.e. the
+// fundamental of SU(2)..SU(6). Each index is a template parameter expanded from an
+// integer_sequence, so there is no loop left for the compiler to give up on at larger N.
+// The summation order of the loop forms is kept and results are bit identical. Larger
+// representations (two index, adjoint) stay on the generic loops.
+///////////////////////////////////////////////////////////////////////////////////////////////////
+template<class vtype,int N> using IfUnrolledColour =
+  Invoke<std::enable_if<(GridTypeMapper<vtype>::TensorLevel == 0) && (N >= 2) && (N <= 6), int> >;
+
+template<int N> using colour_sequence = std::make_integer_sequence<int,N>;
+
+////////////////////////////////////////////
+// Matrix x matrix
+////////////////////////////////////////////
+template<int c1,int c3,class vtype,int N,int... c2>
+accelerator_inline void unrolledMatMatTerm(iMatrix<vtype,N> &ret,const iMatrix<vtype,N> &lhs,const iMatrix<vtype,N> &rhs,
+					   std::integer_sequence<int,c2...>)
+{
+  int unroll[] = {0, ( (c3==0) ? mult(&ret._internal[c1][c2],&lhs._internal[c1][c3],&rhs._internal[c3][c2])
+		               : mac (&ret._internal[c1][c2],&lhs._internal[c1][c3],&rhs._internal[c3][c2]), 0)... };
+  (void)unroll;
+}
+template<int c1,class vtype,int N,int... c3>
+accelerator_inline void unrolledMatMatRow(iMatrix<vtype,N> &ret,const iMatrix<vtype,N> &lhs,const iMatrix<vtype,N> &rhs,
+					  std::integer_sequence<int,c3...>)
+{
+  int unroll[] = {0, (unrolledMatMatTerm<c1,c3>(ret,lhs,rhs,colour_sequence<N>()), 0)... };
+  (void)unroll;
+}
+template<class vtype,int N,int... c1>
+accelerator_inline void unrolledMatMat(iMatrix<vtype,N> &ret,const iMatrix<vtype,N> &lhs,const iMatrix<vtype,N> &rhs,
+				       std::integer_sequence<int,c1...>)
+{
+  int unroll[] = {0, (unrolledMatMatRow<c1>(ret,lhs,rhs,colour_sequence<N>()), 0)... };
+  (void)unroll;
+}
+
+template<class vtype,int N,IfUnrolledColour<vtype,N> = 0>
+accelerator_inline void mult(iMatrix<vtype,N> * __restrict__ ret,const iMatrix<vtype,N> * __restrict__ lhs,const iMatrix<vtype,N> * __restrict__ rhs)
+{
+  unrolledMatMat(*ret,*lhs,*rhs,colour_sequence<N>());
+}
+
+////////////////////////////////////////////
+// Matrix x vector
+////////////////////////////////////////////
+template<int c1,class vtype,int N,int... c2>
+accelerator_inline void unrolledMatVecRow(iVector<vtype,N> &ret,const iMatrix<vtype,N> &lhs,const iVector<vtype,N> &rhs,
+					  std::integer_sequence<int,c2...>)
+{
+  int unroll[] = {0, ( (c2==0) ? mult(&ret._internal[c1],&lhs._internal[c1][c2],&rhs._internal[c2])
+		               : mac (&ret._internal[c1],&lhs._internal[c1][c2],&rhs._internal[c2]), 0)... };
+  (void)unroll;
+}
+template<class vtype,int N,int... c1>
+accelerator_inline void unrolledMatVec(iVector<vtype,N> &ret,const iMatrix<vtype,N> &lhs,const iVector<vtype,N> &rhs,
+				       std::integer_sequence<int,c1...>)
+{
+  int unroll[] = {0, (unrolledMatVecRow<c1>(ret,lhs,rhs,colour_sequence<N>()), 0)... };
+  (void)unroll;
+}
+
+template<class vtype,int N,IfUnrolledColour<vtype,N> = 0>
+accelerator_inline void mult(iVector<vtype,N> * __restrict__ ret,const iMatrix<vtype,N> * __restrict__ lhs,const iVector<vtype,N> * __restrict__ rhs)
+{
+  unrolledMatVec(*ret,*lhs,*rhs,colour_sequence<N>());
+}
+
+////////////////////////////////////////////
+// Colour matrix on each spin component, as multLink in the generic Wilson kernels.
+// Every link element is loaded once and applied to all M spin components.
+////////////////////////////////////////////
+template<int c1,int c2,class vtype,int N,int M,int... s>
+accelerator_inline void unrolledMatSpinTerm(iVector<iVector<vtype,N>,M> &ret,const vtype u,const iVector<iVector<vtype,N>,M> &rhs,
+					    std::integer_sequence<int,s...>)
+{
+  int unroll[] = {0, ( (c2==0) ? mult(&ret._internal[s]._internal[c1],&u,&rhs._internal[s]._internal[c2])
+		               : mac (&ret._internal[s]._internal[c1],&u,&rhs._internal[s]._internal[c2]), 0)... };
+  (void)unroll;
+}
+template<int c1,class vtype,int N,int M,int... c2>
+accelerator_inline void unrolledMatSpinRow(iVector<iVector<vtype,N>,M> &ret,const iMatrix<vtype,N> &lhs,const iVector<iVector<vtype,N>,M> &rhs,
+					   std::integer_sequence<int,c2...>)
+{
+  int unroll[] = {0, (unrolledMatSpinTerm<c1,c2>(ret,lhs._internal[c1][c2],rhs,std::make_integer_sequence<int,M>()), 0)... };
+  (void)unroll;
+}
+template<class vtype,int N,int M,int... c1>
+accelerator_inline void unrolledMatSpin(iVector<iVector<vtype,N>,M> &ret,const iMatrix<vtype,N> &lhs,const iVector<iVector<vtype,N>,M> &rhs,
+					std::integer_sequence<int,c1...>)
+{
+  int unroll[] = {0, (unrolledMatSpinRow<c1>(ret,lhs,rhs,colour_sequence<N>()), 0)... };
+  (void)unroll;
+}
+
+template<class vtype,int N,int M,IfUnrolledColour<vtype,N> = 0>
+accelerator_inline void mult(iVector<iVector<vtype,N>,M> * __restrict__ ret,
+			     const iScalar<iMatrix<vtype,N> > * __restrict__ lhs,
+			     const iVector<iVector<vtype,N>,M> * __restrict__ rhs)
+{
+  unrolledMatSpin(*ret,lhs->_internal,*rhs,colour_sequence<N>());
+}
+
+////////////////////////////////////////////
+// Gram-Schmidt for ProjectOnGroup: normalise row c1, then remove it from the rows below
+////////////////////////////////////////////
+template<int c1,int b,class vtype,int N,int... c>
+accelerator_inline void unrolledGramSchmidtProject(iMatrix<vtype,N> &ret,std::integer_sequence<int,c...>)
+{
+  if ( b <= c1 ) return;
+  vtype pr;
+  zeroit(pr);
+  {
+    int unroll[] = {0, (pr += conjugate(ret._internal[c1][c])*ret._internal[b][c], 0)... };
+    (void)unroll;
+  }
+  {
+    int unroll[] = {0, (ret._internal[b][c] -= pr*ret._internal[c1][c], 0)... };
+    (void)unroll;
+  }
+}
+template<int c1,class vtype,int N,int... c>
+accelerator_inline void unrolledGramSchmidtRow(iMatrix<vtype,N> &ret,std::integer_sequence<int,c...>)
+{
+  vtype inner;
+  zeroit(inner);
+  {
+    int unroll[] = {0, (inner += innerProduct(ret._internal[c1][c],ret._internal[c1][c]), 0)... };
+    (void)unroll;
+  }
+  vtype nrm = rsqrt(inner);
+  {
+    int unroll[] = {0, (ret._internal[c1][c] *= nrm, 0)... };
+    (void)unroll;
+  }
+  {
+    int unroll[] = {0, (unrolledGramSchmidtProject<c1,c>(ret,colour_sequence<N>()), 0)... };
+    (void)unroll;
+  }
+}
+template<class vtype,int N,int... c1>
+accelerator_inline void unrolledGramSchmidt(iMatrix<vtype,N> &ret,std::integer_sequence<int,c1...>)
+{
+  int unroll[] = {0, (unrolledGramSchmidtRow<c1>(ret,colour_sequence<N>()), 0)... };
+  (void)unroll;
+}
+
+NAMESPACE_END(Grid);
+
+#endif
@@ -349,6 +349,10 @@ inline void acceleratorCopyFromDevice(void *from,void *to,size_t bytes){ hipMemc
   accelerator_for2dNB(iter1, num1, iter2, num2, nsimd, { __VA_ARGS__ } ); \
   accelerator_barrier(dummy);
 
+// Tiling is a host cache optimisation; accelerators keep consecutive sites on consecutive threads
+#define accelerator_for_tiled( iter, grid, nsimd, ... )			\
+  accelerator_for(iter, (grid)->oSites(), nsimd, { __VA_ARGS__ } );
+
 #endif
 
 //////////////////////////////////////////////
@@ -366,6 +370,17 @@ inline void acceleratorCopyFromDevice(void *from,void *to,size_t bytes){ hipMemc
 #define accelerator_barrier(dummy) 
 #define accelerator_for2d(iter1, num1, iter2, num2, nsimd, ... ) thread_for2d(iter1,num1,iter2,num2,{ __VA_ARGS__ });
 
+// Outer sites of grid in its tiled order, if it has one (GridBase::SetTiling)
+#define accelerator_for_tiled(iterator, grid, nsimd, ... )		\
+  {									\
+    const int32_t *_tiled_order = (grid)->TiledOrder();			\
+    uint64_t _tiled_sites = (grid)->oSites();				\
+    thread_for(_tiled_ss, _tiled_sites, {				\
+      uint64_t iterator = _tiled_order ? _tiled_order[_tiled_ss] : _tiled_ss; \
+      { __VA_ARGS__ };							\
+    });									\
+  }
+
 accelerator_inline int acceleratorSIMTlane(int Nsimd) { return 0; } // CUDA specific
 inline void acceleratorCopyToDevice(void *from,void *to,size_t bytes)  { memcpy(to,from,bytes);}
 inline void acceleratorCopyFromDevice(void *from,void *to,size_t bytes){ memcpy(to,from,bytes);}
@@ -385,6 +400,23 @@ inline void acceleratorFreeDevice(void *ptr){free(ptr);};
 
 #endif // CPU target
 
+//////////////////////////////////////////////
+// Host kernels built once per x86 ISA under --enable-simd-dispatch; the
+// loader binds the widest clone the CPU supports. Only GEN vectors are
+// eligible, since their layout does not depend on the instruction set.
+// The x86-64-v3/v4 levels need GCC 12, which configure checks. Virtual
+// functions cannot be cloned, so virtual entry points forward to marked
+// non-virtual kernels. The expression template assignments are not marked:
+// a clone set for every expression instantiation would triple the code of
+// the whole library, for streaming loops bound by memory bandwidth.
+//////////////////////////////////////////////
+#if defined(GRID_SIMD_DISPATCH) && defined(GEN) && defined(__x86_64__) && defined(__GNUC__) && (__GNUC__ >= 12) && (!defined(__clang__)) && (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP))
+#define GRID_SIMD_CLONES
+#define simd_dispatch __attribute__((target_clones("arch=x86-64-v4","arch=x86-64-v3","default")))
+#else
+#define simd_dispatch
+#endif
+
 #ifdef HAVE_MM_MALLOC_H
 inline void *acceleratorAllocCpu(size_t bytes){return _mm_malloc(bytes,GRID_ALLOC_ALIGN);};
 inline void acceleratorFreeCpu  (void *ptr){_mm_free(ptr);};
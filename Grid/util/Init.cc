@@ -272,6 +272,51 @@ void GridBanner(void)
     std::cout << std::endl;
 }
 
+/////////////////////////////////////////////////////////
+// Host instruction set. Intrinsic builds stop cleanly on a
+// CPU without their ISA rather than faulting in a kernel;
+// --enable-simd-dispatch builds report the clone in use.
+/////////////////////////////////////////////////////////
+static std::string GridHostSimd(void)
+{
+#if defined(__x86_64__) && defined(__GNUC__) && ( (!defined(GRID_SYCL)) && (!defined(GRID_CUDA)) && (!defined(GRID_HIP)) )
+  __builtin_cpu_init();
+  const char *need = nullptr;
+  int have = 1;
+#if defined(AVX512)
+  need = "avx512f";  have = __builtin_cpu_supports("avx512f");
+#elif defined(AVX2)
+  need = "avx2";     have = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#elif defined(AVXFMA)
+  need = "fma";      have = __builtin_cpu_supports("avx") && __builtin_cpu_supports("fma");
+#elif defined(AVXFMA4)
+  need = "fma4";     have = __builtin_cpu_supports("avx") && __builtin_cpu_supports("fma4");
+#elif defined(AVX1)
+  need = "avx";      have = __builtin_cpu_supports("avx");
+#elif defined(SSE4)
+  need = "sse4.2";   have = __builtin_cpu_supports("sse4.2");
+#endif
+  if ( !have ) {
+    std::cerr << "Grid was compiled for "<<need<<" which this CPU does not support;"
+	      << " rebuild with a matching --enable-simd, or GEN with --enable-simd-dispatch" << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  std::string isa = "x86-64";
+  if ( __builtin_cpu_supports("avx2") )    isa = "avx2";
+  if ( __builtin_cpu_supports("avx512f") ) isa = "avx512";
+#ifdef GRID_SIMD_CLONES
+  std::string clone = "default";
+  if ( __builtin_cpu_supports("x86-64-v3") ) clone = "x86-64-v3";
+  if ( __builtin_cpu_supports("x86-64-v4") ) clone = "x86-64-v4";
+  return isa + " ; dispatch " + clone;
+#else
+  return need ? isa + " ; compiled for " + need : isa;
+#endif
+#else
+  return "native";
+#endif
+}
+
 void Grid_init(int *argc,char ***argv)
 {
 
@@ -285,6 +330,7 @@ void Grid_init(int *argc,char ***argv)
   // Early intialisation necessities without rank knowledge
   //////////////////////////////////////////////////////////
   acceleratorInit(); // Must come first to set device prior to MPI init due to Omnipath Driver
+  std::string host_simd = GridHostSimd();
 
   if( GridCmdOptionExists(*argv,*argv+*argc,"--shm") ){
     int MB;
@@ -435,6 +481,15 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<std::endl;
     std::cout<<GridLogMessage<<"  --lebesgue      : Cache oblivious Lebesgue curve/Morton order/Z-graph stencil looping"<<std::endl;    
     std::cout<<GridLogMessage<<"  --cacheblocking n.m.o.p : Hypercuboidal cache blocking"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --tile n.m.o.p  : Z-order tiles of outer sites for the halo gauge path kernels"<<std::endl;    
+    std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"I/O:"<<std::endl;
+    std::cout<<GridLogMessage<<std::endl;
+    std::cout<<GridLogMessage<<"  --io-aggregators n : n ranks gather and issue all lattice file I/O (0 = MPI-IO)"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-stripe b      : align aggregator file ranges to b bytes"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --io-aggregator-buffer b : aggregators move at most b bytes per round (0 = whole range)"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --cshift-plans n : Cshift plans kept per grid and field type (default 64)"<<std::endl;    
+    std::cout<<GridLogMessage<<"  --rng-counter-based: counter based parallel RNG; decomposition independent, O(1) seed and checkpoint"<<std::endl;    
     std::cout<<GridLogMessage<<std::endl;
     exit(EXIT_SUCCESS);
   }
@@ -478,10 +533,43 @@ void Grid_init(int *argc,char ***argv)
     GridCmdOptionInt(arg,CartesianCommunicator::nCommThreads);
     assert(CartesianCommunicator::nCommThreads > 0);
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-aggregators") ){
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-aggregators");
+    GridCmdOptionInt(arg,BinaryIO::ioAggregators);
+    assert(BinaryIO::ioAggregators >= 0);
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-stripe") ){
+    int stripe;
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-stripe");
+    GridCmdOptionInt(arg,stripe);
+    assert(stripe >= 0);
+    BinaryIO::ioStripeBytes = stripe;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--io-aggregator-buffer") ){
+    int bytes;
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--io-aggregator-buffer");
+    GridCmdOptionInt(arg,bytes);
+    assert(bytes >= 0);
+    BinaryIO::ioAggregatorBufferBytes = bytes;
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--cshift-plans") ){
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--cshift-plans");
+    GridCmdOptionInt(arg,CshiftPlanCacheDepth);
+    assert(CshiftPlanCacheDepth >= 1);
+  }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--rng-counter-based") ){
+    GridParallelRNG::CounterBasedDefault() = true;
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--cacheblocking") ){
     arg= GridCmdOptionPayload(*argv,*argv+*argc,"--cacheblocking");
     GridCmdOptionIntVector(arg,LebesgueOrder::Block);
   }
+  if( GridCmdOptionExists(*argv,*argv+*argc,"--tile") ){
+    std::vector<int> tile;
+    arg= GridCmdOptionPayload(*argv,*argv+*argc,"--tile");
+    GridCmdOptionIntVector(arg,tile);
+    GridBase::DefaultTiling() = Coordinate(tile);
+  }
   if( GridCmdOptionExists(*argv,*argv+*argc,"--notimestamp") ){
     GridLogTimestamp(0);
   } else {
@@ -501,6 +589,7 @@ void Grid_init(int *argc,char ***argv)
     std::cout<<GridLogMessage<<"\tvRealD         : "<<sizeof(vRealD)*8    <<"bits ; " <<GridCmdVectorIntToString(GridDefaultSimd(4,vRealD::Nsimd()))<<std::endl;
     std::cout<<GridLogMessage<<"\tvComplexF      : "<<sizeof(vComplexF)*8 <<"bits ; " <<GridCmdVectorIntToString(GridDefaultSimd(4,vComplexF::Nsimd()))<<std::endl;
     std::cout<<GridLogMessage<<"\tvComplexD      : "<<sizeof(vComplexD)*8 <<"bits ; " <<GridCmdVectorIntToString(GridDefaultSimd(4,vComplexD::Nsimd()))<<std::endl;
+    std::cout<<GridLogMessage<<"\tHost SIMD      : "<<host_simd<<std::endl;
   }
   Grid_is_initialised = 1;
 }
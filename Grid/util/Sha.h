@@ -31,6 +31,11 @@ extern "C" {
 #ifdef USE_IPP
 #include "ipp.h"
 #endif
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 
 #pragma once
 
@@ -51,7 +56,67 @@ public:
   
       return ~crc32c;
   }
+#else
+  static inline uint32_t crc32c(const void* data, size_t bytes)
+  {
+    return crc32c_update(0,data,bytes);
+  }
+#endif
+
+  ////////////////////////////////////////////////////////////////////////////
+  // Castagnoli CRC (iSCSI polynomial), chained like zlib's crc32: start from 0
+  // and feed the previous result back in. Uses the SSE4.2 / ARMv8 CRC32C
+  // instructions when the target has them and slicing-by-8 tables otherwise;
+  // all three give identical results.
+  ////////////////////////////////////////////////////////////////////////////
+  static inline uint32_t crc32c_update(uint32_t crc, const void *data, size_t bytes)
+  {
+    const unsigned char *p = (const unsigned char *)data;
+    uint32_t c = ~crc;
+#if defined(__SSE4_2__)
+    uint64_t c64 = c;
+    for(;bytes>=8;bytes-=8,p+=8){
+      uint64_t w; std::memcpy(&w,p,8);
+      c64 = _mm_crc32_u64(c64,w);
+    }
+    c = (uint32_t)c64;
+    for(;bytes;bytes--,p++) c = _mm_crc32_u8(c,*p);
+#elif defined(__ARM_FEATURE_CRC32)
+    for(;bytes>=8;bytes-=8,p+=8){
+      uint64_t w; std::memcpy(&w,p,8);
+      c = __crc32cd(c,w);
+    }
+    for(;bytes;bytes--,p++) c = __crc32cb(c,*p);
+#else
+    const uint32_t (*t)[256] = crc32c_table();
+    for(;bytes>=8;bytes-=8,p+=8){
+      uint32_t lo = c ^ ( (uint32_t)p[0] | (uint32_t)p[1]<<8 | (uint32_t)p[2]<<16 | (uint32_t)p[3]<<24 );
+      c = t[7][lo&0xFF] ^ t[6][(lo>>8)&0xFF] ^ t[5][(lo>>16)&0xFF] ^ t[4][lo>>24]
+	^ t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+    }
+    for(;bytes;bytes--,p++) c = t[0][(c^*p)&0xFF] ^ (c>>8);
 #endif
+    return ~c;
+  }
+
+  // t[0] is the bytewise table, t[k][i] advances t[0][i] by k further zero bytes
+  static inline const uint32_t (*crc32c_table(void))[256]
+  {
+    static const struct Table {
+      uint32_t t[8][256];
+      Table() {
+	for(uint32_t i=0;i<256;i++){
+	  uint32_t c = i;
+	  for(int k=0;k<8;k++) c = (c&1) ? (c>>1)^0x82F63B78 : (c>>1);
+	  t[0][i] = c;
+	}
+	for(uint32_t i=0;i<256;i++){
+	  for(int k=1;k<8;k++) t[k][i] = t[0][t[k-1][i]&0xFF] ^ (t[k-1][i]>>8);
+	}
+      }
+    } table;
+    return table.t;
+  }
 
   template <typename T>
   static inline std::string sha256_string(const std::vector<T> &hash)
@@ -56,7 +56,7 @@ void stats(Mat &mean, Mat &stdDev, const std::vector<Mat> &data)
   MSG << _buf;\
 }
 
-enum {sRead = 0, sWrite = 1, gRead = 2, gWrite = 3};
+enum {sRead = 0, sWrite = 1, gRead = 2, gWrite = 3, aRead = 4, aWrite = 5};
 
 int main (int argc, char ** argv)
 {
@@ -66,12 +66,22 @@ int main (int argc, char ** argv)
   auto                         mpi     = GridDefaultMpi();
   unsigned int                 nVol    = (BENCH_IO_LMAX - BENCH_IO_LMIN)/2 + 1;
   unsigned int                 nRelVol = (BENCH_IO_LMAX - 24)/2 + 1;
-  std::vector<Eigen::MatrixXd> perf(BENCH_IO_NPASS, Eigen::MatrixXd::Zero(nVol, 4));
-  std::vector<Eigen::VectorXd> avPerf(BENCH_IO_NPASS, Eigen::VectorXd::Zero(4));
+  std::vector<Eigen::MatrixXd> perf(BENCH_IO_NPASS, Eigen::MatrixXd::Zero(nVol, 6));
+  std::vector<Eigen::VectorXd> avPerf(BENCH_IO_NPASS, Eigen::VectorXd::Zero(6));
   std::vector<int>             latt;
+  int                          nAggr   = BinaryIO::ioAggregators;
+
+  // Aggregated columns default to one I/O rank per node; the other Grid
+  // columns always use the default (MPI-IO) path
+  if (nAggr == 0)
+  {
+    nAggr = GlobalSharedMemory::WorldNodes;
+  }
+  BinaryIO::ioAggregators = 0;
 
   MSG << "Grid is setup to use " << threads << " threads" << std::endl;
   MSG << "MPI partition " << mpi << std::endl;
+  MSG << "I/O aggregators " << nAggr << ", stripe " << BinaryIO::ioStripeBytes << " bytes" << std::endl;
   for (unsigned int i = 0; i < BENCH_IO_NPASS; ++i)
   {
     MSG << BIGSEP << std::endl;
@@ -125,9 +135,35 @@ int main (int argc, char ** argv)
       readBenchmark<LatticeFermion>(latt, filestem(l), limeRead<LatticeFermion>);
       perf[i](volInd(l), gRead) = BinaryIO::lastPerf.mbytesPerSecond;
     }
+
+    BinaryIO::ioAggregators = nAggr;
+    MSG << SEP << std::endl;
+    MSG << "Benchmark Grid C-Lime write, " << nAggr << " aggregator(s)" << std::endl;
+    MSG << SEP << std::endl;
+    for (int l = BENCH_IO_LMIN; l <= BENCH_IO_LMAX; l += 2)
+    {
+      latt = {l*mpi[0], l*mpi[1], l*mpi[2], l*mpi[3]};
+
+      MSG << "-- Local volume " << l << "^4" << std::endl;
+      writeBenchmark<LatticeFermion>(latt, filestem(l), limeWrite<LatticeFermion>);
+      perf[i](volInd(l), aWrite) = BinaryIO::lastPerf.mbytesPerSecond;
+    }
+
+    MSG << SEP << std::endl;
+    MSG << "Benchmark Grid C-Lime read, " << nAggr << " aggregator(s)" << std::endl;
+    MSG << SEP << std::endl;
+    for (int l = BENCH_IO_LMIN; l <= BENCH_IO_LMAX; l += 2)
+    {
+      latt = {l*mpi[0], l*mpi[1], l*mpi[2], l*mpi[3]};
+
+      MSG << "-- Local volume " << l << "^4" << std::endl;
+      readBenchmark<LatticeFermion>(latt, filestem(l), limeRead<LatticeFermion>);
+      perf[i](volInd(l), aRead) = BinaryIO::lastPerf.mbytesPerSecond;
+    }
+    BinaryIO::ioAggregators = 0;
 #endif
     avPerf[i].fill(0.);
-    for (int f = 0; f < 4; ++f)
+    for (int f = 0; f < 6; ++f)
     for (int l = 24; l <= BENCH_IO_LMAX; l += 2)
     {
       avPerf[i](f) += perf[i](volInd(l), f);
@@ -135,8 +171,8 @@ int main (int argc, char ** argv)
     avPerf[i] /= nRelVol;
   }
 
-  Eigen::MatrixXd mean(nVol, 4), stdDev(nVol, 4), rob(nVol, 4);
-  Eigen::VectorXd avMean(4), avStdDev(4), avRob(4);
+  Eigen::MatrixXd mean(nVol, 6), stdDev(nVol, 6), rob(nVol, 6);
+  Eigen::VectorXd avMean(6), avStdDev(6), avRob(6);
   double          n = BENCH_IO_NPASS;
 
   stats(mean, stdDev, perf);
@@ -152,45 +188,54 @@ int main (int argc, char ** argv)
   MSG << "Summary of individual results (all results in MB/s)." << std::endl;
   MSG << "Every second colum gives the standard deviation of the previous column." << std::endl;
   MSG << std::endl;
-  grid_printf("%4s %12s %12s %12s %12s %12s %12s %12s %12s\n",
+  grid_printf("%4s %12s %12s %12s %12s %12s %12s %12s %12s %12s %12s %12s %12s\n",
               "L", "std read", "std dev", "std write", "std dev",
-              "Grid read", "std dev", "Grid write", "std dev");
+              "Grid read", "std dev", "Grid write", "std dev",
+              "aggr read", "std dev", "aggr write", "std dev");
   for (int l = BENCH_IO_LMIN; l <= BENCH_IO_LMAX; l += 2)
   {
-    grid_printf("%4d %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+    grid_printf("%4d %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n",
                 l, mean(volInd(l), sRead), stdDev(volInd(l), sRead),
                 mean(volInd(l), sWrite), stdDev(volInd(l), sWrite),
                 mean(volInd(l), gRead), stdDev(volInd(l), gRead),
-                mean(volInd(l), gWrite), stdDev(volInd(l), gWrite));
+                mean(volInd(l), gWrite), stdDev(volInd(l), gWrite),
+                mean(volInd(l), aRead), stdDev(volInd(l), aRead),
+                mean(volInd(l), aWrite), stdDev(volInd(l), aWrite));
   }
   MSG << std::endl;
   MSG << "Robustness of individual results, in \%. (rob = 100\% - std dev / mean)" << std::endl;
   MSG << std::endl;
-  grid_printf("%4s %12s %12s %12s %12s\n",
-              "L", "std read", "std write", "Grid read", "Grid write");
+  grid_printf("%4s %12s %12s %12s %12s %12s %12s\n",
+              "L", "std read", "std write", "Grid read", "Grid write",
+              "aggr read", "aggr write");
   for (int l = BENCH_IO_LMIN; l <= BENCH_IO_LMAX; l += 2)
   {
-    grid_printf("%4d %12.1f %12.1f %12.1f %12.1f\n",
+    grid_printf("%4d %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n",
                 l, rob(volInd(l), sRead), rob(volInd(l), sWrite),
-                rob(volInd(l), gRead), rob(volInd(l), gWrite));
+                rob(volInd(l), gRead), rob(volInd(l), gWrite),
+                rob(volInd(l), aRead), rob(volInd(l), aWrite));
   }
   MSG << std::endl;
   MSG << "Summary of results averaged over local volumes 24^4-" << BENCH_IO_LMAX << "^4 (all results in MB/s)." << std::endl;
   MSG << "Every second colum gives the standard deviation of the previous column." << std::endl;
   MSG << std::endl;
-  grid_printf("%12s %12s %12s %12s %12s %12s %12s %12s\n",
+  grid_printf("%12s %12s %12s %12s %12s %12s %12s %12s %12s %12s %12s %12s\n",
               "std read", "std dev", "std write", "std dev",
-              "Grid read", "std dev", "Grid write", "std dev");
-  grid_printf("%12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+              "Grid read", "std dev", "Grid write", "std dev",
+              "aggr read", "std dev", "aggr write", "std dev");
+  grid_printf("%12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n",
               avMean(sRead), avStdDev(sRead), avMean(sWrite), avStdDev(sWrite),
-              avMean(gRead), avStdDev(gRead), avMean(gWrite), avStdDev(gWrite));
+              avMean(gRead), avStdDev(gRead), avMean(gWrite), avStdDev(gWrite),
+              avMean(aRead), avStdDev(aRead), avMean(aWrite), avStdDev(aWrite));
   MSG << std::endl;
   MSG << "Robustness of volume-averaged results, in \%. (rob = 100\% - std dev / mean)" << std::endl;
   MSG << std::endl;
-  grid_printf("%12s %12s %12s %12s\n",
-              "std read", "std write", "Grid read", "Grid write");
-  grid_printf("%12.1f %12.1f %12.1f %12.1f\n",
-              avRob(sRead), avRob(sWrite), avRob(gRead), avRob(gWrite));
+  grid_printf("%12s %12s %12s %12s %12s %12s\n",
+              "std read", "std write", "Grid read", "Grid write",
+              "aggr read", "aggr write");
+  grid_printf("%12.1f %12.1f %12.1f %12.1f %12.1f %12.1f\n",
+              avRob(sRead), avRob(sWrite), avRob(gRead), avRob(gWrite),
+              avRob(aRead), avRob(aWrite));
 
   Grid_finalize();
 
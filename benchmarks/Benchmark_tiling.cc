@@ -0,0 +1,107 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_tiling.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Halo gauge path kernels with and without Z-order tiling of the sites
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#define LMAX (24)
+#define LMIN (8)
+#define LADD (4)
+
+  int64_t Nwarm=2;
+  int64_t Nloop=10;
+
+  typedef PeriodicGimplR Gimpl;
+  typedef WilsonLoopsHalo<Gimpl> WLH;
+  typedef typename Gimpl::GaugeLinkField GaugeMat;
+
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  // Tile edges in outer sites; none first
+  std::vector<Coordinate> tiles({ Coordinate(), Coordinate({2,2,2,2}), Coordinate({4,4,4,4}), Coordinate({4,4,2,2}) });
+
+  int64_t threads = GridThread::GetThreads();
+  std::cout<<GridLogMessage << "Grid is setup to use "<<threads<<" threads"<<std::endl;
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking halo gauge path kernels by site tiling (usec per call)"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "  L  "<<"\t\t"<<"tile"<<"\t\t"<<"Wilson"<<"\t\t"<<"Plaq+Rect"<<"\t"<<"Clover F"<<std::endl;
+  std::cout<<GridLogMessage << "----------------------------------------------------------"<<std::endl;
+
+  for(int lat=LMIN;lat<=LMAX;lat+=LADD){
+
+    Coordinate latt_size  ({lat*mpi_layout[0],lat*mpi_layout[1],lat*mpi_layout[2],lat*mpi_layout[3]});
+    GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+    GridParallelRNG          pRNG(&Grid);      pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+    if ( !WLH::Supported(&Grid) ) {
+      std::cout<<GridLogMessage << lat << "\t\thalo exchange not supported on this grid"<<std::endl;
+      continue;
+    }
+
+    LatticeGaugeField Umu(&Grid);  SU<Nc>::HotConfiguration(pRNG,Umu);
+    LatticeGaugeField dSdU(&Grid);
+    std::vector<GaugeMat> FS;
+
+    auto time = [&](std::function<void(void)> f) {
+      for(int64_t i=0;i<Nwarm;i++) f();
+      double start=usecond();
+      for(int64_t i=0;i<Nloop;i++) f();
+      double stop=usecond();
+      return (stop-start)/Nloop;
+    };
+
+    WilsonGaugeAction<Gimpl>       Waction(6.0);
+    PlaqPlusRectangleAction<Gimpl> Raction(3.0,-0.3);
+    Waction.UseHaloExchange();
+    Raction.UseHaloExchange();
+
+    for(auto &tile : tiles){
+      if ( tile.size() ) Grid.SetTiling(tile);
+      else               Grid.ClearTiling();
+      double tw = time([&](){ Waction.deriv(Umu,dSdU); });
+      double tr = time([&](){ Raction.deriv(Umu,dSdU); });
+      double tf = time([&](){ WLH::FieldStrengths(FS,Umu); });
+
+      std::stringstream name;
+      if ( tile.size() ) name << tile;
+      else               name << "none";
+      std::cout<<GridLogMessage<<std::setprecision(3) << lat<<"\t\t"<<name.str()<<"\t"
+	       <<tw<<"\t"<<tr<<"\t"<<tf<<std::endl;
+    }
+    Grid.ClearTiling();
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,98 @@
+/*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./benchmarks/Benchmark_wilson_loops_halo.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Gauge forces and plaquettes, Cshift forms against a single halo exchange
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#define LMAX (24)
+#define LMIN (8)
+#define LADD (4)
+
+  int64_t Nwarm=2;
+  int64_t Nloop=10;
+
+  typedef PeriodicGimplR Gimpl;
+  typedef WilsonLoops<Gimpl>     WL;
+  typedef WilsonLoopsHalo<Gimpl> WLH;
+
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplex::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  int64_t threads = GridThread::GetThreads();
+  std::cout<<GridLogMessage << "Grid is setup to use "<<threads<<" threads"<<std::endl;
+
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "= Benchmarking gauge forces and plaquette: Cshift vs halo exchange (usec per call)"<<std::endl;
+  std::cout<<GridLogMessage << "===================================================================================================="<<std::endl;
+  std::cout<<GridLogMessage << "  L  "<<"\t\t"<<"Wilson"<<"\t\t\t"<<"Plaq+Rect"<<"\t\t"<<"Plaquette"<<std::endl;
+  std::cout<<GridLogMessage << "     "<<"\t\t"<<"Cshift\thalo"<<"\t\t"<<"Cshift\thalo"<<"\t\t"<<"Cshift\thalo"<<std::endl;
+  std::cout<<GridLogMessage << "----------------------------------------------------------"<<std::endl;
+
+  for(int lat=LMIN;lat<=LMAX;lat+=LADD){
+
+    Coordinate latt_size  ({lat*mpi_layout[0],lat*mpi_layout[1],lat*mpi_layout[2],lat*mpi_layout[3]});
+    GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+    GridParallelRNG          pRNG(&Grid);      pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+    LatticeGaugeField Umu(&Grid);  SU<Nc>::HotConfiguration(pRNG,Umu);
+    LatticeGaugeField dSdU(&Grid);
+    if ( !WLH::Supported(&Grid) ) {
+      std::cout<<GridLogMessage << lat << "\t\thalo exchange not supported on this grid"<<std::endl;
+      continue;
+    }
+
+    auto time = [&](std::function<void(void)> f) {
+      for(int64_t i=0;i<Nwarm;i++) f();
+      double start=usecond();
+      for(int64_t i=0;i<Nloop;i++) f();
+      double stop=usecond();
+      return (stop-start)/Nloop;
+    };
+
+    WilsonGaugeAction<Gimpl>       Waction(6.0);
+    PlaqPlusRectangleAction<Gimpl> Raction(3.0,-0.3);
+    RealD plaq;
+    double tw   = time([&](){ Waction.deriv(Umu,dSdU); });
+    double tr   = time([&](){ Raction.deriv(Umu,dSdU); });
+    double tp   = time([&](){ plaq = WL::sumPlaquette(Umu); });
+    Waction.UseHaloExchange();
+    Raction.UseHaloExchange();
+    double twh  = time([&](){ Waction.deriv(Umu,dSdU); });
+    double trh  = time([&](){ Raction.deriv(Umu,dSdU); });
+    double tph  = time([&](){ LatticeComplex site(&Grid); WLH::sitePlaquette(site,Umu); plaq = TensorRemove(sum(site)).real(); });
+
+    std::cout<<GridLogMessage<<std::setprecision(3) << lat<<"\t\t"
+	     <<tw<<"\t"<<twh<<"\t\t"<<tr<<"\t"<<trh<<"\t\t"<<tp<<"\t"<<tph<<std::endl;
+  }
+
+  Grid_finalize();
+}
@@ -0,0 +1,126 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_async_checkpointer.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+bool SameFile(const std::string &a,const std::string &b)
+{
+  std::ifstream fa(a,std::ios::binary), fb(b,std::ios::binary);
+  std::vector<char> da((std::istreambuf_iterator<char>(fa)),std::istreambuf_iterator<char>());
+  std::vector<char> db((std::istreambuf_iterator<char>(fb)),std::istreambuf_iterator<char>());
+  return (da.size()>0) && (da==db);
+}
+
+// The synchronous writer appends the serial RNG state from every rank, the
+// asynchronous one from the boss only; the copies are identical
+bool SameRNGFile(const std::string &a,const std::string &b)
+{
+  std::ifstream fa(a,std::ios::binary), fb(b,std::ios::binary);
+  std::vector<char> da((std::istreambuf_iterator<char>(fa)),std::istreambuf_iterator<char>());
+  std::vector<char> db((std::istreambuf_iterator<char>(fb)),std::istreambuf_iterator<char>());
+  return (da.size()>0) && (db.size()>=da.size()) && std::equal(da.begin(),da.end(),db.begin());
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+
+  GridSerialRNG   sRNG;  sRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeGaugeFieldD U(UGrid), Uread(UGrid), diff(UGrid);
+
+  CheckpointerParameters SyncParams ("ckpoint_sync_lat", "ckpoint_sync_rng", 1, "IEEE64BIG");
+  CheckpointerParameters AsyncParams("ckpoint_async_lat","ckpoint_async_rng",1, "IEEE64BIG");
+  BinaryHmcCheckpointer<PeriodicGimplD>      Sync (SyncParams);
+  AsyncBinaryHmcCheckpointer<PeriodicGimplD> Async(AsyncParams,2);
+
+  ////////////////////////////////////////////////////////////
+  // Several saves in flight; the staged copies must be taken
+  // before U and the RNGs move on
+  ////////////////////////////////////////////////////////////
+  const int Ntraj=4;
+  for(int traj=1;traj<=Ntraj;traj++){
+    SU<Nc>::HotConfiguration(pRNG,U);
+    Async.TrajectoryComplete(traj,U,sRNG,pRNG);
+    Sync.TrajectoryComplete(traj,U,sRNG,pRNG);
+  }
+  Async.Flush();
+
+  for(int traj=1;traj<=Ntraj;traj++){
+    std::string sconf, srng, aconf, arng;
+    Sync.build_filenames(traj,SyncParams,sconf,srng);
+    Async.build_filenames(traj,AsyncParams,aconf,arng);
+    std::cout << GridLogMessage << "Comparing "<<aconf<<" "<<sconf<<std::endl;
+    if ( UGrid->IsBoss() ) {
+      assert(SameFile(aconf,sconf));
+      assert(SameRNGFile(arng,srng));
+    }
+  }
+
+  // Read back the last one with the synchronous reader
+  GridSerialRNG   sRNGread;
+  GridParallelRNG pRNGread(UGrid);
+  Sync.CheckpointRestore(Ntraj,Uread,sRNGread,pRNGread);
+  diff = U - Uread;
+  assert(norm2(diff)==0.0);
+
+  RealD a, b;
+  random(sRNG,a);  random(sRNGread,b);  assert(a==b);
+  LatticeComplexD ra(UGrid), rb(UGrid);
+  random(pRNG,ra); random(pRNGread,rb);
+  ra = ra - rb;
+  assert(norm2(ra)==0.0);
+
+  ////////////////////////////////////////////////////////////
+  // Retiring is collective, so the owner flushes explicitly
+  // before the checkpointer goes out of scope
+  ////////////////////////////////////////////////////////////
+  {
+    AsyncBinaryHmcCheckpointer<PeriodicGimplD> Scoped(AsyncParams,2);
+    Scoped.TrajectoryComplete(Ntraj+1,U,sRNG,pRNG);
+    Scoped.Flush();
+  }
+  Sync.TrajectoryComplete(Ntraj+1,U,sRNG,pRNG);
+  {
+    std::string sconf, srng, aconf, arng;
+    Sync.build_filenames(Ntraj+1,SyncParams,sconf,srng);
+    Async.build_filenames(Ntraj+1,AsyncParams,aconf,arng);
+    std::cout << GridLogMessage << "Comparing "<<aconf<<" "<<sconf<<std::endl;
+    if ( UGrid->IsBoss() ) {
+      assert(SameFile(aconf,sconf));
+      assert(SameRNGFile(arng,srng));
+    }
+  }
+
+  Grid_finalize();
+}
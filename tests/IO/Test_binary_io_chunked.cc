@@ -0,0 +1,162 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_binary_io_chunked.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+bool SameFile(const std::string &a,const std::string &b)
+{
+  std::ifstream fa(a,std::ios::binary), fb(b,std::ios::binary);
+  std::vector<char> da((std::istreambuf_iterator<char>(fa)),std::istreambuf_iterator<char>());
+  std::vector<char> db((std::istreambuf_iterator<char>(fb)),std::istreambuf_iterator<char>());
+  return (da.size()>0) && (da==db);
+}
+
+template<class Field,class fobj>
+void ChunkedRoundTrip(Field &src,const std::string &stem,const std::string &format)
+{
+  typedef typename Field::vector_object vobj;
+  typedef typename Field::scalar_object sobj;
+
+  GridBase *grid = src.Grid();
+  Field     dst(grid);
+  Field     diff(grid);
+  uint64_t  slab = grid->lSites()/grid->LocalDimensions()[grid->Nd()-1];
+
+  ////////////////////////////////////////////////////////////
+  // Single chunk, one slab, a ragged size and more than the
+  // field; files and checksums must not depend on the chunking
+  ////////////////////////////////////////////////////////////
+  std::vector<uint64_t> chunks({0, slab*sizeof(fobj), 3*slab*sizeof(fobj)+5, 1ULL<<40});
+  uint32_t nersc_ref, scidaca_ref, scidacb_ref;
+  std::string ref = stem + ".0";
+
+  for(int c=0;c<chunks.size();c++){
+    std::string file = stem + "." + std::to_string(c);
+    uint32_t nersc, scidaca, scidacb;
+
+    BinaryIO::latticeChunkBytes = chunks[c];
+    std::cout << GridLogMessage << "Chunk bytes "<<chunks[c]<<" "<<format<<" "<<file<<std::endl;
+    BinaryIO::writeLatticeObject<vobj,fobj>(src,file,BinarySimpleMunger<sobj,fobj>(),0,format,
+					    nersc,scidaca,scidacb);
+    if ( c==0 ) {
+      nersc_ref = nersc; scidaca_ref = scidaca; scidacb_ref = scidacb;
+    }
+    assert(nersc==nersc_ref);
+    assert(scidaca==scidaca_ref);
+    assert(scidacb==scidacb_ref);
+    grid->Barrier();
+    if ( grid->IsBoss() ) assert(SameFile(file,ref));
+
+    dst = Zero();
+    dst.Checkerboard() = src.Checkerboard();
+    BinaryIO::readLatticeObject<vobj,fobj>(dst,ref,BinarySimpleMunger<fobj,sobj>(),0,format,
+					   nersc,scidaca,scidacb);
+    assert(nersc==nersc_ref);
+    assert(scidaca==scidaca_ref);
+    assert(scidacb==scidacb_ref);
+    diff = dst - src;
+    RealD err = norm2(diff)/norm2(src);
+    std::cout << GridLogMessage << "Read back rel. err "<<err<<std::endl;
+    assert(err < 1.0e-12);
+  }
+  BinaryIO::latticeChunkBytes = 0;
+
+  ////////////////////////////////////////////////////////////
+  // Aggregated writer/readers (only differ on several ranks),
+  // with a stripe that does not divide the object size, the
+  // second moving its ranges in rounds of a few stripes
+  ////////////////////////////////////////////////////////////
+  std::vector<int> aggregators({1,3});
+  uint64_t stripe = BinaryIO::ioStripeBytes;
+  uint64_t buffer = BinaryIO::ioAggregatorBufferBytes;
+  BinaryIO::ioStripeBytes = 4096;
+  for(int a=0;a<aggregators.size();a++){
+    std::string file = stem + ".aggr" + std::to_string(aggregators[a]);
+    uint32_t nersc, scidaca, scidacb;
+
+    BinaryIO::ioAggregators     = aggregators[a];
+    BinaryIO::latticeChunkBytes = (a==0) ? 0 : slab*sizeof(fobj);
+    BinaryIO::ioAggregatorBufferBytes = (a==0) ? buffer : 3*4096+100;
+    BinaryIO::writeLatticeObject<vobj,fobj>(src,file,BinarySimpleMunger<sobj,fobj>(),0,format,
+					    nersc,scidaca,scidacb);
+    assert(nersc==nersc_ref);
+    assert(scidaca==scidaca_ref);
+    assert(scidacb==scidacb_ref);
+    grid->Barrier();
+    if ( grid->IsBoss() ) assert(SameFile(file,ref));
+
+    dst = Zero();
+    dst.Checkerboard() = src.Checkerboard();
+    BinaryIO::readLatticeObject<vobj,fobj>(dst,ref,BinarySimpleMunger<fobj,sobj>(),0,format,
+					   nersc,scidaca,scidacb);
+    assert(nersc==nersc_ref);
+    diff = dst - src;
+    assert(norm2(diff)/norm2(src) < 1.0e-12);
+  }
+  BinaryIO::ioAggregators     = 0;
+  BinaryIO::ioStripeBytes     = stripe;
+  BinaryIO::ioAggregatorBufferBytes = buffer;
+  BinaryIO::latticeChunkBytes = 0;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian         *UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian *UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  LatticeFermionD src(UGrid); random(pRNG,src);
+  LatticeFermionD src_o(UrbGrid); pickCheckerboard(Odd,src_o,src);
+
+  ChunkedRoundTrip<LatticeFermionD,SpinColourVectorD>(src,  "chunked_io_64","IEEE64BIG");
+  ChunkedRoundTrip<LatticeFermionD,SpinColourVectorD>(src,  "chunked_io_le","IEEE64");
+  ChunkedRoundTrip<LatticeFermionD,SpinColourVectorD>(src_o,"chunked_io_rb","IEEE64BIG");
+
+  ////////////////////////////////////////////////////////////
+  // NERSC gauge file; the reader checks the header checksum
+  // so write and read with different chunkings
+  ////////////////////////////////////////////////////////////
+  LatticeGaugeFieldD U(UGrid), Uread(UGrid), diff(UGrid);
+  SU<Nc>::HotConfiguration(pRNG,U);
+  FieldMetaData header;
+  BinaryIO::latticeChunkBytes = 4096;
+  NerscIO::writeConfiguration(U,"chunked_io_nersc",0,0);
+  BinaryIO::latticeChunkBytes = 0;
+  UGrid->Barrier(); // the boss rewrites the header after the payload
+  NerscIO::readConfiguration(Uread,header,"chunked_io_nersc");
+  diff = Uread - U;
+  std::cout << GridLogMessage << "NERSC read back rel. err "<<norm2(diff)/norm2(U)<<std::endl;
+  assert(norm2(diff)/norm2(U) < 1.0e-12);
+
+  Grid_finalize();
+}
@@ -0,0 +1,110 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_block_checkpoint.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Damage the file as a crash or a bad disk would: scribble over block data, or drop an index entry
+void Scribble(const std::string &file,uint64_t offset,uint64_t bytes)
+{
+  std::vector<char> junk(bytes,0x5a);
+  int fd = ::open(file.c_str(),O_WRONLY);
+  assert(fd>=0);
+  assert(::pwrite(fd,&junk[0],bytes,offset)==bytes);
+  ::close(fd);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridSerialRNG   sRNG;  sRNG.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeFieldD Umu(UGrid), Uread(UGrid);
+  SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  std::string config("./ckpoint_block_lat");
+  std::string rng("./ckpoint_block_rng");
+  uint64_t blockBytes = 16*1024; // several blocks per rank even on small volumes
+
+  BlockIO::BlockStats first = BlockIO::writeLatticeBlocks<vLorentzColourMatrixD,LorentzColourMatrixD>(Umu,config,blockBytes);
+  BlockIO::writeRNGBlocks(sRNG,pRNG,rng,blockBytes);
+  assert(first.kept==0);
+
+  ////////////////////////////////////////////////
+  // Same data again: nothing is rewritten
+  ////////////////////////////////////////////////
+  BlockIO::BlockStats again = BlockIO::writeLatticeBlocks<vLorentzColourMatrixD,LorentzColourMatrixD>(Umu,config,blockBytes);
+  assert(again.written==0 && again.kept==first.written);
+
+  ////////////////////////////////////////////////
+  // A corrupt block and a lost index entry are the
+  // only blocks rewritten on resume
+  ////////////////////////////////////////////////
+  if ( UGrid->IsBoss() ) {
+    int fd = ::open(config.c_str(),O_RDONLY);
+    uint64_t xml_bytes;
+    assert(::pread(fd,&xml_bytes,8,8)==8);
+    uint64_t index_start = 16+xml_bytes;
+    uint64_t ent[BlockIO::IndexWords];
+    assert(::pread(fd,ent,sizeof(ent),index_start)==sizeof(ent));
+    ::close(fd);
+    Scribble(config,ent[0]+17,64);                       // block 0 data
+    Scribble(config,index_start+sizeof(ent)+24,8);        // block 1 "complete" word
+  }
+  UGrid->Barrier();
+  BlockIO::BlockStats resume = BlockIO::writeLatticeBlocks<vLorentzColourMatrixD,LorentzColourMatrixD>(Umu,config,blockBytes);
+  std::cout << GridLogMessage << "resume rewrote " << resume.written << " blocks, kept " << resume.kept << std::endl;
+  assert(resume.written==2 && resume.kept==first.written-2);
+
+  ////////////////////////////////////////////////
+  // Restore and compare; the RNGs must carry on
+  // the same streams
+  ////////////////////////////////////////////////
+  GridSerialRNG   sRNG2;  sRNG2.SeedFixedIntegers(std::vector<int>({9}));
+  GridParallelRNG pRNG2(UGrid); pRNG2.SeedFixedIntegers(std::vector<int>({9}));
+  BlockIO::readLatticeBlocks<vLorentzColourMatrixD,LorentzColourMatrixD>(Uread,config);
+  BlockIO::readRNGBlocks(sRNG2,pRNG2,rng);
+
+  Uread = Uread - Umu;
+  assert(norm2(Uread)==0.0);
+
+  LatticeComplexD a(UGrid), b(UGrid);
+  random(pRNG,a);   random(pRNG2,b);
+  a = a - b;
+  assert(norm2(a)==0.0);
+  ComplexD sa, sb;
+  random(sRNG,sa);  random(sRNG2,sb);
+  assert(sa==sb);
+  std::cout << GridLogMessage << "Block checkpoint round trip OK" << std::endl;
+
+  Grid_finalize();
+}
@@ -0,0 +1,108 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_compressed_io.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+uint64_t FileBytes(const std::string &file)
+{
+  struct stat st;
+  assert(stat(file.c_str(),&st)==0);
+  return st.st_size;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  GridCartesian *UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  std::string file("./ckpoint_compressed.bin");
+  uint64_t dense = UGrid->gSites()*sizeof(LorentzColourMatrixD);
+
+  ////////////////////////////////////////////////////////////
+  // Gauge fields: hot and cold, every reconstruction.
+  // The cold links defeat the 8 real scheme and must fall
+  // back to 12 without loss.
+  ////////////////////////////////////////////////////////////
+  LatticeGaugeFieldD Umu(UGrid), Uread(UGrid);
+  for(int hot=1;hot>=0;hot--){
+    if ( hot ) SU<Nc>::HotConfiguration(pRNG,Umu);
+    else       SU<Nc>::ColdConfiguration(pRNG,Umu);
+    for(int recon : std::vector<int>({0,12,8})){
+      CompressedIO::writeConfiguration(Umu,file,recon);
+      Uread = Zero();
+      CompressedIO::readConfiguration(Uread,file);
+      Uread = Uread - Umu;
+      RealD err = norm2(Uread)/norm2(Umu);
+      std::cout << GridLogMessage << (hot ? "hot" : "cold") << " recon " << recon
+		<< " stored " << FileBytes(file) << " of " << dense << " bytes, err " << err << std::endl;
+      assert(err < 1.0e-20);
+      if ( recon ) assert(FileBytes(file) < dense);
+    }
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Propagator like fields at full and single precision,
+  // with a block size forcing many blocks per rank
+  ////////////////////////////////////////////////////////////
+  LatticeFermionD psi(UGrid), chi(UGrid);
+  gaussian(pRNG,psi);
+  for(int level : std::vector<int>({0,1,6})){
+    CompressedIO::writeField(psi,file,64,0,level,4096);
+    chi = Zero();
+    CompressedIO::readField(chi,file);
+    chi = chi - psi;
+    assert(norm2(chi)==0.0);
+  }
+  CompressedIO::writeField(psi,file,32,0,1,4096);
+  uint64_t fp32 = FileBytes(file);
+  CompressedIO::readField(chi,file);
+  chi = chi - psi;
+  RealD err = norm2(chi)/norm2(psi);
+  std::cout << GridLogMessage << "fp32 stored " << fp32 << " bytes, err " << err << std::endl;
+  assert(err < 1.0e-12);
+  assert(fp32 < UGrid->gSites()*sizeof(SpinColourVectorD)/2 + 65536);
+
+  ////////////////////////////////////////////////////////////
+  // Reading on a different decomposition of the same volume
+  ////////////////////////////////////////////////////////////
+  Coordinate mpi = GridDefaultMpi();
+  Coordinate rmpi(Nd,1);
+  rmpi[0] = mpi[Nd-1]; rmpi[Nd-1] = mpi[0];
+  for(int d=1;d<Nd-1;d++) rmpi[d] = mpi[d];
+  GridCartesian *RGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),rmpi);
+  LatticeFermionD rchi(RGrid);
+  CompressedIO::writeField(psi,file,64,0,1,4096);
+  CompressedIO::readField(rchi,file);
+  assert(fabs(norm2(rchi)-norm2(psi)) < 1.0e-12*norm2(psi));
+
+  Grid_finalize();
+}
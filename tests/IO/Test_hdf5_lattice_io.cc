@@ -0,0 +1,79 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_hdf5_lattice_io.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+#ifdef HAVE_HDF5
+  GridCartesian *UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeGaugeFieldD Umu(UGrid), Uread(UGrid);
+  LatticePropagatorD prop(UGrid), pread(UGrid);
+  LatticeComplexD    c(UGrid), cread(UGrid);
+  SU<Nc>::HotConfiguration(pRNG,Umu);
+  gaussian(pRNG,prop);
+  gaussian(pRNG,c);
+
+  std::string file("./ckpoint_lattice.h5");
+  for(int deflate : std::vector<int>({0,4})){
+    {
+      // Several fields, one self describing file
+      Hdf5LatticeWriter WR(UGrid,file,deflate);
+      WR.writeField("gauge",Umu);
+      WR.writeField("propagator",prop,32);
+      WR.writeField("complex",c);
+    }
+    Hdf5LatticeReader RD(UGrid,file);
+    RD.readField("complex",cread);
+    RD.readField("gauge",Uread);
+    RD.readField("propagator",pread);
+
+    Uread = Uread - Umu;
+    pread = pread - prop;
+    cread = cread - c;
+    RealD eu = norm2(Uread);
+    RealD ep = norm2(pread)/norm2(prop);
+    RealD ec = norm2(cread);
+    std::cout << GridLogMessage << "deflate " << deflate << " gauge " << eu << " propagator (fp32) " << ep
+	      << " complex " << ec << std::endl;
+    assert(eu == 0.0);
+    assert(ec == 0.0);
+    assert(ep < 1.0e-12);
+  }
+#else
+  std::cout << GridLogMessage << "Grid built without HDF5, nothing to test" << std::endl;
+#endif
+
+  Grid_finalize();
+}
@@ -0,0 +1,124 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_io_checksums.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef SpinColourVectorD fobj;
+
+// Per site reference versions of the legacy checksums
+void ReferenceChecksums(GridBase *grid,std::vector<fobj> &buf,uint32_t &nersc,uint32_t &csuma,uint32_t &csumb)
+{
+  Coordinate local_vol   = grid->LocalDimensions();
+  Coordinate local_start = grid->LocalStarts();
+  Coordinate global_vol  = grid->FullDimensions();
+  Coordinate coor;
+  nersc = csuma = csumb = 0;
+  for(uint64_t l=0;l<buf.size();l++){
+    uint32_t *w = (uint32_t *)&buf[l];
+    for(int j=0;j<sizeof(fobj)/sizeof(uint32_t);j++) nersc += w[j];
+
+    int global_site;
+    Lexicographic::CoorFromIndex(coor,l,local_vol);
+    for(int d=0;d<grid->Nd();d++) coor[d] += local_start[d];
+    Lexicographic::IndexFromCoor(coor,global_site,global_vol);
+    uint32_t g29 = global_site%29;
+    uint32_t g31 = global_site%31;
+    uint32_t crc = crc32(0,(unsigned char *)w,sizeof(fobj));
+    csuma ^= crc<<g29 | crc>>(32-g29);
+    csumb ^= crc<<g31 | crc>>(32-g31);
+  }
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  ////////////////////////////////////////////////////////////
+  // CRC32C check value, and chaining
+  ////////////////////////////////////////////////////////////
+  const char *check = "123456789";
+  uint32_t crc = GridChecksum::crc32c_update(0,check,9);
+  std::cout << GridLogMessage << "crc32c(123456789) = " << std::hex << crc << std::dec << std::endl;
+  assert(crc == 0xE3069283);
+  std::vector<unsigned char> bytes(1003);
+  for(int i=0;i<bytes.size();i++) bytes[i] = (unsigned char)(37*i+5);
+  uint32_t whole = GridChecksum::crc32c_update(0,&bytes[0],bytes.size());
+  uint32_t part  = GridChecksum::crc32c_update(GridChecksum::crc32c_update(0,&bytes[0],501),&bytes[501],502);
+  assert(whole == part);
+
+  ////////////////////////////////////////////////////////////
+  // Line walking checksums against the per site reference
+  ////////////////////////////////////////////////////////////
+  GridCartesian         *UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian *UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  std::vector<GridBase *> grids({UGrid,UrbGrid});
+
+  for(auto grid : grids){
+    GridParallelRNG pRNG(grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+    LatticeFermionD src(grid); random(pRNG,src);
+    std::vector<fobj> buf(grid->lSites());
+    unvectorizeToLexOrdArray(buf,src);
+
+    uint32_t nersc_ref, csuma_ref, csumb_ref;
+    ReferenceChecksums(grid,buf,nersc_ref,csuma_ref,csumb_ref);
+
+    uint32_t nersc=0, csuma=0, csumb=0;
+    BinaryIO::NerscChecksum(grid,buf,nersc);
+    BinaryIO::ScidacChecksum(grid,buf,csuma,csumb);
+    std::cout << GridLogMessage << std::hex << "nersc "<<nersc<<" "<<nersc_ref
+	      << " scidac "<<csuma<<" "<<csuma_ref<<" "<<csumb<<" "<<csumb_ref << std::dec << std::endl;
+    assert(nersc == nersc_ref);
+    assert(csuma == csuma_ref);
+    assert(csumb == csumb_ref);
+
+    ////////////////////////////////////////////////////////////
+    // Chunked accumulation, including ragged (non x-line) pieces,
+    // reproduces the whole buffer result for all three sums
+    ////////////////////////////////////////////////////////////
+    uint64_t grid_csum=0;
+    csuma=csumb=0;
+    BinaryIO::ScidacChecksum(grid,&buf[0],0,buf.size(),csuma,csumb,&grid_csum);
+
+    uint64_t grid_chunked=0;
+    uint32_t nersc_chunked=0, csuma_chunked=0, csumb_chunked=0;
+    for(uint64_t s=0;s<buf.size();){
+      uint64_t n = std::min<uint64_t>(7 + s%5,buf.size()-s);
+      BinaryIO::NerscChecksum(&buf[s],n,nersc_chunked);
+      BinaryIO::ScidacChecksum(grid,&buf[s],s,n,csuma_chunked,csumb_chunked,&grid_chunked);
+      s+=n;
+    }
+    assert(nersc_chunked == nersc_ref);
+    assert(csuma_chunked == csuma_ref);
+    assert(csumb_chunked == csumb_ref);
+    assert(grid_chunked  == grid_csum);
+  }
+
+  Grid_finalize();
+}
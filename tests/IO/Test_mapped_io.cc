@@ -0,0 +1,111 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/IO/Test_mapped_io.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  typedef SpinColourVectorD sobj;
+  typedef SpinColourVectorF fobj32;
+
+  GridCartesian *UGrid = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridParallelRNG pRNG(UGrid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  Coordinate latt = GridDefaultLatt();
+
+  LatticeFermionD psi(UGrid), chi(UGrid), ref(UGrid), diff(UGrid);
+  gaussian(pRNG,psi);
+
+  std::string file("./ckpoint_mapped.bin");
+  uint64_t offset = 4096+8;  // unaligned payload, as in a lime record
+  uint32_t nersc, csuma, csumb;
+
+  std::vector<std::string> formats({"IEEE64BIG","IEEE64"});
+  for(auto format : formats){
+    BinaryIO::writeLatticeObject<vSpinColourVectorD,sobj>(psi,file,BinarySimpleMunger<sobj,sobj>(),offset,format,nersc,csuma,csumb);
+
+    MappedLatticeFile<sobj> mapped(file,offset,latt,format);
+
+    ////////////////////////////////////////////////
+    // Whole field
+    ////////////////////////////////////////////////
+    chi = Zero();
+    mapped.readField(chi);
+    diff = chi - psi;
+    std::cout << GridLogMessage << format << " full field diff " << norm2(diff) << std::endl;
+    assert(norm2(diff)==0.0);
+
+    ////////////////////////////////////////////////
+    // Two timeslices, touching only their pages
+    ////////////////////////////////////////////////
+    int T = latt[Nd-1];
+    LatticeInteger tcoor(UGrid);
+    LatticeCoordinate(tcoor,Nd-1);
+    ref = Zero();
+    ref = where((tcoor==1)||(tcoor==T-1),psi,ref);
+
+    MappedLatticeFile<sobj> lazy(file,offset,latt,format);
+    lazy.prefetchSlice(chi,Nd-1,1);
+    chi = Zero();
+    lazy.readSlice(chi,Nd-1,1);
+    lazy.readSlice(chi,Nd-1,T-1);
+    diff = chi - ref;
+    uint64_t touched = lazy.BytesTouched();
+    UGrid->GlobalSum(touched);
+    std::cout << GridLogMessage << format << " slice diff " << norm2(diff) << " bytes touched " << touched << std::endl;
+    assert(norm2(diff)==0.0);
+    assert(touched == 2*UGrid->gSites()/T*sizeof(sobj));
+  }
+
+  ////////////////////////////////////////////////
+  // Single precision file into a double field, and a
+  // sub-volume landing in a smaller lattice
+  ////////////////////////////////////////////////
+  BinaryIO::writeLatticeObject<vSpinColourVectorD,fobj32>(psi,file,BinarySimpleMunger<sobj,fobj32>(),0,"IEEE32BIG",nersc,csuma,csumb);
+  MappedLatticeFile<fobj32> mapped32(file,0,latt,"IEEE32BIG");
+  mapped32.readField(chi);
+  diff = chi - psi;
+  assert(norm2(diff)/norm2(psi) < 1.0e-12);
+
+  if ( UGrid->ProcessorCount()==1 ) {
+    Coordinate half(Nd), corner(Nd,1), zero(Nd,0);
+    for(int d=0;d<Nd;d++) half[d] = latt[d]/2;
+    GridCartesian *SubGrid = SpaceTimeGrid::makeFourDimGrid(half, GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+    LatticeFermionD sub(SubGrid), subref(SubGrid), subdiff(SubGrid);
+    mapped32.readRegion(sub,corner,zero,half);
+    localCopyRegion(chi,subref,corner,zero,half);
+    subdiff = sub - subref;
+    std::cout << GridLogMessage << "sub-volume diff " << norm2(subdiff) << std::endl;
+    assert(norm2(subdiff)==0.0);
+  }
+
+  Grid_finalize();
+}
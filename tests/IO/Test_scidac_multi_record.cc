@@ -0,0 +1,125 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_nersc_io.cc
+
+    Copyright (C) 2015
+
+Author: Azusa Yamaguchi <ayamaguc@staffmail.ed.ac.uk>
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+Author: paboyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+#ifdef HAVE_LIME
+std::vector<char> FileBytes(const std::string &file)
+{
+  std::ifstream f(file,std::ios::binary);
+  return std::vector<char>((std::istreambuf_iterator<char>(f)),std::istreambuf_iterator<char>());
+}
+
+template<class Field>
+void TestRecords(GridBase *grid,GridParallelRNG &pRNG,int nfield,const std::string &stem)
+{
+  std::vector<Field> fields(nfield,grid);
+  std::vector<emptyUserRecord> records(nfield);
+  for(int i=0;i<nfield;i++){
+    gaussian(pRNG,fields[i]);
+    records[i].dummy = i;
+  }
+
+  // Reference: one record at a time
+  std::string ref   = stem + ".single";
+  std::string multi = stem + ".multi";
+  {
+    ScidacWriter WR(grid->IsBoss());
+    WR.open(ref);
+    for(int i=0;i<nfield;i++) WR.writeScidacFieldRecord(fields[i],records[i]);
+    WR.close();
+  }
+  {
+    ScidacWriter WR(grid->IsBoss());
+    WR.open(multi);
+    WR.writeScidacFieldRecords(fields,records);
+    WR.close();
+  }
+  grid->Barrier();
+  if ( grid->IsBoss() ) {
+    std::vector<char> a = FileBytes(ref);
+    std::vector<char> b = FileBytes(multi);
+    std::cout << GridLogMessage << ref << " " << a.size() << " bytes, " << multi << " " << b.size() << " bytes" << std::endl;
+    assert(a == b);
+  }
+
+  // Batched read of a per record file, and per record reads of the batched one
+  std::vector<Field> back(nfield,grid);
+  std::vector<emptyUserRecord> back_records;
+  {
+    ScidacReader RD;
+    RD.open(ref);
+    RD.readScidacFieldRecords(back,back_records);
+    RD.close();
+  }
+  Field diff(grid);
+  for(int i=0;i<nfield;i++){
+    diff = back[i]-fields[i];
+    assert(norm2(diff)==0.0);
+    assert(back_records[i].dummy==i);
+  }
+  {
+    ScidacReader RD;
+    RD.open(multi);
+    for(int i=0;i<nfield;i++){
+      emptyUserRecord record;
+      RD.readScidacFieldRecord(back[i],record);
+      diff = back[i]-fields[i];
+      assert(norm2(diff)==0.0);
+      assert(record.dummy==i);
+    }
+    RD.close();
+  }
+}
+#endif
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+#ifdef HAVE_LIME
+
+  GridCartesian         *UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian         *FGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexF::Nsimd()),GridDefaultMpi());
+
+  GridParallelRNG pRNG(UGrid);  pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+  GridParallelRNG fRNG(FGrid);  fRNG.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+
+  TestRecords<LatticeFermionD>(UGrid,pRNG,5,"./ckpoint_multi_d");
+  TestRecords<LatticeFermionF>(FGrid,fRNG,4,"./ckpoint_multi_f");
+  TestRecords<LatticeColourVectorD>(UGrid,pRNG,1,"./ckpoint_multi_one");
+
+  std::cout << GridLogMessage << "Scidac multi-record checks passed" << std::endl;
+#else
+  std::cout << GridLogMessage << "Scidac multi-record checks skipped: Grid built without LIME" << std::endl;
+#endif
+  Grid_finalize();
+}
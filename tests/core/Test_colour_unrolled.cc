@@ -0,0 +1,160 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_colour_unrolled.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field>
+void Check(const Field &a,const Field &b,const std::string &name,RealD tol)
+{
+  Field diff = a-b;
+  RealD n = norm2(diff)/norm2(b);
+  std::cout << GridLogMessage << name << " relative diff " << n << std::endl;
+  assert(n < tol);
+}
+
+// Unrolled kernels against plain loops, N=7 covers the generic fall back
+template<int N>
+void CheckColour(GridParallelRNG &RNG)
+{
+  typedef iScalar<iMatrix<vComplexD,N> >   vMat;
+  typedef iVector<iVector<vComplexD,N>,2 > vHalf;
+  typedef Lattice<vMat>  LatticeMat;
+  typedef Lattice<vHalf> LatticeHalf;
+  GridBase *grid = RNG.Grid();
+  std::string tag = " N="+std::to_string(N);
+
+  LatticeMat  a(grid), b(grid), c(grid), ref(grid);
+  LatticeHalf chi(grid), phi(grid), phi_ref(grid);
+  gaussian(RNG,a);
+  gaussian(RNG,b);
+  gaussian(RNG,chi);
+
+  c = a*b;
+  {
+    autoView(a_v,a,CpuRead);
+    autoView(b_v,b,CpuRead);
+    autoView(chi_v,chi,CpuRead);
+    autoView(ref_v,ref,CpuWrite);
+    autoView(phi_v,phi,CpuWrite);
+    autoView(phi_ref_v,phi_ref,CpuWrite);
+    thread_for(ss,grid->oSites(),{
+      for(int i=0;i<N;i++){
+	for(int j=0;j<N;j++){
+	  vComplexD s = a_v[ss]()(i,0)*b_v[ss]()(0,j);
+	  for(int k=1;k<N;k++) s = s + a_v[ss]()(i,k)*b_v[ss]()(k,j);
+	  ref_v[ss]()(i,j) = s;
+	}
+	for(int sp=0;sp<2;sp++){
+	  vComplexD s = a_v[ss]()(i,0)*chi_v[ss](sp)(0);
+	  for(int k=1;k<N;k++) s = s + a_v[ss]()(i,k)*chi_v[ss](sp)(k);
+	  phi_ref_v[ss](sp)(i) = s;
+	}
+      }
+      // The multLink form of the generic Wilson kernels
+      mult(&phi_v[ss],&a_v[ss],&chi_v[ss]);
+    });
+  }
+  Check(c,ref,"Matrix x matrix"+tag,1.0e-28);
+  Check(phi,phi_ref,"Matrix x spin vector"+tag,1.0e-28);
+
+  ////////////////////////////////////////////////////////////
+  // Exponential of a traceless antihermitian matrix against the
+  // term by term Taylor series, and the projection against the
+  // Gram-Schmidt loop
+  ////////////////////////////////////////////////////////////
+  RealD alpha = 0.1;
+  const int Nexp = 12;
+  LatticeMat x(grid), ex(grid), ex_ref(grid), pr(grid), pr_ref(grid);
+  x = Ta(a);
+  ex = expMat(x,alpha,Nexp);
+  b = a + 0.1*b;
+  pr = ProjectOnGroup(b);
+  {
+    autoView(x_v,x,CpuRead);
+    autoView(b_v,b,CpuRead);
+    autoView(ex_ref_v,ex_ref,CpuWrite);
+    autoView(pr_ref_v,pr_ref,CpuWrite);
+    thread_for(ss,grid->oSites(),{
+      iMatrix<vComplexD,N> X = x_v[ss]()*alpha;
+      iMatrix<vComplexD,N> xn(1.0), e(1.0);
+      RealD nfac = 1.0;
+      for(int i=1;i<=Nexp;i++){
+	nfac = nfac/RealD(i);
+	xn = xn*X;
+	e  = e + xn*nfac;
+      }
+      ex_ref_v[ss]() = e;
+
+      iMatrix<vComplexD,N> r = b_v[ss]();
+      for(int c1=0;c1<N;c1++){
+	vComplexD inner; zeroit(inner);
+	for(int c2=0;c2<N;c2++) inner = inner + conjugate(r(c1,c2))*r(c1,c2);
+	vComplexD nrm = rsqrt(inner);
+	for(int c2=0;c2<N;c2++) r(c1,c2) = r(c1,c2)*nrm;
+	for(int bb=c1+1;bb<N;bb++){
+	  vComplexD p; zeroit(p);
+	  for(int c=0;c<N;c++) p = p + conjugate(r(c1,c))*r(bb,c);
+	  for(int c=0;c<N;c++) r(bb,c) = r(bb,c) - p*r(c1,c);
+	}
+      }
+      pr_ref_v[ss]() = r;
+    });
+  }
+  if ( N!=3 ) Check(ex,ex_ref,"Exponentiate"+tag,1.0e-26);
+  Check(pr,pr_ref,"ProjectOnGroup"+tag,1.0e-26);
+
+  LatticeMat unit(grid), uu(grid);
+  unit = 1.0;
+  uu = ex*adj(ex);
+  Check(uu,unit,"Exponentiate unitarity"+tag,1.0e-24);
+  uu = pr*adj(pr);
+  Check(uu,unit,"ProjectOnGroup unitarity"+tag,1.0e-26);
+}
+
+int main(int argc, char ** argv)
+{
+  Grid_init(&argc, &argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+  GridParallelRNG   RNG(&Grid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  CheckColour<2>(RNG);
+  CheckColour<3>(RNG);
+  CheckColour<4>(RNG);
+  CheckColour<5>(RNG);
+  CheckColour<6>(RNG);
+  CheckColour<7>(RNG);
+
+  std::cout << GridLogMessage << "All unrolled colour kernel tests passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,126 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_cshift_plan.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// The per call Cshift the plans replace
+template<class vobj> Lattice<vobj> LegacyCshift(const Lattice<vobj> &rhs,int dimension,int shift)
+{
+  GridBase *grid = rhs.Grid();
+  Lattice<vobj> ret(grid);
+  int fd = grid->_fdimensions[dimension];
+  shift = (shift+fd)%fd;
+  ret.Checkerboard() = grid->CheckerBoardDestination(rhs.Checkerboard(),shift,dimension);
+#ifdef GRID_COMMS_NONE
+  Cshift_local(ret,rhs,dimension,shift);
+#else
+  int comm_dim   = grid->_processors[dimension] >1 ;
+  int splice_dim = grid->_simd_layout[dimension]>1 && (comm_dim);
+  if ( !comm_dim )       Cshift_local(ret,rhs,dimension,shift);
+  else if ( splice_dim ) Cshift_comms_simd(ret,rhs,dimension,shift);
+  else                   Cshift_comms(ret,rhs,dimension,shift);
+#endif
+  return ret;
+}
+
+template<class Field>
+void CheckShifts(GridBase *grid,GridParallelRNG &pRNG,int cb,const std::string &name)
+{
+  Field full(pRNG.Grid()); gaussian(pRNG,full);
+  Field src(grid);
+  if ( grid->_isCheckerBoarded ) pickCheckerboard(cb,src,full);
+  else                           src = full;
+
+  for(int mu=0;mu<grid->Nd();mu++){
+    // The simd split, two pass case is unsupported by Scatter_plane_merge
+    if ( grid->CheckerBoarded(mu) && grid->_simd_layout[mu]>1 && grid->_processors[mu]>1 ) continue;
+    int L = grid->_fdimensions[mu];
+    std::vector<int> shifts({1,-1,2,L/2,L-1,0});
+    for(auto s : shifts){
+      Field ref = LegacyCshift(src,mu,s);
+      Field res = Cshift(src,mu,s);
+      Field again = Cshift(src,mu,s); // cached plan
+      Field diff(grid);
+      assert(res.Checkerboard()==ref.Checkerboard());
+      diff = res-ref;   assert(norm2(diff)==0.0);
+      diff = again-ref; assert(norm2(diff)==0.0);
+    }
+
+    // Several displacements of one field, several fields by one displacement
+    std::vector<Field> many = Cshift(src,mu,shifts);
+    for(int i=0;i<shifts.size();i++){
+      Field diff(grid);
+      diff = many[i]-LegacyCshift(src,mu,shifts[i]);
+      assert(norm2(diff)==0.0);
+    }
+    std::vector<Field> fields({src,many[0],many[1]});
+    std::vector<Field> shifted = Cshift(fields,mu,-1);
+    for(int i=0;i<fields.size();i++){
+      Field diff(grid);
+      diff = shifted[i]-LegacyCshift(fields[i],mu,-1);
+      assert(norm2(diff)==0.0);
+    }
+    // Members on one plan share its tables, each with its own face buffers
+    typedef typename Field::vector_object vobj;
+    if ( !grid->_isCheckerBoarded ) {
+      assert(CshiftPlanCache<vobj>::Get(grid,mu,-1,cb)->Slots()==fields.size());
+    }
+  }
+  // The cache keeps only the most recently used plans
+  typedef typename Field::vector_object vobj;
+  assert(CshiftPlanCache<vobj>::Size(grid) <= CshiftPlanCacheDepth);
+  std::cout << GridLogMessage << name << " plans match the per call Cshift" << std::endl;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian         Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian RBGrid(&Grid);
+
+  GridParallelRNG pRNG(&Grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  CheckShifts<LatticeComplexD>     (&Grid,pRNG,Even,"LatticeComplexD");
+  CheckShifts<LatticeColourMatrixD>(&Grid,pRNG,Even,"LatticeColourMatrixD");
+  CheckShifts<LatticeFermionD>     (&RBGrid,pRNG,Even,"LatticeFermionD even");
+  CheckShifts<LatticeFermionD>     (&RBGrid,pRNG,Odd ,"LatticeFermionD odd");
+
+  // A bound below the working set evicts plans, also within a batch
+  CshiftPlanCacheDepth = 2;
+  CheckShifts<LatticeComplexD>     (&Grid,pRNG,Even,"LatticeComplexD, 2 plans cached");
+  CheckShifts<LatticeFermionD>     (&RBGrid,pRNG,Odd ,"LatticeFermionD odd, 2 plans cached");
+
+  std::cout << GridLogMessage << "Cshift plan checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,129 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_fused_reductions.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+#include <Grid/algorithms/iterative/PrecGeneralisedConjugateResidual.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field,class Solver>
+void CheckSolve(LinearOperatorBase<Field> &Op,Solver &solve,const Field &src,const std::string &name)
+{
+  Field result(src.Grid()), check(src.Grid()), resid(src.Grid());
+  result = Zero();
+  solve(Op,src,result);
+  Op.Op(result,check);
+  resid = src - check;
+  RealD true_residual = std::sqrt(norm2(resid)/norm2(src));
+  std::cout << GridLogMessage << name << " true residual " << true_residual << std::endl;
+  assert(true_residual < 1.0e-7);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian         Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian RBGrid(&Grid);
+
+  GridParallelRNG pRNG(&Grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  ////////////////////////////////////////////////////////////
+  // Fused list of inner products and norms against one at a time
+  ////////////////////////////////////////////////////////////
+  std::vector<LatticeFermionD> f(4,&Grid);
+  for(auto &x : f) gaussian(pRNG,x);
+
+  std::vector<ComplexD> ip;
+  innerProductMulti(ip,{&f[0],&f[1],&f[2],&f[3],&f[0]},{&f[1],&f[1],&f[3],&f[0],&f[0]});
+  std::vector<ComplexD> ref({innerProduct(f[0],f[1]),ComplexD(norm2(f[1])),
+			     innerProduct(f[2],f[3]),innerProduct(f[3],f[0]),ComplexD(norm2(f[0]))});
+  for(int i=0;i<ref.size();i++){
+    std::cout << GridLogMessage << "fused " << ip[i] << " single " << ref[i] << std::endl;
+    assert(abs(ip[i]-ref[i]) <= 1.0e-14*abs(ref[i]));
+  }
+
+  // Longer lists than one fused batch on accelerators
+  std::vector<const LatticeFermionD *> left, right;
+  for(int i=0;i<12;i++){
+    left.push_back(&f[i%4]);
+    right.push_back(&f[(i+i/4)%4]);
+  }
+  innerProductMulti(ip,left,right);
+  for(int i=0;i<12;i++){
+    ComplexD single = innerProduct(*left[i],*right[i]);
+    assert(abs(ip[i]-single) <= 1.0e-14*abs(single));
+  }
+
+  ComplexD ipn; RealD nrm;
+  innerProductNorm(ipn,nrm,f[2],f[3]);
+  assert(abs(ipn-ref[2]) <= 1.0e-14*abs(ref[2]));
+  assert(std::fabs(nrm-norm2(f[2])) <= 1.0e-14*nrm);
+
+  // Basis projections share the fused kernel
+  basisInnerProducts(ip,f,f[3],1,4);
+  assert(ip.size()==3);
+  for(int k=1;k<4;k++){
+    ComplexD single = innerProduct(f[k],f[3]);
+    assert(abs(ip[k-1]-single) <= 1.0e-14*abs(single));
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Solvers on the fused reductions still converge
+  ////////////////////////////////////////////////////////////
+  LatticeGaugeFieldD Umu(&Grid); SU<Nc>::HotConfiguration(pRNG,Umu);
+  RealD mass=0.5;
+  WilsonFermionD Dw(Umu,Grid,RBGrid,mass);
+  MdagMLinearOperator<WilsonFermionD,LatticeFermionD> HermOp(Dw);
+  NonHermitianLinearOperator<WilsonFermionD,LatticeFermionD> NonHermOp(Dw);
+
+  LatticeFermionD src(&Grid); gaussian(pRNG,src);
+
+  BiCGSTAB<LatticeFermionD> bicgstab(1.0e-8,10000);
+  CheckSolve(NonHermOp,bicgstab,src,"BiCGSTAB");
+
+  GeneralisedMinimalResidual<LatticeFermionD> gmres(1.0e-8,10000,25);
+  CheckSolve(HermOp,gmres,src,"GMRES");
+
+  TrivialPrecon<LatticeFermionD> simple;
+  PrecGeneralisedConjugateResidual<LatticeFermionD> gcr(1.0e-8,10000,HermOp,simple,8,8);
+  LatticeFermionD result(&Grid), check(&Grid), resid(&Grid);
+  result = Zero();
+  gcr(src,result);
+  HermOp.HermOp(result,check);
+  resid = src - check;
+  RealD gcr_residual = std::sqrt(norm2(resid)/norm2(src));
+  std::cout << GridLogMessage << "GCR true residual " << gcr_residual << std::endl;
+  assert(gcr_residual < 1.0e-7);
+
+  std::cout << GridLogMessage << "Fused reduction checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,146 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_general_halo_stencil.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// f(x+shift) by a chain of Cshifts
+template<class Field>
+Field ReferenceShift(const Field &f,const Coordinate &shift)
+{
+  Field ret(f);
+  for(int d=0;d<shift.size();d++){
+    if ( shift[d] ) ret = Cshift(ret,d,shift[d]);
+  }
+  return ret;
+}
+
+// Read every stencil point from the padded field, return them on the original grid
+template<class Field>
+std::vector<Field> StencilShift(GeneralHaloStencil &st,const Field &f)
+{
+  typedef typename Field::vector_object vobj;
+  int npoints = st._npoints;
+  GridBase *pgrid = st.PaddedGrid();
+
+  Field pad = st.Exchange(f);
+  std::vector<Field> ret(npoints,Field(f.Grid()));
+  Field pout(pgrid);
+  for(int p=0;p<npoints;p++){
+    autoView(pad_v ,pad ,AcceleratorRead);
+    autoView(pout_v,pout,AcceleratorWrite);
+    auto st_v = st.View();
+    accelerator_for(ss,pgrid->oSites(),vobj::Nsimd(),{
+      auto SE = st_v.GetEntry(p,ss);
+      auto nbr = coalescedReadGeneralPermute(pad_v[SE->_offset],SE->_permute);
+      coalescedWrite(pout_v[ss],nbr);
+    });
+    st.Extract(ret[p],pout);
+  }
+  return ret;
+}
+
+template<class Field>
+void CheckShifts(GridParallelRNG &RNG,GeneralHaloStencil &st,const std::vector<Coordinate> &shifts,const std::string &name)
+{
+  Field f(RNG.Grid());
+  gaussian(RNG,f);
+
+  std::vector<Field> res = StencilShift(st,f);
+  for(int p=0;p<shifts.size();p++){
+    Field diff = res[p]-ReferenceShift(f,shifts[p]);
+    RealD n = norm2(diff);
+    std::cout << GridLogMessage << name << " shift " << shifts[p] << " diff " << n << std::endl;
+    assert(n==0.0);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  Grid_init(&argc, &argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+  GridParallelRNG   RNG(&Grid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  std::cout << GridLogMessage << "Local volume " << Grid.LocalDimensions() << " simd " << simd_layout << std::endl;
+
+  ////////////////////////////////////////////////////////////
+  // Nearest neighbours, then diagonals and depth two hops
+  ////////////////////////////////////////////////////////////
+  std::vector<Coordinate> axis;
+  for(int mu=0;mu<Nd;mu++){
+    Coordinate s(Nd,0);
+    s[mu]= 1; axis.push_back(s);
+    s[mu]=-1; axis.push_back(s);
+  }
+  {
+    GeneralHaloStencil st(&Grid,axis);
+    std::cout << GridLogMessage << "Axis stencil depth " << st.Depth() << std::endl;
+    CheckShifts<LatticeComplexD>(RNG,st,axis,"ComplexD");
+    CheckShifts<LatticeColourMatrixD>(RNG,st,axis,"ColourMatrixD");
+  }
+
+  std::vector<Coordinate> general;
+  for(int mu=0;mu<Nd;mu++){
+    for(int nu=mu+1;nu<Nd;nu++){
+      Coordinate s(Nd,0);
+      s[mu]= 1; s[nu]= 1; general.push_back(s);
+      s[mu]= 1; s[nu]=-1; general.push_back(s);
+      s[mu]=-2; s[nu]= 1; general.push_back(s);
+    }
+  }
+  general.push_back(Coordinate({ 1, 1, 1, 1}));
+  general.push_back(Coordinate({-1, 1,-1, 1}));
+  general.push_back(Coordinate({ 2,-2, 2,-2}));
+  general.push_back(Coordinate({ 0, 0, 0, 0}));
+  {
+    GeneralHaloStencil st(&Grid,general);
+    std::cout << GridLogMessage << "General stencil depth " << st.Depth() << std::endl;
+    CheckShifts<LatticeComplexD>(RNG,st,general,"ComplexD");
+    CheckShifts<LatticeColourMatrixD>(RNG,st,general,"ColourMatrixD");
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Single precision fields on the same stencil geometry
+  ////////////////////////////////////////////////////////////
+  {
+    Coordinate simdF = GridDefaultSimd(Nd,vComplexF::Nsimd());
+    GridCartesian   GridF(latt_size,simdF,mpi_layout);
+    GridParallelRNG RNGF(&GridF);
+    RNGF.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+    GeneralHaloStencil st(&GridF,general);
+    CheckShifts<LatticeColourMatrixF>(RNGF,st,general,"ColourMatrixF");
+  }
+
+  std::cout << GridLogMessage << "All general halo stencil tests passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,113 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_lazy_fusion.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class Field>
+RealD Diff(const Field &a,const Field &b)
+{
+  Field d(a.Grid());
+  d = a - b;
+  return norm2(d);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian         Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian RBGrid(&Grid);
+
+  GridParallelRNG pRNG(&Grid); pRNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  LatticeFermionD r(&Grid), x(&Grid), p(&Grid), q(&Grid);
+  gaussian(pRNG,r); gaussian(pRNG,x); gaussian(pRNG,p); gaussian(pRNG,q);
+  RealD a = 0.37;
+
+  ////////////////////////////////////////////////////////////
+  // CG style update against the statements one at a time
+  ////////////////////////////////////////////////////////////
+  LatticeFermionD r_ref(r), x_ref(x);
+  r_ref = r_ref - a*q;
+  x_ref = x_ref + a*p;
+  RealD rr_ref = norm2(r_ref);
+  ComplexD rp_ref = innerProduct(r_ref,p);
+
+  RealD rr; ComplexD rp;
+  evaluateFused(lazyAssign(r, r - a*q),
+		lazyAssign(x, x + a*p),
+		lazyNorm2(rr, r),
+		lazyInnerProduct(rp, r, p));
+  std::cout << GridLogMessage << "fused norm2 " << rr << " single " << rr_ref << std::endl;
+  std::cout << GridLogMessage << "fused inner " << rp << " single " << rp_ref << std::endl;
+  assert(Diff(r,r_ref) == 0.0);
+  assert(Diff(x,x_ref) == 0.0);
+  assert(rr == rr_ref);
+  assert(rp == rp_ref);
+
+  ////////////////////////////////////////////////////////////
+  // Later statements see earlier writes at the same site;
+  // reductions of expressions need no temporary
+  ////////////////////////////////////////////////////////////
+  ComplexD b(0.25,-0.5);
+  LatticeFermionD p_ref(p);
+  p_ref = r_ref + b*p_ref;
+  r_ref = 2.0*r_ref - p_ref;
+  RealD nd_ref = norm2(closure(p_ref - x_ref));
+
+  RealD nd;
+  evaluateFused(lazyAssign(p, r + b*p),
+		lazyAssign(r, 2.0*r - p),
+		lazyNorm2(nd, p - x));
+  std::cout << GridLogMessage << "fused expression norm2 " << nd << " single " << nd_ref << std::endl;
+  assert(Diff(p,p_ref) == 0.0);
+  assert(Diff(r,r_ref) == 0.0);
+  assert(std::fabs(nd-nd_ref) <= 1.0e-14*nd_ref);
+
+  ////////////////////////////////////////////////////////////
+  // Checkerboarded fields carry their parity to the targets
+  ////////////////////////////////////////////////////////////
+  LatticeFermionD re(&RBGrid), pe(&RBGrid), ye(&RBGrid), ye_ref(&RBGrid);
+  pickCheckerboard(Odd,re,r);
+  pickCheckerboard(Odd,pe,p);
+  ye_ref = re*a + pe;
+  RealD ne_ref = norm2(ye_ref);
+  RealD ne;
+  evaluateFused(lazyAssign(ye, re*a + pe), lazyNorm2(ne, ye));
+  assert(ye.Checkerboard() == Odd);
+  assert(Diff(ye,ye_ref) == 0.0);
+  assert(ne == ne_ref);
+
+  std::cout << GridLogMessage << "Lazy fusion checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,108 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_rng_counter.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+template<class vobj>
+bool SameSites(const Lattice<vobj> &a,const Lattice<vobj> &b)
+{
+  typedef typename vobj::scalar_object sobj;
+  std::vector<sobj> abuf(a.Grid()->lSites()), bbuf(b.Grid()->lSites());
+  unvectorizeToLexOrdArray(abuf,a);
+  unvectorizeToLexOrdArray(bbuf,b);
+  uint32_t diff = (memcmp(&abuf[0],&bbuf[0],abuf.size()*sizeof(sobj)) != 0);
+  a.Grid()->GlobalSum(diff);
+  return diff==0;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  Coordinate simd_other(Nd);
+  for(int mu=0;mu<Nd;mu++) simd_other[mu] = simd_layout[Nd-1-mu];
+
+  GridCartesian Grid (latt_size,simd_layout,mpi_layout);
+  GridCartesian Other(latt_size,simd_other ,mpi_layout);
+
+  std::vector<int> seeds({1,2,3,4});
+
+  GridSerialRNG   sRNG;      sRNG.SeedFixedIntegers(seeds);
+  GridParallelRNG pRNG(&Grid); pRNG.SeedCounterBased(seeds);
+  GridParallelRNG oRNG(&Other); oRNG.SeedCounterBased(seeds);
+  assert(pRNG.CounterBased());
+
+  ////////////////////////////////////////////////////////////
+  // Streams depend on global coordinates, not on the layout
+  ////////////////////////////////////////////////////////////
+  LatticeFermionD a(&Grid), b(&Other), c(&Grid);
+  gaussian(pRNG,a);
+  gaussian(oRNG,b);
+  std::cout << GridLogMessage << "simd " << simd_layout << " norm2 " << norm2(a)
+	    << " simd " << simd_other << " norm2 " << norm2(b) << std::endl;
+  assert(SameSites(a,b));
+
+  // Each fill advances the epoch
+  gaussian(pRNG,c);
+  assert(!SameSites(a,c));
+
+  // Reseeding reproduces
+  pRNG.SeedCounterBased(seeds);
+  gaussian(pRNG,c);
+  assert(SameSites(a,c));
+
+  ////////////////////////////////////////////////////////////
+  // Checkpoint is a few words; restore resumes both streams
+  ////////////////////////////////////////////////////////////
+  std::string file("./ckpoint_rng_counter");
+  uint32_t nersc_w, csuma_w, csumb_w, nersc_r, csuma_r, csumb_r;
+  BinaryIO::writeRNG(sRNG,pRNG,file,0,nersc_w,csuma_w,csumb_w);
+
+  LatticeFermionD next(&Grid), resumed(&Grid);
+  ComplexD snext, sresumed;
+  gaussian(pRNG,next);
+  random(sRNG,snext);
+
+  GridSerialRNG   sRNG2;        sRNG2.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  GridParallelRNG pRNG2(&Grid); pRNG2.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  BinaryIO::readRNG(sRNG2,pRNG2,file,0,nersc_r,csuma_r,csumb_r);
+  assert(pRNG2.CounterBased());
+  assert(nersc_w==nersc_r && csuma_w==csuma_r && csumb_w==csumb_r);
+  gaussian(pRNG2,resumed);
+  random(sRNG2,sresumed);
+  assert(SameSites(next,resumed));
+  assert(snext==sresumed);
+
+  std::cout << GridLogMessage << "Counter based RNG checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,139 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/Test_slice_sum.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Site by site reference, in double precision
+template<class vobj>
+std::vector<typename vobj::scalar_objectD> ReferenceSliceSum(const Lattice<vobj> &field,int orthog)
+{
+  typedef typename vobj::scalar_object  sobj;
+  typedef typename vobj::scalar_objectD sobjD;
+  GridBase *grid = field.Grid();
+  Coordinate ldims  = grid->LocalDimensions();
+  Coordinate lstart = grid->LocalStarts();
+  int fd = grid->FullDimensions()[orthog];
+
+  std::vector<sobj> buf(grid->lSites());
+  unvectorizeToLexOrdArray(buf,field);
+  std::vector<sobjD> ref(fd,Zero());
+  Coordinate lcoor;
+  for(uint64_t l=0;l<buf.size();l++){
+    Lexicographic::CoorFromIndex(lcoor,l,ldims);
+    sobjD s = buf[l];
+    int t = lcoor[orthog]+lstart[orthog];
+    ref[t] = ref[t] + s;
+  }
+  grid->GlobalSumVector((ComplexD *)&ref[0],fd*sizeof(sobjD)/sizeof(ComplexD));
+  return ref;
+}
+
+template<class sobj,class sobjD>
+RealD Diff(const std::vector<sobj> &a,const std::vector<sobjD> &b)
+{
+  RealD n=0, d=0;
+  assert(a.size()==b.size());
+  for(int t=0;t<a.size();t++){
+    sobjD at = a[t];
+    sobjD dt = at-b[t];
+    n += norm2(b[t]);
+    d += norm2(dt);
+  }
+  return std::sqrt(d/n);
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+  GridCartesian Grid(latt_size,simd_layout,mpi_layout);
+
+  GridParallelRNG pRNG(&Grid); pRNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  const int nfield = 3;
+  std::vector<LatticeSpinColourMatrixD> fields(nfield,&Grid);
+  for(auto &f : fields) gaussian(pRNG,f);
+
+  LatticeComplexD coor(&Grid), phase(&Grid);
+  std::vector<LatticeComplexD> phases(nfield,&Grid);
+
+  for(int orthog=0;orthog<Nd;orthog++){
+
+    // Single field against the site by site reference
+    std::vector<SpinColourMatrixD> ss;
+    sliceSum(fields[0],ss,orthog);
+    auto ref = ReferenceSliceSum(fields[0],orthog);
+    RealD d = Diff(ss,ref);
+    std::cout << GridLogMessage << "sliceSum dir " << orthog << " rel diff " << d << std::endl;
+    assert(d < 1.0e-12);
+
+    // Several fields in one pass
+    std::vector<std::vector<SpinColourMatrixD> > multi;
+    sliceSum(fields,multi,orthog);
+    for(int k=0;k<nfield;k++){
+      sliceSum(fields[k],ss,orthog);
+      assert(Diff(multi[k],ss) < 1.0e-12);
+    }
+
+    // Several momenta in one pass
+    for(int k=0;k<nfield;k++){
+      phases[k] = Zero();
+      for(int mu=0;mu<Nd;mu++){
+	if ( mu==orthog ) continue;
+	LatticeCoordinate(coor,mu);
+	RealD p = 2.0*M_PI*(k+mu)/latt_size[mu];
+	phases[k] = phases[k] + p*coor;
+      }
+      phases[k] = exp(timesI(phases[k]));
+    }
+    sliceSum(fields[1],phases,multi,orthog);
+    for(int k=0;k<nfield;k++){
+      LatticeSpinColourMatrixD projected(&Grid);
+      projected = phases[k]*fields[1];
+      sliceSum(projected,ss,orthog);
+      assert(Diff(multi[k],ss) < 1.0e-12);
+    }
+
+    // Slice norms against the single field sums of the local norm density
+    std::vector<RealD> sn;
+    sliceNorm(sn,fields[2],orthog);
+    LatticeComplexD density(&Grid);
+    density = localInnerProduct(fields[2],fields[2]);
+    std::vector<TComplexD> dn;
+    sliceSum(density,dn,orthog);
+    for(int t=0;t<sn.size();t++) assert(std::fabs(sn[t]-real(TensorRemove(dn[t]))) < 1.0e-10*std::fabs(sn[t]));
+  }
+
+  std::cout << GridLogMessage << "Slice reduction checks passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,214 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_su3_exp_kernels.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef PeriodicGimplD          Gimpl;
+typedef Gimpl::GaugeLinkField   GaugeMat;
+typedef Gimpl::GaugeField       GaugeLorentz;
+
+template<class Field>
+void Check(const Field &a,const Field &b,const std::string &name,RealD tol)
+{
+  Field diff = a-b;
+  RealD n = norm2(diff)/norm2(b);
+  std::cout << GridLogMessage << name << " relative diff " << n << std::endl;
+  assert(n < tol);
+}
+
+// The lattice form of the Cayley-Hamilton exponential the site kernels replace
+void LatticeExp(GaugeMat &e_iQ,const GaugeMat &iQ,const Smear_Stout<Gimpl> &stout)
+{
+  GridBase *grid = iQ.Grid();
+  GaugeMat unity(grid), iQ2(grid), iQ3(grid);
+  LatticeComplexD u(grid), w(grid), f0(grid), f1(grid), f2(grid);
+  unity = 1.0;
+  iQ2 = iQ * iQ;
+  iQ3 = iQ * iQ2;
+  stout.set_uw(u, w, iQ2, iQ3);
+  stout.set_fj(f0, f1, f2, u, w);
+  e_iQ = f0 * unity + timesMinusI(f1) * iQ - f2 * iQ2;
+}
+
+int main(int argc, char ** argv)
+{
+  Grid_init(&argc, &argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+  GridParallelRNG   RNG(&Grid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  GaugeLorentz U(&Grid);
+  SU<Nc>::HotConfiguration(RNG,U);
+  GaugeMat unit(&Grid);
+  unit = 1.0;
+
+  ////////////////////////////////////////////////////////////
+  // Exponential: site kernel against the lattice form and
+  // against the Taylor series
+  ////////////////////////////////////////////////////////////
+  Smear_Stout<Gimpl> stout(0.1);
+  {
+    GaugeMat iQ(&Grid), e_site(&Grid), e_ref(&Grid), e_taylor(&Grid), uu(&Grid);
+    SU<Nc>::GaussianFundamentalLieAlgebraMatrix(RNG, iQ);
+    stout.exponentiate_iQ(e_site, iQ);
+    LatticeExp(e_ref, iQ, stout);
+    Check(e_site,e_ref,"Site exponential",1.0e-28);
+
+    GaugeMat x(&Grid);
+    x = iQ;
+    e_taylor = unit;
+    RealD nfac = 1.0;
+    for(int i=1;i<=24;i++){
+      nfac = nfac/RealD(i);
+      e_taylor = e_taylor + x*nfac;
+      x = x*iQ;
+    }
+    Check(e_site,e_taylor,"Site exponential vs Taylor",1.0e-24);
+    uu = e_site*adj(e_site);
+    Check(uu,unit,"Site exponential unitarity",1.0e-26);
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Two row SU(3) reunitarisation: fixes SU(3), matches
+  // Gram-Schmidt to the size of the drift, det=1
+  ////////////////////////////////////////////////////////////
+  {
+    GaugeMat Umu(&Grid), noise(&Grid), pr(&Grid), gs(&Grid), uu(&Grid);
+    Umu = PeekIndex<LorentzIndex>(U,0);
+    pr = ProjectSU3(Umu);
+    Check(pr,Umu,"ProjectSU3 on SU(3)",1.0e-26);
+
+    gaussian(RNG,noise);
+    Umu = Umu + 1.0e-6*noise;
+    pr = ProjectSU3(Umu);
+    gs = ProjectOnGroup(Umu);
+    Check(pr,gs,"ProjectSU3 vs ProjectOnGroup",1.0e-10);
+    uu = pr*adj(pr);
+    Check(uu,unit,"ProjectSU3 unitarity",1.0e-28);
+
+    LatticeComplexD det(&Grid), one(&Grid);
+    one = 1.0;
+    {
+      autoView(pr_v,pr,CpuRead);
+      autoView(det_v,det,CpuWrite);
+      thread_for(ss,Grid.oSites(),{
+	auto &m = pr_v[ss]()();
+	det_v[ss]()()() = m(0,0)*(m(1,1)*m(2,2)-m(1,2)*m(2,1))
+	                - m(0,1)*(m(1,0)*m(2,2)-m(1,2)*m(2,0))
+	                + m(0,2)*(m(1,0)*m(2,1)-m(1,1)*m(2,0));
+      });
+    }
+    Check(det,one,"ProjectSU3 determinant",1.0e-28);
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Fused flow update against the separate lattice operations
+  ////////////////////////////////////////////////////////////
+  {
+    GaugeLorentz P(&Grid), F(&Grid), Pref(&Grid), Uf(&Grid), Uref(&Grid);
+    Gimpl::generate_momenta(P,RNG);
+    Gimpl::generate_momenta(F,RNG);
+    Pref = -17.0/9.0*P + 8.0/9.0*F;
+    Uref = U;
+    Gimpl::update_field(Pref,Uref,0.02);
+    Uf = U;
+    Gimpl::update_field(P,F,-17.0/9.0,8.0/9.0,Uf,0.02);
+    Check(P,Pref,"Fused flow update Z",1.0e-28);
+    Check(Uf,Uref,"Fused flow update U",1.0e-28);
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Single pass stout smearing against the per direction
+  // lattice form, including an unsmeared direction
+  ////////////////////////////////////////////////////////////
+  for(int orthog=-1;orthog<Nd;orthog+=Nd){
+    Smear_Stout<Gimpl> st(0.1,orthog);
+    GaugeLorentz Us(&Grid), Uref(&Grid), C(&Grid);
+    st.smear(Us,U);
+    st.BaseSmear(C,U);
+    for(int mu=0;mu<Nd;mu++){
+      GaugeMat Umu(&Grid), iQ(&Grid), e_iQ(&Grid);
+      Umu = PeekIndex<LorentzIndex>(U,mu);
+      if ( mu==orthog ) {
+	e_iQ = 1.0;
+      } else {
+	iQ = Ta(PeekIndex<LorentzIndex>(C,mu)*adj(Umu));
+	LatticeExp(e_iQ,iQ,st);
+      }
+      PokeIndex<LorentzIndex>(Uref,e_iQ*Umu,mu);
+    }
+    Check(Us,Uref,"Stout smear orthog="+std::to_string(orthog),1.0e-28);
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Smeared force through two stout levels against the change
+  // of the action on the smeared links, central difference
+  ////////////////////////////////////////////////////////////
+  {
+    RealD beta = 6.0;
+    RealD dt = 1.0e-4;
+    WilsonGaugeAction<Gimpl> Waction(beta);
+    SmearedConfiguration<Gimpl> Smeared(&Grid, 2, stout);
+
+    Smeared.set_Field(U);
+    GaugeLorentz force(&Grid), mom(&Grid), Uprime(&Grid);
+    Waction.deriv(Smeared.get_SmearedU(), force);
+    Smeared.smeared_force(force);
+    force = Gimpl::projectForce(force);
+
+    Gimpl::generate_momenta(mom,RNG);
+    Uprime = U;
+    Gimpl::update_field(mom,Uprime,dt);
+    Smeared.set_Field(Uprime);
+    RealD Splus = Waction.S(Smeared.get_SmearedU());
+    Uprime = U;
+    Gimpl::update_field(mom,Uprime,-dt);
+    Smeared.set_Field(Uprime);
+    RealD Sminus = Waction.S(Smeared.get_SmearedU());
+
+    LatticeComplexD dS(&Grid);
+    dS = Zero();
+    for(int mu=0;mu<Nd;mu++){
+      GaugeMat pmu = PeekIndex<LorentzIndex>(mom,mu);
+      GaugeMat fmu = PeekIndex<LorentzIndex>(force,mu);
+      dS = dS - trace(pmu*fmu)*dt*2.0;
+    }
+    RealD dSpred = real(TensorRemove(sum(dS)));
+    RealD dSmeas = 0.5*(Splus-Sminus);
+    std::cout << GridLogMessage << std::setprecision(15) << "dS " << dSmeas << " pred dS " << dSpred << std::endl;
+    assert( fabs(dSmeas-dSpred) < 1.0e-3*fabs(dSpred) );
+  }
+
+  std::cout << GridLogMessage << "All SU(3) exponential kernel tests passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,189 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_tiled_order.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+// Every outer site once; each tile a contiguous run of the order
+void CheckOrder(GridBase *grid)
+{
+  const int32_t *order = grid->TiledOrder();
+  assert(order != nullptr);
+  int nd = grid->Nd();
+  Coordinate tile = grid->Tiling();
+  Coordinate ocoor(nd), first(nd);
+
+  std::vector<int> seen(grid->oSites(),0);
+  for(int i=0;i<grid->oSites();i++) seen[order[i]]++;
+  for(auto s : seen) assert(s==1);
+
+  int tilevol=1;
+  for(int d=0;d<nd;d++) tilevol*=tile[d];
+
+  // The first tile is the corner box, then the next tile along dimension 0
+  for(int i=0;i<tilevol;i++){
+    grid->oCoorFromOindex(ocoor,order[i]);
+    for(int d=0;d<nd;d++) assert(ocoor[d]<tile[d]);
+  }
+  if ( grid->_rdimensions[0] >= 2*tile[0] ) {
+    grid->oCoorFromOindex(first,order[tilevol]);
+    assert(first[0]==tile[0]);
+    for(int d=1;d<nd;d++) assert(first[d]==0);
+  }
+
+  // accelerator_for_tiled visits each site once
+  std::vector<int> count(grid->oSites(),0);
+  int *count_p = &count[0];
+  accelerator_for_tiled(ss,grid,1,{
+    count_p[ss]++;
+  });
+  for(auto c : count) assert(c==1);
+  std::cout << GridLogMessage << "Tiled order " << grid->_rdimensions << " tiles " << tile << " ok" << std::endl;
+}
+
+// Same local sites on another grid of the same shape
+template<class vobj>
+void CopyAcross(Lattice<vobj> &out,const Lattice<vobj> &in)
+{
+  std::vector<typename vobj::scalar_object> buf;
+  unvectorizeToLexOrdArray(buf,in);
+  vectorizeFromLexOrdArray(buf,out);
+}
+
+// Halo clover field strengths in the grid's tiled order against the untiled order
+template<class Gimpl>
+void CheckFieldStrengths(GridCartesian *grid,const typename Gimpl::GaugeField &U,const Coordinate &tile)
+{
+  typedef typename Gimpl::GaugeLinkField GaugeMat;
+  std::vector<GaugeMat> untiled, tiled;
+
+  grid->ClearTiling();
+  WilsonLoopsHalo<Gimpl>::FieldStrengths(untiled,U);
+
+  grid->SetTiling(tile);
+  WilsonLoopsHalo<Gimpl>::FieldStrengths(tiled,U);
+
+  RealD n=0.0;
+  for(int i=0;i<Nd*Nd;i++){
+    GaugeMat diff = tiled[i]-untiled[i];
+    n += norm2(diff);
+  }
+  std::cout << GridLogMessage << "Tiled field strength diff " << n << std::endl;
+  assert(n==0.0);
+}
+
+int main(int argc, char ** argv)
+{
+  Grid_init(&argc, &argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian         Grid(latt_size,simd_layout,mpi_layout);
+  GridRedBlackCartesian RBGrid(&Grid);
+  GridParallelRNG       RNG(&Grid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  std::vector<Coordinate> tiles({ Coordinate({2,2,2,2}), Coordinate({4,2,1,2}), Coordinate({3,3,3,3}), Coordinate({0,2,0,1}) });
+
+  LatticeGaugeFieldD Umu(&Grid);
+  SU<Nc>::HotConfiguration(RNG,Umu);
+
+  for(auto &tile : tiles){
+    Grid.SetTiling(tile);
+    CheckOrder(&Grid);
+    RBGrid.SetTiling(tile);
+    CheckOrder(&RBGrid);
+
+    CheckFieldStrengths<PeriodicGimplD>(&Grid,Umu,tile);
+  }
+  Grid.ClearTiling();
+  RBGrid.ClearTiling();
+  assert(Grid.TiledOrder()==nullptr);
+
+  ////////////////////////////////////////////////////////////
+  // Grids made under a default tiling, including the padded
+  // grids of the halo Wilson loops
+  ////////////////////////////////////////////////////////////
+  {
+    typedef PeriodicGimplD Gimpl;
+    LatticeGaugeFieldD U(&Grid);
+    SU<Nc>::HotConfiguration(RNG,U);
+    std::vector<LatticeColourMatrixD> ref, tiled;
+    WilsonLoopsHalo<Gimpl>::Staples(ref,U);
+
+    GridBase::DefaultTiling() = Coordinate({2,2,2,2});
+    GridCartesian TGrid(latt_size,simd_layout,mpi_layout);
+    CheckOrder(&TGrid);
+
+    LatticeGaugeFieldD TU(&TGrid);
+    CopyAcross(TU,U);
+    WilsonLoopsHalo<Gimpl>::Staples(tiled,TU);
+    for(int mu=0;mu<Nd;mu++){
+      LatticeColourMatrixD back(&Grid);
+      CopyAcross(back,tiled[mu]);
+      LatticeColourMatrixD diff = back-ref[mu];
+      RealD n = norm2(diff);
+      std::cout << GridLogMessage << "Tiled staple mu=" << mu << " diff " << n << std::endl;
+      assert(n==0.0);
+    }
+    GridBase::DefaultTiling().resize(0);
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Clover term built from the tiled halo field strengths
+  ////////////////////////////////////////////////////////////
+  {
+    typedef WilsonCloverFermionD::FermionField FermionField;
+    RealD mass=0.1, csw_r=1.0, csw_t=1.0;
+    WilsonCloverFermionD Dref (Umu,Grid,RBGrid,mass,csw_r,csw_t);
+    WilsonCloverFermionD Dhalo(Umu,Grid,RBGrid,mass,csw_r,csw_t);
+    Grid.SetTiling(Coordinate({2,2,2,2}));
+    Dhalo.UseHaloExchange();
+    Dhalo.ImportGauge(Umu);
+    Grid.ClearTiling();
+
+    FermionField src(&Grid), ref(&Grid), res(&Grid), diff(&Grid);
+    gaussian(RNG,src);
+    Dref .Mooee(src,ref);
+    Dhalo.Mooee(src,res);
+    diff = res-ref;
+    RealD n = norm2(diff)/norm2(ref);
+    std::cout << GridLogMessage << "Tiled halo clover term relative diff " << n << std::endl;
+    assert(n<1.0e-28);
+    Dref .MooeeInv(src,ref);
+    Dhalo.MooeeInv(src,res);
+    diff = res-ref;
+    n = norm2(diff)/norm2(ref);
+    std::cout << GridLogMessage << "Tiled halo clover inverse relative diff " << n << std::endl;
+    assert(n<1.0e-28);
+  }
+
+  std::cout << GridLogMessage << "All tiled order tests passed" << std::endl;
+  Grid_finalize();
+}
@@ -0,0 +1,176 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/core/Test_wilson_loops_halo.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef PeriodicGimplD          Gimpl;
+typedef WilsonLoops<Gimpl>      WL;
+typedef WilsonLoopsHalo<Gimpl>  WLH;
+typedef Gimpl::GaugeLinkField   GaugeMat;
+typedef Gimpl::GaugeField       GaugeLorentz;
+typedef Gimpl::ComplexField     ComplexField;
+
+template<class Field>
+void Check(const Field &a,const Field &b,const std::string &name)
+{
+  Field diff = a-b;
+  RealD n = norm2(diff)/norm2(b);
+  std::cout << GridLogMessage << name << " relative diff " << n << std::endl;
+  assert(n < 1.0e-24);
+}
+
+int main(int argc, char ** argv)
+{
+  Grid_init(&argc, &argv);
+
+  Coordinate latt_size   = GridDefaultLatt();
+  Coordinate simd_layout = GridDefaultSimd(Nd,vComplexD::Nsimd());
+  Coordinate mpi_layout  = GridDefaultMpi();
+
+  GridCartesian     Grid(latt_size,simd_layout,mpi_layout);
+  GridParallelRNG   RNG(&Grid);
+  RNG.SeedFixedIntegers(std::vector<int>({45,12,81,9}));
+
+  GaugeLorentz Umu(&Grid);
+  SU<Nc>::HotConfiguration(RNG,Umu);
+  assert(WLH::Supported(&Grid));
+
+  std::vector<GaugeMat> U(Nd,&Grid);
+  for(int mu=0;mu<Nd;mu++) U[mu] = PeekIndex<LorentzIndex>(Umu,mu);
+
+  ////////////////////////////////////////////////////////////
+  // Staples against the Cshift forms
+  ////////////////////////////////////////////////////////////
+  std::vector<GaugeMat> staple, rect;
+  WLH::StaplesAndRectStaples(staple,rect,Umu);
+  for(int mu=0;mu<Nd;mu++){
+    GaugeMat ref(&Grid), tmp(&Grid);
+    ref = Zero();
+    for(int nu=0;nu<Nd;nu++){
+      if ( nu==mu ) continue;
+      WL::Staple(tmp,Umu,mu,nu);
+      ref = ref + tmp;
+    }
+    Check(staple[mu],ref,"Staple mu="+std::to_string(mu));
+
+    WLH::Staple(tmp,Umu,mu);
+    Check(tmp,ref,"Single staple mu="+std::to_string(mu));
+
+    WL::RectStapleUnoptimised(ref,Umu,mu);
+    Check(rect[mu],ref,"RectStaple mu="+std::to_string(mu));
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Site plaquette and rectangle
+  ////////////////////////////////////////////////////////////
+  {
+    ComplexField halo(&Grid), ref(&Grid);
+    WLH::sitePlaquette(halo,Umu);
+    WL::sitePlaquette(ref,U);
+    Check(halo,ref,"sitePlaquette");
+    WLH::siteRectangle(halo,Umu);
+    WL::siteRectangle(ref,U);
+    Check(halo,ref,"siteRectangle");
+    std::cout << GridLogMessage << "avgPlaquette " << WL::avgPlaquette(Umu)
+	      << " avgRectangle " << WL::avgRectangle(Umu) << std::endl;
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Clover field strength
+  ////////////////////////////////////////////////////////////
+  {
+    std::vector<GaugeMat> FS;
+    WLH::FieldStrengths(FS,Umu);
+    for(int mu=0;mu<Nd;mu++){
+      for(int nu=0;nu<Nd;nu++){
+	if ( mu==nu ) continue;
+	GaugeMat Vup(&Grid), Vdn(&Grid), ref(&Grid);
+	WL::StapleUpper(Vup,Umu,mu,nu);
+	WL::StapleLower(Vdn,Umu,mu,nu);
+	GaugeMat v  = Vup - Vdn;
+	GaugeMat vu = v*U[mu];
+	ref = U[mu]*v + Cshift(vu,mu,-1);
+	ref = 0.125*(ref - adj(ref));
+	Check(FS[mu*Nd+nu],ref,"FieldStrength "+std::to_string(mu)+std::to_string(nu));
+      }
+    }
+  }
+
+  ////////////////////////////////////////////////////////////
+  // Gauge forces against the Cshift staples
+  ////////////////////////////////////////////////////////////
+  {
+    RealD beta = 6.0;
+    GaugeLorentz dSdU(&Grid), ref(&Grid);
+    WilsonGaugeAction<Gimpl> Waction(beta);
+    Waction.UseHaloExchange();
+    Waction.deriv(Umu,dSdU);
+    for(int mu=0;mu<Nd;mu++){
+      GaugeMat st(&Grid), tmp(&Grid);
+      st = Zero();
+      for(int nu=0;nu<Nd;nu++){
+	if ( nu==mu ) continue;
+	WL::Staple(tmp,Umu,mu,nu);
+	st = st + tmp;
+      }
+      tmp = Ta(U[mu]*st)*(0.5*beta/RealD(Nc));
+      PokeIndex<LorentzIndex>(ref,tmp,mu);
+    }
+    Check(dSdU,ref,"WilsonGaugeAction force");
+    Waction.UseHaloExchange(false);
+    Waction.deriv(Umu,dSdU);
+    Check(dSdU,ref,"WilsonGaugeAction Cshift force");
+
+    RealD c_plaq = 3.0, c_rect = -0.3;
+    PlaqPlusRectangleAction<Gimpl> Raction(c_plaq,c_rect);
+    Raction.UseHaloExchange();
+    Raction.deriv(Umu,dSdU);
+    for(int mu=0;mu<Nd;mu++){
+      GaugeMat st(&Grid), tmp(&Grid), rst(&Grid);
+      st = Zero();
+      for(int nu=0;nu<Nd;nu++){
+	if ( nu==mu ) continue;
+	WL::Staple(tmp,Umu,mu,nu);
+	st = st + tmp;
+      }
+      WL::RectStapleUnoptimised(rst,Umu,mu);
+      tmp = Ta(U[mu]*st)*(c_plaq/RealD(Nc)*0.5) + Ta(U[mu]*rst)*(c_rect/RealD(Nc)*0.5);
+      PokeIndex<LorentzIndex>(ref,tmp,mu);
+    }
+    Check(dSdU,ref,"PlaqPlusRectangleAction force");
+    Raction.UseHaloExchange(false);
+    Raction.deriv(Umu,dSdU);
+    Check(dSdU,ref,"PlaqPlusRectangleAction Cshift force");
+  }
+
+  // Charge conjugate boundaries keep the Cshift forms
+  assert(!GaugeLinkPaths<ConjugateGimplD>::Supported(&Grid,1));
+
+  std::cout << GridLogMessage << "All halo Wilson loop tests passed" << std::endl;
+  Grid_finalize();
+}
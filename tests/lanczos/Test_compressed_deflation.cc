@@ -0,0 +1,128 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid
+
+    Source file: ./tests/lanczos/Test_compressed_deflation.cc
+
+    Copyright (C) 2015
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int nbasis = 8;
+  const int Nvec   = 16;
+
+  Coordinate latt  = GridDefaultLatt();
+  Coordinate block({2,2,2,2});
+  Coordinate clatt = latt;
+  for(int d=0;d<Nd;d++) clatt[d] = latt[d]/block[d];
+
+  GridCartesian *UGrid   = SpaceTimeGrid::makeFourDimGrid(latt, GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridCartesian *UGridF  = SpaceTimeGrid::makeFourDimGrid(latt, GridDefaultSimd(Nd,vComplexF::Nsimd()),GridDefaultMpi());
+  GridCartesian *CGrid   = SpaceTimeGrid::makeFourDimGrid(clatt,GridDefaultSimd(Nd,vComplexF::Nsimd()),GridDefaultMpi());
+  GridCartesian *CGridD  = SpaceTimeGrid::makeFourDimGrid(clatt,GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+
+  GridParallelRNG RNG(UGrid);  RNG.SeedFixedIntegers(std::vector<int>({1,2,3,4}));
+
+  ////////////////////////////////////////////
+  // Synthetic orthonormal "eigen" system with local coherence:
+  // beyond the first nbasis vectors each one is a block varying
+  // combination of those plus a small incoherent part, so block
+  // compression is good but not exact
+  ////////////////////////////////////////////
+  typedef Lattice<iVector<vTComplexD,nbasis> > CoarseVectorD;
+  GridParallelRNG CRNG(CGridD); CRNG.SeedFixedIntegers(std::vector<int>({5,6,7,8}));
+  std::vector<LatticeFermionD> evec(Nvec,UGrid);
+  std::vector<RealD>           eval(Nvec);
+  CoarseVectorD   coef(CGridD);
+  LatticeFermionD noise(UGrid);
+  for(int i=0;i<Nvec;i++){
+    if ( i<nbasis ) {
+      gaussian(RNG,evec[i]);
+    } else {
+      std::vector<LatticeFermionD> basis(evec.begin(),evec.begin()+nbasis);
+      gaussian(CRNG,coef);
+      blockPromote(coef,evec[i],basis);
+      gaussian(RNG,noise);
+      evec[i] = evec[i] + noise*(0.1*std::sqrt(norm2(evec[i])/norm2(noise)));
+    }
+    basisOrthogonalize(evec,evec[i],i);
+    evec[i] = evec[i] * (1.0/std::sqrt(norm2(evec[i])));
+    eval[i] = 0.01*(i+1);
+  }
+
+  LatticeFermionD src(UGrid); gaussian(RNG,src);
+  LatticeFermionD ref(UGrid);
+  LatticeFermionD guess(UGrid);
+  LatticeFermionD diff(UGrid);
+
+  ////////////////////////////////////////////
+  // Reference: one vector at a time
+  ////////////////////////////////////////////
+  ref = Zero();
+  for(int i=0;i<Nvec;i++){
+    axpy(ref,TensorRemove(innerProduct(evec[i],src)) / eval[i],evec[i],ref);
+  }
+  RealD nref = norm2(ref);
+
+  DeflatedGuesser<LatticeFermionD> Full(evec,eval);
+  Full(src,guess);
+  diff = guess - ref;
+  std::cout << GridLogMessage << " DeflatedGuesser                rel. err "<< norm2(diff)/nref <<std::endl;
+  assert(norm2(diff)/nref < 1.0e-20);
+
+  MixedPrecisionDeflatedGuesser<LatticeFermionD,LatticeFermionF> Mixed(UGridF,evec,eval);
+  Mixed(src,guess);
+  diff = guess - ref;
+  std::cout << GridLogMessage << " MixedPrecisionDeflatedGuesser  rel. err "<< norm2(diff)/nref <<std::endl;
+  assert(norm2(diff)/nref < 1.0e-10);
+
+  ////////////////////////////////////////////
+  // The basis vectors themselves compress exactly (up to single
+  // precision), the rest lose about the incoherent 1%
+  ////////////////////////////////////////////
+  BlockCompressedDeflatedGuesser<LatticeFermionD,vSpinColourVectorF,vTComplexF,nbasis> Compressed(UGridF,CGrid,evec,eval);
+  RealD maxerr = 0.0;
+  for(int i=0;i<Nvec;i++){
+    RealD err = Compressed.CompressionError(evec[i],i);
+    std::cout << GridLogMessage << " compression error evec "<<i<<" "<< err <<std::endl;
+    if ( i<nbasis ) assert(err < 1.0e-10);
+    else            maxerr = std::max(maxerr,err);
+  }
+  assert(maxerr > 1.0e-4 && maxerr < 5.0e-2);
+
+  ////////////////////////////////////////////
+  // Guess quality against the uncompressed deflated guess:
+  // lossy, but far better than a zero guess (rel. err 1)
+  ////////////////////////////////////////////
+  Compressed(src,guess);
+  diff = guess - ref;
+  RealD gerr = norm2(diff)/nref;
+  std::cout << GridLogMessage << " BlockCompressedDeflatedGuesser rel. err "<< gerr <<std::endl;
+  assert(gerr > 1.0e-8 && gerr < 5.0e-2);
+
+  Grid_finalize();
+}
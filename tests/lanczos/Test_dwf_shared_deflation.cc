@@ -0,0 +1,163 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/lanczos/Test_dwf_shared_deflation.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+typedef LatticeFermionD FermionField;
+
+// Zero guess vs. low mode guess CG iterations on MpcdagMpc
+void CompareGuess(SchurDiagMooeeOperator<DomainWallFermionD,FermionField> &HermOp,
+		  SharedDeflationSpace<WilsonImplD> &LowModes,
+		  const FermionField &src, Integer &iter_zero, Integer &iter_defl)
+{
+  ConjugateGradient<FermionField> CG(1.0e-8,10000);
+  FermionField sol(src.Grid());
+
+  sol = Zero();
+  CG(HermOp,src,sol);
+  iter_zero = CG.IterationsToComplete;
+
+  LowModes(src,sol);
+  CG(HermOp,src,sol);
+  iter_defl = CG.IterationsToComplete;
+  std::cout << GridLogMessage << "CG iterations zero guess "<<iter_zero<<" deflated guess "<<iter_defl<<std::endl;
+}
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeGaugeFieldD U(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,U);
+
+  RealD mass=0.01;
+  RealD M5=1.8;
+  DomainWallFermionD Ddwf(U,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  SchurDiagMooeeOperator<DomainWallFermionD,FermionField> HermOp(Ddwf);
+
+  FermionField src(FGrid), src_o(FrbGrid);
+  random(RNG5,src);
+  pickCheckerboard(Odd,src_o,src);
+
+  PowerMethod<FermionField> Power;
+  RealD lambda_max = Power(HermOp,src_o);
+
+  SharedDeflationSpaceParameters Params;
+  Params.Cheby.alpha = 0.5;
+  Params.Cheby.beta  = 1.1*lambda_max;
+  Params.Cheby.Npoly = 21;
+  Params.Nstop   = 8;
+  Params.Nk      = 16;
+  Params.Nm      = 24;
+  Params.resid   = 1.0e-6;
+  Params.MaxIt   = 1000;
+  Params.betastp = 0.0;
+  Params.MinRes  = 0;
+  Params.RebuildResid = 1.0e-2;
+
+  SharedDeflationSpace<WilsonImplD> LowModes(Ddwf,Params);
+  LowModes.Refresh(U);
+  assert(LowModes.Built());
+  int Nconv = LowModes.evec.size();
+
+  Integer iter_zero, iter_defl;
+  CompareGuess(HermOp,LowModes,src_o,iter_zero,iter_defl);
+  assert(iter_defl < iter_zero);
+
+  // Second action refreshing on the same field must not redo the eigensolve
+  std::vector<RealD> eval_save(LowModes.eval);
+  LowModes.Refresh(U);
+  for(int i=0;i<Nconv;i++) assert(LowModes.eval[i]==eval_save[i]);
+
+  // The start vector comes from the space's own fixed seeds, not the HMC RNG,
+  // so an independent build on the same field reproduces the modes exactly
+  {
+    SharedDeflationSpace<WilsonImplD> Again(Ddwf,Params);
+    Again.Refresh(U);
+    assert(Again.evec.size()==Nconv);
+    for(int i=0;i<Nconv;i++) assert(Again.eval[i]==eval_save[i]);
+  }
+
+  // Actions sharing the space must invert the same operator; a distinct but
+  // identical operator object is accepted
+  {
+    DomainWallFermionD Dsame (U,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+    DomainWallFermionD Dheavy(U,*FGrid,*FrbGrid,*UGrid,*UrbGrid,0.1,M5);
+    assert( LowModes.SameOperator(Ddwf));
+    assert( LowModes.SameOperator(Dsame));
+    assert(!LowModes.SameOperator(Dheavy));
+  }
+
+  ////////////////////////////////////
+  // One HMC-sized step: the rotated space
+  // no longer resolves the low modes and
+  // the Lanczos is rerun
+  ////////////////////////////////////
+  RealD dt = 0.01;
+  LatticeColourMatrixD mommu(UGrid), Umu(UGrid);
+  for(int mu=0;mu<Nd;mu++){
+    SU<Nc>::GaussianFundamentalLieAlgebraMatrix(RNG4, mommu);
+    Umu = PeekIndex<LorentzIndex>(U,mu);
+    Umu = expMat(mommu,dt,12)*Umu;
+    PokeIndex<LorentzIndex>(U,Umu,mu);
+  }
+
+  LowModes.Update(U);
+  assert(LowModes.Rebuilds()==1);
+  Nconv = LowModes.evec.size();
+  Ddwf.ImportGauge(U);
+  FermionField tmp(FrbGrid);
+  for(int i=0;i<Nconv;i++){
+    for(int j=0;j<Nconv;j++){
+      ComplexD ip = innerProduct(LowModes.evec[i],LowModes.evec[j]);
+      assert(std::abs(ip - ComplexD(i==j ? 1.0 : 0.0)) < 1.0e-8);
+    }
+    HermOp.HermOp(LowModes.evec[i],tmp);
+    RealD rq = real(innerProduct(LowModes.evec[i],tmp));
+    std::cout << GridLogMessage << "Ritz value "<<i<<" "<<LowModes.eval[i]<<" Rayleigh quotient "<<rq<<std::endl;
+    assert(std::abs(rq-LowModes.eval[i]) < 1.0e-8*std::abs(rq));
+  }
+  CompareGuess(HermOp,LowModes,src_o,iter_zero,iter_defl);
+  assert(iter_defl < iter_zero);
+
+  Grid_finalize();
+}
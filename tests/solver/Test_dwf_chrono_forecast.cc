@@ -0,0 +1,96 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_dwf_chrono_forecast.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeGaugeFieldD Umu(UGrid);
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+
+  RealD mass=0.1;
+  RealD M5=1.8;
+  DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  SchurDiagMooeeOperator<DomainWallFermionD,LatticeFermionD> HermOpEO(Ddwf);
+
+  LatticeFermionD src(FGrid), eta(FGrid);
+  LatticeFermionD src_o(FrbGrid), eta_o(FrbGrid), src_k(FrbGrid);
+  random(RNG5,src); pickCheckerboard(Odd,src_o,src);
+  random(RNG5,eta); pickCheckerboard(Odd,eta_o,eta);
+
+  LatticeFermionD guess(FrbGrid), sol(FrbGrid), sol_zero(FrbGrid);
+
+  ////////////////////////////////////////////////////////////////////
+  // A source drifting linearly along a "trajectory"; after two solves
+  // the exact solution lies in the span of the history.
+  ////////////////////////////////////////////////////////////////////
+  const int depth=3;
+  ChronoForecast<DomainWallFermionD,LatticeFermionD> Forecast(depth);
+  ConjugateGradient<LatticeFermionD> CG(1.0e-8,10000);
+
+  for(int k=0;k<5;k++){
+    src_k = src_o + (0.05*k)*eta_o;
+
+    sol_zero = Zero();
+    CG(HermOpEO,src_k,sol_zero);
+    Integer iter_zero = CG.IterationsToComplete;
+
+    Forecast(HermOpEO,src_k,guess);
+    sol = guess;
+    CG(HermOpEO,src_k,sol);
+    Integer iter_forecast = CG.IterationsToComplete;
+    Forecast.Update(sol);
+
+    std::cout << GridLogMessage << "step "<<k<<" history "<<Forecast.history.size()
+	      <<" CG iterations zero guess "<<iter_zero<<" forecast guess "<<iter_forecast<<std::endl;
+    if ( k>=2 ) assert(iter_forecast < iter_zero/2);
+  }
+
+  Forecast.Reset();
+  assert(Forecast.history.size()==0);
+  Forecast(HermOpEO,src_o,guess);
+  assert(norm2(guess)==0.0);
+
+  Grid_finalize();
+}
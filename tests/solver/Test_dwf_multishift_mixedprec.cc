@@ -0,0 +1,107 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_dwf_multishift_mixedprec.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  Grid_init(&argc,&argv);
+
+  const int Ls=8;
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexD::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid);
+
+  GridCartesian         * UGrid_f   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplexF::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid_f = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid_f);
+  GridCartesian         * FGrid_f   = SpaceTimeGrid::makeFiveDimGrid(Ls,UGrid_f);
+  GridRedBlackCartesian * FrbGrid_f = SpaceTimeGrid::makeFiveDimRedBlackGrid(Ls,UGrid_f);
+
+  std::vector<int> seeds4({1,2,3,4});
+  std::vector<int> seeds5({5,6,7,8});
+  GridParallelRNG          RNG5(FGrid);  RNG5.SeedFixedIntegers(seeds5);
+  GridParallelRNG          RNG4(UGrid);  RNG4.SeedFixedIntegers(seeds4);
+
+  LatticeFermionD    src(FGrid); random(RNG5,src);
+  LatticeGaugeFieldD Umu(UGrid);
+  LatticeGaugeFieldF Umu_f(UGrid_f); 
+  SU<Nc>::HotConfiguration(RNG4,Umu);
+  precisionChange(Umu_f,Umu);
+
+  RealD mass=0.1;
+  RealD M5=1.8;
+  DomainWallFermionD Ddwf(Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,M5);
+  DomainWallFermionF Ddwf_f(Umu_f,*FGrid_f,*FrbGrid_f,*UGrid_f,*UrbGrid_f,mass,M5);
+
+  LatticeFermionD src_o(FrbGrid);
+  pickCheckerboard(Odd,src_o,src);
+
+  SchurDiagMooeeOperator<DomainWallFermionD,LatticeFermionD> HermOpEO(Ddwf);
+  SchurDiagMooeeOperator<DomainWallFermionF,LatticeFermionF> HermOpEO_f(Ddwf_f);
+
+  ////////////////////////////////////////
+  // Inverse square root
+  ////////////////////////////////////////
+  double     lo=0.01;
+  double     hi=64.0;
+  int precision=64;
+  int    degree=8;
+  AlgRemez remez(lo,hi,precision);
+  remez.generateApprox(degree,1,2);
+  MultiShiftFunction InvSqrt(remez,1.0e-8,true);
+
+  std::vector<LatticeFermionD> result  (degree,FrbGrid);
+  std::vector<LatticeFermionD> result_d(degree,FrbGrid);
+
+  std::cout << GridLogMessage << "::::::::::::: Starting mixed precision multishift CG" << std::endl;
+  ConjugateGradientMultiShiftMixedPrec<LatticeFermionD,LatticeFermionF> mMSCG(10000,InvSqrt,FrbGrid_f,HermOpEO_f,0.1);
+  mMSCG(HermOpEO,src_o,result);
+  std::cout << GridLogMessage << "reliable updates "<<mMSCG.ReliableUpdatesPerformed<<std::endl;
+  assert(mMSCG.ReliableUpdatesPerformed > 0);
+
+  std::cout << GridLogMessage << "::::::::::::: Starting double precision multishift CG" << std::endl;
+  ConjugateGradientMultiShift<LatticeFermionD> MSCG(10000,InvSqrt);
+  MSCG(HermOpEO,src_o,result_d);
+
+  LatticeFermionD diff_o(FrbGrid);
+  for(int s=0;s<degree;s++){
+    RealD diff = axpy_norm(diff_o, -1.0, result[s], result_d[s]);
+    RealD nrm  = norm2(result_d[s]);
+    std::cout << GridLogMessage << "shift "<<s<<" true residual "<<mMSCG.TrueResidualShift[s]
+	      <<" relative diff between mixed and regular "<< std::sqrt(diff/nrm)
+	      <<" clean up iterations "<<mMSCG.IterationsToCleanupShift[s] << std::endl;
+    assert(mMSCG.TrueResidualShift[s] <= 1.0e-8);
+    assert(std::sqrt(diff/nrm) < 1.0e-6);
+  }
+
+  Grid_finalize();
+}
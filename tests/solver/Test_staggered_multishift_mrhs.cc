@@ -0,0 +1,114 @@
+    /*************************************************************************************
+
+    Grid physics library, www.github.com/paboyle/Grid 
+
+    Source file: ./tests/solver/Test_staggered_multishift_mrhs.cc
+
+    Copyright (C) 2015
+
+Author: Peter Boyle <paboyle@ph.ed.ac.uk>
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License along
+    with this program; if not, write to the Free Software Foundation, Inc.,
+    51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+    See the full license in the file "LICENSE" in the top level distribution directory
+    *************************************************************************************/
+    /*  END LEGAL */
+#include <Grid/Grid.h>
+
+using namespace std;
+using namespace Grid;
+
+int main (int argc, char ** argv)
+{
+  typedef typename ImprovedStaggeredFermion5DR::FermionField FermionField; 
+
+  const int Nsrc=4;
+
+  Grid_init(&argc,&argv);
+
+  GridCartesian         * UGrid   = SpaceTimeGrid::makeFourDimGrid(GridDefaultLatt(), GridDefaultSimd(Nd,vComplex::Nsimd()),GridDefaultMpi());
+  GridRedBlackCartesian * UrbGrid = SpaceTimeGrid::makeFourDimRedBlackGrid(UGrid);
+  GridCartesian         * FGrid   = SpaceTimeGrid::makeFiveDimGrid(Nsrc,UGrid);
+  GridRedBlackCartesian * FrbGrid = SpaceTimeGrid::makeFiveDimRedBlackGrid(Nsrc,UGrid);
+
+  std::vector<int> seeds({1,2,3,4});
+  GridParallelRNG pRNG(UGrid );  pRNG.SeedFixedIntegers(seeds);
+  GridParallelRNG pRNG5(FGrid);  pRNG5.SeedFixedIntegers(seeds);
+
+  LatticeGaugeField Umu(UGrid); SU<Nc>::HotConfiguration(pRNG,Umu);
+
+  ////////////////////////////////////////
+  // Inverse square root
+  ////////////////////////////////////////
+  double     lo=0.01;
+  double     hi=20.0;
+  int precision=64;
+  int    degree=8;
+  AlgRemez remez(lo,hi,precision);
+  remez.generateApprox(degree,1,2);
+  MultiShiftFunction InvSqrt(remez,1.0e-6,true);
+
+  ////////////////////////////////////////////
+  // One 4d staggered operator per s-slice
+  ////////////////////////////////////////////
+  RealD mass=0.1;
+  RealD c1=9.0/8.0;
+  RealD c2=-1.0/24.0;
+  RealD u0=1.0;
+
+  ImprovedStaggeredFermion5DR Ds(Umu,Umu,*FGrid,*FrbGrid,*UGrid,*UrbGrid,mass,c1,c2,u0); 
+  MdagMLinearOperator<ImprovedStaggeredFermion5DR,FermionField> HermOp(Ds);
+
+  // Sources of very different size, and one trivial source
+  FermionField src(FGrid); random(pRNG5,src);
+  int blockDim = 0;
+  std::vector<RealD> scale({1.0,10.0,0.0,0.1});
+  std::vector<RealD> zero(Nsrc,0.0);
+  sliceAxpbyVector(src,scale,zero,src,src,blockDim);
+
+  std::vector<FermionField> result(degree,FGrid);
+
+  ConjugateGradientMultiShiftMultiRHS<FermionField> mMSCG(10000,InvSqrt,blockDim);
+  ConjugateGradientMultiShift<FermionField>         MSCG (10000,InvSqrt);
+
+  double t1=usecond();
+  mMSCG(HermOp,src,result);
+  double t2=usecond();
+  std::cout<<GridLogMessage << "MultiRHS multishift "<<mMSCG.IterationsToComplete<<" iterations "<< (t2-t1)<<" usec"<<std::endl;
+
+  std::vector<FermionField> single(degree,FGrid);
+  t1=usecond();
+  MSCG(HermOp,src,single);
+  t2=usecond();
+  std::cout<<GridLogMessage << "Multishift          "<<MSCG.IterationsToComplete<<" iterations "<< (t2-t1)<<" usec"<<std::endl;
+
+  // Residual of every shift checked independently on every source
+  FermionField mmp(FGrid);
+  FermionField res(FGrid);
+  std::vector<RealD> rn, sn;
+  sliceNorm(sn,src,blockDim);
+  for(int s=0;s<degree;s++){
+    HermOp.HermOp(result[s],mmp);
+    res = mmp + InvSqrt.poles[s]*result[s] - src;
+    sliceNorm(rn,res,blockDim);
+    for(int b=0;b<Nsrc;b++){
+      RealD err = (sn[b]==0.0) ? rn[b] : std::sqrt(rn[b]/sn[b]);
+      std::cout<<GridLogMessage << "shift "<<s<<" source "<<b<<" true residual "<<err<<std::endl;
+      assert(err < 1.0e-5);
+    }
+  }
+
+  Grid_finalize();
+}